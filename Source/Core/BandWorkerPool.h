@@ -0,0 +1,193 @@
+// Phase 6 — BandWorkerPool (real-time band parallelism)
+// Small fixed pool of worker threads that run independent tasks (one per band) alongside the audio thread.
+//
+// Threading:
+// - start()/stop() create and join threads; call them off the audio thread (prepareToPlay / destructor).
+//   Only an instance that actually runs multiband starts a pool.
+// - Workers are juce::Thread realtime threads sized for the host block. A worker the OS refuses realtime
+//   scheduling for is not started: fewer workers (none = serial), never a normal-priority one.
+// - run() is called from the audio thread. It never allocates and never locks. The audio thread claims
+//   tasks itself, so a late or sleeping worker only means less parallelism. It does wait for tasks a worker
+//   has already claimed (at most one task per worker) before returning: that wait is why workers must be
+//   realtime threads, since a preempted normal-priority worker would stall the audio thread.
+//
+// Dispatch:
+// - One 64-bit ticket = generation (32) | numTasks (16) | next task index (16). Tasks are claimed with a CAS
+//   on the ticket, so a worker can only claim tasks of the job it observed, and job data (fn / context)
+//   stays valid until the audio thread has seen every task complete.
+// - Idle workers spin for kSpinIterations, then block on a condition variable with no timeout (a sleeping
+//   pool costs no CPU). The audio thread notifies without taking the mutex: a wake-up lost in that window
+//   costs that block's parallelism only (the audio thread runs the tasks), and the next run() wakes the worker.
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "../Util/DenormalGuard.h"
+
+struct BandWorkerPool
+{
+    using TaskFn = void (*) (void* context, int task);
+
+    static constexpr int kMaxWorkers     = 3;
+    static constexpr int kSpinIterations = 4000;
+
+    BandWorkerPool() = default;
+    ~BandWorkerPool() { stop(); }
+
+    BandWorkerPool (const BandWorkerPool&) = delete;
+    BandWorkerPool& operator= (const BandWorkerPool&) = delete;
+
+    // Off the audio thread. numWorkers is clamped to [0, kMaxWorkers] and, unless capToSpareCores is false
+    // (tests: thread-count equivalence on small machines), to the spare hardware threads;
+    // blockSize / sampleRate give the OS the workers' real-time budget.
+    void start (int numWorkers, int blockSize, double sampleRate, bool capToSpareCores = true)
+    {
+        stop();
+
+        const int spare = juce::jmax(0, (int) std::thread::hardware_concurrency() - 1);
+        const int wanted = juce::jlimit(0, capToSpareCores ? juce::jmin(kMaxWorkers, spare) : kMaxWorkers, numWorkers);
+        const auto options = juce::Thread::RealtimeOptions{}
+                                 .withApproximateAudioProcessingTime(juce::jmax(1, blockSize), sampleRate);
+
+        quit.store(false, std::memory_order_relaxed);
+        for (int w = 0; w < wanted; ++w)
+        {
+            auto worker = std::make_unique<Worker> (*this);
+            if (!worker->startRealtimeThread(options))
+                break;
+            workers[(size_t) numThreads++] = std::move(worker);
+        }
+    }
+
+    void stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock (wakeMutex);
+            quit.store(true, std::memory_order_release);
+        }
+        wakeCv.notify_all();
+        for (int w = 0; w < numThreads; ++w)
+        {
+            workers[(size_t) w]->stopThread(-1);
+            workers[(size_t) w].reset();
+        }
+        numThreads = 0;
+    }
+
+    int getNumWorkers() const { return numThreads; }
+
+    // Audio thread. Runs fn(context, t) for t in [0, numTasks); the caller participates.
+    void run (TaskFn fn, void* context, int numTasks)
+    {
+        if (numTasks <= 0)
+            return;
+
+        if (numThreads == 0 || numTasks == 1)
+        {
+            for (int t = 0; t < numTasks; ++t)
+                fn(context, t);
+            return;
+        }
+
+        jobFn = fn;
+        jobContext = context;
+        tasksDone.store(0, std::memory_order_relaxed);
+
+        const std::uint64_t gen = (ticket.load(std::memory_order_relaxed) >> 32) + 1;
+        ticket.store((gen << 32) | ((std::uint64_t) numTasks << 16), std::memory_order_seq_cst);
+
+        // seq_cst pairs with the sleeper count: a worker not counted here re-checks the ticket before sleeping
+        if (sleepers.load(std::memory_order_seq_cst) > 0)
+            wakeCv.notify_all();
+
+        claimAndRun((std::uint32_t) gen);
+
+        // Only tasks already claimed by (realtime) workers are left
+        while (tasksDone.load(std::memory_order_acquire) < numTasks)
+            std::this_thread::yield();
+    }
+
+private:
+    struct Worker final : juce::Thread
+    {
+        explicit Worker (BandWorkerPool& p) : juce::Thread ("Compass band worker"), pool (p) {}
+        void run() override { pool.workerLoop(); }
+
+        BandWorkerPool& pool;
+    };
+
+    // Claims and runs tasks of generation gen until none are left.
+    void claimAndRun (std::uint32_t gen)
+    {
+        std::uint64_t t = ticket.load(std::memory_order_acquire);
+        for (;;)
+        {
+            if ((std::uint32_t) (t >> 32) != gen)
+                return;
+
+            const int count = (int) ((t >> 16) & 0xffff);
+            const int next  = (int) (t & 0xffff);
+            if (next >= count)
+                return;
+
+            if (ticket.compare_exchange_weak(t, t + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                jobFn(jobContext, next);
+                tasksDone.fetch_add(1, std::memory_order_release);
+                t = ticket.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    void workerLoop()
+    {
+        const DenormalGuard denormalGuard; // FTZ / DAZ is per thread: workers hold their own
+
+        std::uint32_t seen = (std::uint32_t) (ticket.load(std::memory_order_acquire) >> 32);
+        while (!quit.load(std::memory_order_acquire))
+        {
+            std::uint32_t gen = seen;
+            for (int spin = 0; spin < kSpinIterations && gen == seen; ++spin)
+                gen = (std::uint32_t) (ticket.load(std::memory_order_acquire) >> 32);
+
+            if (gen == seen)
+            {
+                std::unique_lock<std::mutex> lock (wakeMutex);
+                sleepers.fetch_add(1, std::memory_order_seq_cst);
+                wakeCv.wait(lock, [this, seen]
+                {
+                    return quit.load(std::memory_order_acquire)
+                        || (std::uint32_t) (ticket.load(std::memory_order_seq_cst) >> 32) != seen;
+                });
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            seen = gen;
+            claimAndRun(gen);
+        }
+    }
+
+    std::array<std::unique_ptr<Worker>, kMaxWorkers> workers;
+    int numThreads = 0;
+
+    std::atomic<std::uint64_t> ticket { 0 };
+    std::atomic<int> tasksDone { 0 };
+    std::atomic<int> sleepers { 0 };
+    std::atomic<bool> quit { false };
+
+    // Job data: written by the audio thread before the ticket is published (release), read after a claim (acquire)
+    TaskFn jobFn = nullptr;
+    void* jobContext = nullptr;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+};
@@ -0,0 +1,150 @@
+// Phase 6 — ChannelGroups (channel-generic control layout)
+// - kMaxChannels: largest supported bus (7.1.4 = 12, with headroom)
+// - LinkGroupMap: channel -> link group. Channels in one group share detection and GR;
+//   groups are independent (e.g. front L/R/C, LFE alone, surround pairs, height pairs).
+// - ControlLanes: structure-of-arrays control tile, one lane per channel.
+// - StereoMode: channels 0/1 as left/right or as mid/side (detection and GR).
+// No DSP. No allocation.
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+
+struct ChannelGroups
+{
+    static constexpr int kMaxChannels = 16;
+    static constexpr int kMaxGroups   = kMaxChannels;
+    static constexpr int kMaxLanes    = kMaxChannels;
+    static constexpr int kTileSize    = 64;
+};
+
+// Channels 0/1: processed as left/right, or encoded to mid/side for detection and GR, then decoded.
+enum class StereoMode
+{
+    leftRight,
+    midSide
+};
+
+struct LinkGroupMap
+{
+    // Everything in one group (classic fully linked stereo / mono).
+    static LinkGroupMap allLinked (int numChannels)
+    {
+        LinkGroupMap m;
+        m.numChannels = juce::jlimit(1, ChannelGroups::kMaxChannels, numChannels);
+        m.numGroups = 1;
+        m.groupOf.fill(0);
+        m.rebuildMembers();
+        return m;
+    }
+
+    // Default immersive linking derived from the bus layout:
+    // front (L/R/C) | LFE | surround | rear surround | top front | top rear | anything else on its own.
+    static LinkGroupMap fromChannelSet (const juce::AudioChannelSet& set)
+    {
+        const int numCh = juce::jlimit(1, ChannelGroups::kMaxChannels, set.size());
+        if (numCh <= 2)
+            return allLinked(numCh);
+
+        enum Category { front, lfe, surround, rear, topFront, topRear, numCategories };
+        auto categoryOf = [] (juce::AudioChannelSet::ChannelType t) -> int
+        {
+            using CT = juce::AudioChannelSet::ChannelType;
+            switch (t)
+            {
+                case CT::left: case CT::right: case CT::centre:                                  return front;
+                case CT::LFE: case CT::LFE2:                                                     return lfe;
+                case CT::leftSurround: case CT::rightSurround:
+                case CT::leftSurroundSide: case CT::rightSurroundSide:                           return surround;
+                case CT::leftSurroundRear: case CT::rightSurroundRear: case CT::centreSurround:  return rear;
+                case CT::topFrontLeft: case CT::topFrontRight: case CT::topFrontCentre:          return topFront;
+                case CT::topRearLeft: case CT::topRearRight: case CT::topRearCentre:             return topRear;
+                default:                                                                         return -1;
+            }
+        };
+
+        LinkGroupMap m;
+        m.numChannels = numCh;
+        m.numGroups = 0;
+
+        std::array<int, numCategories> groupOfCategory;
+        groupOfCategory.fill(-1);
+
+        for (int ch = 0; ch < numCh; ++ch)
+        {
+            const int cat = categoryOf(set.getTypeOfChannel(ch));
+            if (cat < 0)
+            {
+                m.groupOf[(size_t) ch] = m.numGroups++; // unknown type: link alone
+                continue;
+            }
+            if (groupOfCategory[(size_t) cat] < 0)
+                groupOfCategory[(size_t) cat] = m.numGroups++;
+            m.groupOf[(size_t) ch] = groupOfCategory[(size_t) cat];
+        }
+
+        m.rebuildMembers();
+        return m;
+    }
+
+    // Custom map: groups[ch] for ch < numChannels; group ids are compacted to 0..numGroups-1.
+    static LinkGroupMap fromGroupIds (const int* groups, int numChannelsIn)
+    {
+        LinkGroupMap m;
+        m.numChannels = juce::jlimit(1, ChannelGroups::kMaxChannels, numChannelsIn);
+        m.numGroups = 0;
+
+        std::array<int, ChannelGroups::kMaxChannels> seenIds;
+        for (int ch = 0; ch < m.numChannels; ++ch)
+        {
+            int g = -1;
+            for (int k = 0; k < m.numGroups; ++k)
+                if (seenIds[(size_t) k] == groups[ch]) { g = k; break; }
+            if (g < 0)
+            {
+                g = m.numGroups++;
+                seenIds[(size_t) g] = groups[ch];
+            }
+            m.groupOf[(size_t) ch] = g;
+        }
+
+        m.rebuildMembers();
+        return m;
+    }
+
+    // Channels beyond the map (host gave more than prepared) join the last group.
+    int getGroup (int ch) const { return groupOf[(size_t) juce::jmin(ch, numChannels - 1)]; }
+    int getNumGroups() const    { return numGroups; }
+    int getNumChannels() const  { return numChannels; }
+
+    // Members of a group in channel order (first two form the correlation pair, if present)
+    int getGroupSize (int g) const         { return groupSize[(size_t) g]; }
+    int getMember (int g, int k) const     { return members[(size_t) g][(size_t) k]; }
+
+private:
+    void rebuildMembers()
+    {
+        groupSize.fill(0);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const int g = groupOf[(size_t) ch];
+            members[(size_t) g][(size_t) groupSize[(size_t) g]++] = ch;
+        }
+    }
+
+    int numChannels = 2;
+    int numGroups   = 1;
+    std::array<int, ChannelGroups::kMaxChannels> groupOf {};
+    std::array<int, ChannelGroups::kMaxGroups> groupSize {};
+    std::array<std::array<int, ChannelGroups::kMaxChannels>, ChannelGroups::kMaxGroups> members {};
+};
+
+// Structure-of-arrays control tile: lane[k][i] for lane k (one per channel), sample i of the tile.
+struct ControlLanes
+{
+    double*       operator[] (int k)       { return lanes[(size_t) k].data(); }
+    const double* operator[] (int k) const { return lanes[(size_t) k].data(); }
+
+    alignas(64) std::array<std::array<double, ChannelGroups::kTileSize>, ChannelGroups::kMaxLanes> lanes;
+};
@@ -2,13 +2,24 @@
 // Phase 3 sealed DSP active (GR law + application in GainComputer/GainReductionStage)
 // Phase 4 safety guards in progress (LowEndGuard integrated, logic pending)
 // No parameters / no UI — all control via injection
+// Phase 6: templated on the host sample type (float / double). Audio-path stages run natively in SampleType;
+// the control path (envelopes, GR law, smoothing) stays double for both.
+// Phase 6: specialized per QualityTier (Eco / Standard / Mastering, see QualityTier.h) at compile time.
 
 #pragma once
 #include <JuceHeader.h>
 
+#include <algorithm>
+#include <array>
+
+#include "ChannelGroups.h"
+#include "CpuGovernor.h"
+#include "QualityTier.h"
+#include "StageList.h"
 #include "InputConditioning.h"
 #include "DetectorSplit.h"
 #include "DetectorCore.h"
+#include "DspArena.h"
 #include "LowEndGuard.h"
 #include "TransientGuard.h"
 
@@ -16,26 +27,65 @@
 #include "HybridEnvelopeEngine.h"
 #include "GainComputer.h"
 #include "GainReductionStage.h"
+#include "HotStateBlock.h"
+#include "LookaheadDelay.h"
 #include "ParallelMixer.h"
+#include "ParamRamp.h"
+#include "SmootherBank.h"
 #include "StereoLink.h"
 #include "OutputStage.h"
 #include "OversamplingAndSafety.h"
 
+template <typename SampleType, QualityTier Tier = QualityTier::standard>
 struct CompressorPipeline
 {
+    using Buffer = juce::AudioBuffer<SampleType>;
+    using Traits = TierTraits<Tier>;
+    static constexpr QualityTier kTier = Tier;
+
+    // Phase 6: per-sample control path runs in fixed tiles (preallocated SoA lanes, no allocation)
+    static constexpr int kControlTileSize = GainReductionStage<SampleType>::kMaxTileSize;
+    static_assert(kControlTileSize == DetectorCore<SampleType>::kTileSize, "envelope tiles read detector tiles");
+
+    // Phase 6: stages keep their block-rate smoothers in the pipeline's SmootherBank and their per-sample
+    // filter / envelope memories in its HotStateBlock (attached here, laid out in prepare). Buffers come from
+    // the pipeline's own DspArena until an owner attaches the instance's (setArena). Not copyable: the stages
+    // point at this instance's bank, block and arena.
+    CompressorPipeline()
+    {
+        attachArena(localArena);
+
+        detectorCore.setHotState(hotState);
+        dualStageRelease.setHotState(hotState);
+        outputStage.setHotState(hotState);
+
+        detectorCore.setSmootherBank(smoothers);
+        transientGuard.setSmootherBank(smoothers);
+        hybridEnvelopeEngine.setSmootherBank(smoothers);
+        stereoLink.setSmootherBank(smoothers);
+        oversamplingAndSafety.setSmootherBank(smoothers);
+    }
+
+    CompressorPipeline (const CompressorPipeline&) = delete;
+    CompressorPipeline& operator= (const CompressorPipeline&) = delete;
+
     double sampleRateHz = 48000.0;
 
 
-    // Phase 5: injected user controls (targets) + block-rate smoothing (no zipper)
+    // Phase 5: injected user controls (targets) + smoothing (no zipper)
     double targetThresholdDb = -18.0;
     double targetRatio       =  4.0;
     double targetAttackMs    = 10.0;
     double targetReleaseMs   = 100.0;
 
-    double smoothedThresholdDb = -18.0;
-    double smoothedRatio       =  4.0;
-    double smoothedAttackNorm  =  0.0;
-    double smoothedReleaseNormUser = 0.0;
+    // Phase 6: per-sample automation ramps, advanced in the tile loop (independent of the host block size).
+    // Threshold reaches the GR law per sample, ratio per control tile (the curve is tabulated by ratio);
+    // attack / release feed block-rate laws, which read the ramp at the block start.
+    static constexpr double kParamRampSec = 0.010; // sealed: linear ramp length / exponential τ
+    ParamRamp thresholdRamp;   // dB, linear
+    ParamRamp ratioRamp;       // exponential
+    ParamRamp attackNormRamp;  // normalized, exponential
+    ParamRamp releaseNormRamp; // normalized, exponential
 
     void setControlTargets (double thresholdDb, double ratio, double attackMs, double releaseMs)
     {
@@ -44,385 +94,752 @@ struct CompressorPipeline
         targetAttackMs    = (std::isfinite(attackMs) ? attackMs : 10.0);
         targetReleaseMs   = (std::isfinite(releaseMs) ? releaseMs : 100.0);
     }
+
+    // Phase 6: channel -> link group map (e.g. LinkGroupMap::fromChannelSet(mainLayout)).
+    // Not real-time safe with respect to process(): call before prepare() or while processing is suspended.
+    void setLinkGroups (const LinkGroupMap& map)
+    {
+        linkGroups = map;
+        detectorCore.setLinkGroups(linkGroups);
+        stereoLink.setLinkGroups(linkGroups);
+        setStereoMode(stereoMode); // re-check the channel count
+    }
+
+    const LinkGroupMap& getLinkGroups() const { return linkGroups; }
+
+    // Phase 6: L/R or M/S processing of channels 0/1 (ignored below two channels). Block-rate switch.
+    void setStereoMode (StereoMode mode)
+    {
+        stereoMode = mode;
+        const bool ms = (mode == StereoMode::midSide && linkGroups.getNumChannels() >= 2);
+        detectorCore.setMidSide(ms);
+        stereoLink.setMidSide(ms);
+        gainReductionStage.setMidSide(ms);
+    }
+
+    StereoMode getStereoMode() const { return stereoMode; }
+
+    // Phase 6: CPU governor level (CpuGovernor::Level, cumulative). Block-rate, audio thread.
+    // Each shed fades or stays continuous; features the tier does not have are unaffected.
+    void setDegradationLevel (int level)
+    {
+        degradationLevel = juce::jlimit((int) CpuGovernor::kFull, (int) CpuGovernor::kMaxLevel, level);
+        oversamplingAndSafety.setShed(degradationLevel >= CpuGovernor::kShedOversampling);
+        detectorCore.setTruePeakShed(degradationLevel >= CpuGovernor::kShedTruePeak);
+    }
+
+    int getDegradationLevel() const { return degradationLevel; }
+
+    // Phase 6: multirate control (call before prepare; default per tier). Above ~88 kHz the detector measures a
+    // decimated signal and the envelope + GR law run at sampleRate / 2 or / 4 (>= 44.1 kHz); the GR curve is
+    // ramped back up to full rate for GainReductionStage. Ignored by true-peak tiers.
+    void setMultirateControl (bool shouldDecimate) { multirateControl = shouldDecimate; }
+    int getControlDecimation() const { return controlDecimation; }
+
+    // Decimation factor for a sample rate: largest of 1 / 2 / 4 keeping the control rate >= 44.1 kHz
+    static int controlDecimationFor (double sampleRate)
+    {
+        int d = 1;
+        while (d < kMaxControlDecimation && sampleRate / (double) (2 * d) >= 44100.0 - 1e-6)
+            d *= 2;
+        return d;
+    }
+
+    // Phase 6: instance arena (not owned; off the audio thread, before prepare). The owner lays it out: clears
+    // it before and finishes it after this pipeline's prepare().
+    void setArena (DspArena& instanceArena) { attachArena(instanceArena); }
+
+    // Phase 6: memory by stage (valid after prepare): arena regions (only when the arena is this pipeline's
+    // own; an owner reports its arena once), hot state, the pipeline object split by its largest members, and
+    // the JUCE-owned oversampler buffers
+    void addMemoryFootprint (MemoryFootprint& footprint) const
+    {
+        if (arena == &localArena)
+            localArena.addFootprint(footprint);
+        hotState.addFootprint(footprint);
+
+        const size_t detector = sizeof(detectorCore);
+        const size_t lanes    = sizeof(envLanes) + sizeof(grLanes);
+        const size_t gainLaw  = sizeof(gainComputer);
+        const size_t link     = sizeof(stereoLink);
+        const size_t bank     = sizeof(smoothers);
+        footprint.add("detector", detector);
+        footprint.add("control lanes", lanes);
+        footprint.add("gain computer", gainLaw);
+        footprint.add("stereo link", link);
+        footprint.add("smoother bank", bank);
+        footprint.add("other stages", sizeof(*this) - (detector + lanes + gainLaw + link + bank));
+        footprint.add("oversampler (JUCE-owned, estimated)", oversamplingAndSafety.getOversamplerBytesEstimate());
+    }
+
+    // Phase 6: false = skip OutputStage + OversamplingAndSafety (band pipelines inside MultibandCompressor)
+    void setOutputStagesEnabled (bool shouldRun) { outputStagesEnabled = shouldRun; }
+
+    // Phase 6: idle fast path. A block whose input (and external key) stays at or below kIdleFloor skips the
+    // control chain once the pipeline has drained: input quiet for the tier latency + one tile, previous output
+    // quiet, every envelope at the floor. Idle blocks pass their input through untouched (no gain reduction,
+    // no output stage) but keep the tier latency: the lookahead line keeps running and the oversampler is
+    // replaced by its dry delay. Entering idle settles the control state (hot state) to its digital-silence
+    // steady state; parameter ramps keep time, and the first audible block resumes from the settled state.
+    static constexpr double kIdleFloor = 1.0e-6; // -120 dBFS
+
+    bool isIdle() const { return idle; }
+
+    // Every sample of every channel at or below kIdleFloor (nullptr = no signal). Stops at the first loud sample.
+    static bool isQuiet (const Buffer* buffer)
+    {
+        if (buffer == nullptr)
+            return true;
+
+        const auto floor = (SampleType) kIdleFloor;
+        for (int ch = 0; ch < buffer->getNumChannels(); ++ch)
+        {
+            const SampleType* x = buffer->getReadPointer(ch);
+            for (int i = 0; i < buffer->getNumSamples(); ++i)
+                if (!(std::abs(x[i]) <= floor))
+                    return false;
+        }
+        return true;
+    }
+
+    // A block the owner skipped while this pipeline is idle: ramps, the release micro-modulation oscillator
+    // (control rate) and the multirate phase advance
+    void skipIdleBlock (int numSamples)
+    {
+        setRampTargets();
+        thresholdRamp.advance(numSamples);
+        ratioRamp.advance(numSamples);
+        attackNormRamp.advance(numSamples);
+        releaseNormRamp.advance(numSamples);
+        int first = 0;
+        dualStageRelease.advanceOscillator(controlDecimation > 1 ? numControlSamples(numSamples, first) : numSamples);
+        controlPhase = (controlPhase + numSamples) % controlDecimation;
+    }
+
+    // Phase 6: meter readouts of the last processed block (audio thread, after process()). Idle blocks read as
+    // no reduction; the link and engage readouts hold their settled values.
+    double getGainReductionDb() const      { return idle ? 0.0 : gainReductionStage.getGainReductionDb(); }
+    double getLinkAmount() const           { return stereoLink.getStrongestLinkAmount(); }
+    double getOversamplingEngage01() const { return outputStagesEnabled ? oversamplingAndSafety.getEngage01() : 0.0; }
+
     void prepare (double sampleRate, int maxBlockSize)
     {
         sampleRateHz = (sampleRate > 0.0 ? sampleRate : 48000.0);
+        maxBlock = juce::jmax(1, maxBlockSize);
 
 
         // Phase 5: initialize parameter smoothers to current targets (history preserved across blocks)
-        smoothedThresholdDb   = targetThresholdDb;
-        smoothedRatio         = targetRatio;
-        // Map attack/release (ms) -> normalized [0..1] using sealed log mapping
-        auto msToNorm01 = [](double ms, double msMin, double msMax)
-        {
-            if (!std::isfinite(ms)) ms = msMin;
-            if (ms < msMin) ms = msMin;
-            if (ms > msMax) ms = msMax;
-            const double lo = std::log(msMin);
-            const double hi = std::log(msMax);
-            const double x  = (std::log(ms) - lo) / (hi - lo);
-            if (!std::isfinite(x)) return 0.0;
-            if (x < 0.0) return 0.0;
-            if (x > 1.0) return 1.0;
-            return x;
-        };
-        smoothedAttackNorm     = msToNorm01(targetAttackMs, 0.1, 100.0);
-        smoothedReleaseNormUser= msToNorm01(targetReleaseMs, 10.0, 1000.0);
-        inputConditioning.prepare(sampleRate, maxBlockSize);
-        detectorSplit.prepare(sampleRate, maxBlockSize);
-        detectorCore.prepare(sampleRate, maxBlockSize);
-        lowEndGuard.prepare(sampleRate, maxBlockSize);
-        transientGuard.prepare(sampleRate, maxBlockSize);
-        
-        dualStageRelease.prepare(sampleRate, maxBlockSize);
-hybridEnvelopeEngine.prepare(sampleRate, maxBlockSize);
-        gainComputer.prepare(sampleRate, maxBlockSize);
-        gainReductionStage.prepare(sampleRate, maxBlockSize);
-        parallelMixer.prepare(sampleRate, maxBlockSize);
-        stereoLink.prepare(sampleRate, maxBlockSize);
-        outputStage.prepare(sampleRate, maxBlockSize);
-        oversamplingAndSafety.prepare(sampleRate, maxBlockSize);
+        thresholdRamp.prepare(sampleRateHz, kParamRampSec, ParamRamp::Shape::linear);
+        ratioRamp.prepare(sampleRateHz, kParamRampSec, ParamRamp::Shape::exponential);
+        attackNormRamp.prepare(sampleRateHz, kParamRampSec, ParamRamp::Shape::exponential);
+        releaseNormRamp.prepare(sampleRateHz, kParamRampSec, ParamRamp::Shape::exponential);
+        resetParamRamps();
+
+        // Phase 6: tier configuration (prepare-time)
+        controlDecimation = (multirateControl && !Traits::truePeak ? controlDecimationFor(sampleRateHz) : 1);
+        detectorCore.setControlDecimation(controlDecimation);
+        dualStageRelease.setControlDecimation(controlDecimation);
+        detectorCore.setTruePeak(Traits::truePeak);
+        lookahead.setDelayMs(Traits::lookaheadMs);
+        oversamplingAndSafety.setQuality(Traits::linearPhaseOs, Traits::alwaysOversample);
+
+        // Phase 6: stages re-register their smoothers (the bank tabulates coefficients once all slots exist)
+        // and lay out their hot state in topology order, packed at the prepared channel count
+        smoothers.clear();
+        hotState.clear(linkGroups.getNumChannels());
+        if (arena == &localArena)
+            localArena.clear(linkGroups.getNumChannels());
+        StageList::forEachStage(stages(), [&](auto& stage) { stage.prepare(sampleRate, maxBlockSize); });
+        latched.detectorHpfHz = lowEndGuard.getDynamicHpfFreqHz();
+        ratioBiasSlot = smoothers.add(kParamRampSec, smoothedRatioBias);
+        smoothers.prepare(sampleRateHz);
+        grStateOffset = hotState.reserve<double> (kNumGrRows * hotState.getNumChannels());
+
+        // The safety oversampler is built here in every tier (never on the audio thread)
+        if (outputStagesEnabled)
+            oversamplingAndSafety.preallocate(linkGroups.getNumChannels());
+
+        hotState.finish();
+        if (arena == &localArena)
+            localArena.finish();
+
+        idleHoldSamples = getLatencySamples() + kControlTileSize;
+        resetIdle();
+    }
+
+    // Phase 6: audio-path latency of this tier (lookahead + always-engaged oversampling), valid after prepare()
+    int getLatencySamples() const
+    {
+        return lookahead.getDelaySamples() + (outputStagesEnabled ? oversamplingAndSafety.getLatencySamples() : 0);
     }
 
     void reset()
     {
 
         // Phase 5: reset parameter smoothers to targets (no discontinuity)
-        smoothedThresholdDb   = targetThresholdDb;
-        smoothedRatio         = targetRatio;
-        auto msToNorm01 = [](double ms, double msMin, double msMax)
-        {
-            if (!std::isfinite(ms)) ms = msMin;
-            if (ms < msMin) ms = msMin;
-            if (ms > msMax) ms = msMax;
-            const double lo = std::log(msMin);
-            const double hi = std::log(msMax);
-            const double x  = (std::log(ms) - lo) / (hi - lo);
-            if (!std::isfinite(x)) return 0.0;
-            if (x < 0.0) return 0.0;
-            if (x > 1.0) return 1.0;
-            return x;
-        };
-        smoothedAttackNorm      = msToNorm01(targetAttackMs, 0.1, 100.0);
-        smoothedReleaseNormUser = msToNorm01(targetReleaseMs, 10.0, 1000.0);
-        inputConditioning.reset();
-        detectorSplit.reset();
-        detectorCore.reset();
-        lowEndGuard.reset();
-        transientGuard.reset();
-        
-        dualStageRelease.reset();
-hybridEnvelopeEngine.reset();
-        gainComputer.reset();
-        gainReductionStage.reset();
-        parallelMixer.reset();
-        stereoLink.reset();
-        outputStage.reset();
-        oversamplingAndSafety.reset();
+        resetParamRamps();
+        smoothedRatioBias = 0.0;
+        latched.attackBias01 = 0.0;
+        smoothers.resetClock();
+        smoothers.set(ratioBiasSlot, smoothedRatioBias);
+        StageList::forEachStage(stages(), [](auto& stage) { stage.reset(); });
+        latched.detectorHpfHz = lowEndGuard.getDynamicHpfFreqHz();
+        std::fill_n(grStateRow(0), kNumGrRows * hotState.getNumChannels(), 0.0);
+        controlPhase = 0;
+        resetIdle();
     }
 
     // processBlock — immutable topology order per Architecture Constitution
     // Active DSP: detector → envelope → gain computer → stereo link → gain reduction
     // Safety guards wired (LowEndGuard stub)
-    void process (juce::AudioBuffer<float>& buffer)
+    // sidechain: optional external key (host sidechain bus). nullptr = detect from the main input.
+    // Phase 6: hosts may exceed the prepared block size. The detector's tile lanes and the oversampler are sized
+    // for it, so longer blocks run in prepared-size chunks (views, no allocation), as MultibandCompressor does.
+    void process (Buffer& buffer, const Buffer* sidechain = nullptr)
     {
-        // Phase 5: smooth injected parameters (block-rate one-pole; preserves history)
-        const double sr_local = (sampleRateHz > 0.0 ? sampleRateHz : 48000.0);
-        const int n_local = buffer.getNumSamples();
-        auto onePoleBlock = [](double y, double x, double tauSec, int nSamp, double fs)
-        {
-            if (!std::isfinite(y)) y = 0.0;
-            if (!std::isfinite(x)) x = y;
-            if (tauSec <= 0.0 || nSamp <= 0 || fs <= 0.0) return x;
-            const double a = std::exp(-(double)nSamp / (tauSec * fs));
-            return a * y + (1.0 - a) * x;
-        };
-        auto clamp01_local = [](double x)
-        {
-            if (!std::isfinite(x)) return 0.0;
-            if (x < 0.0) return 0.0;
-            if (x > 1.0) return 1.0;
-            return x;
-        };
-        auto msToNorm01 = [](double ms, double msMin, double msMax)
+        const int numS = buffer.getNumSamples();
+        if (numS <= maxBlock)
         {
-            if (!std::isfinite(ms)) ms = msMin;
-            if (ms < msMin) ms = msMin;
-            if (ms > msMax) ms = msMax;
-            const double lo = std::log(msMin);
-            const double hi = std::log(msMax);
-            const double x  = (std::log(ms) - lo) / (hi - lo);
-            if (!std::isfinite(x)) return 0.0;
-            if (x < 0.0) return 0.0;
-            if (x > 1.0) return 1.0;
-            return x;
-        };
-
-        // Targets (sanitized)
-        const double thrT  = juce::jlimit(-60.0, 0.0, (std::isfinite(targetThresholdDb) ? targetThresholdDb : -18.0));
-        const double ratioT= juce::jlimit(1.5, 20.0, (std::isfinite(targetRatio) ? targetRatio : 4.0));
-        const double aNormT= clamp01_local(msToNorm01(targetAttackMs, 0.1, 100.0));
-        const double rNormT= clamp01_local(msToNorm01(targetReleaseMs, 10.0, 1000.0));
-
-        // Smoothing time constants (sealed; automation-safe)
-        constexpr double tauParam = 0.010; // 10 ms
-        smoothedThresholdDb   = onePoleBlock(smoothedThresholdDb, thrT,   tauParam, n_local, sr_local);
-        smoothedRatio         = onePoleBlock(smoothedRatio,       ratioT, tauParam, n_local, sr_local);
-        smoothedAttackNorm    = onePoleBlock(smoothedAttackNorm,  aNormT, tauParam, n_local, sr_local);
-        smoothedReleaseNormUser = onePoleBlock(smoothedReleaseNormUser, rNormT, tauParam, n_local, sr_local);
-
-        // Inject into existing control lanes before DSP runs
-        gainComputer.setThresholdDb(smoothedThresholdDb);
-        detectorCore.setAttackNormalized(smoothedAttackNorm);
-        detectorCore.setReleaseNormalized(smoothedReleaseNormUser);
+            processChunk(buffer, sidechain);
+            return;
+        }
 
-        // 1. Input Conditioning
-        inputConditioning.process(buffer);
+        for (int start = 0; start < numS; start += maxBlock)
+        {
+            const int n = juce::jmin(maxBlock, numS - start);
 
-        // 2. Detector Split
-        detectorSplit.process(buffer);
+            Buffer chunk (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, n);
+            Buffer keyChunk;
+            const Buffer* key = nullptr;
+            if (sidechain != nullptr && sidechain->getNumSamples() == numS && sidechain->getNumChannels() > 0)
+            {
+                keyChunk.setDataToReferTo(const_cast<SampleType* const*> (sidechain->getArrayOfReadPointers()),
+                                          sidechain->getNumChannels(), start, n);
+                key = &keyChunk;
+            }
+            processChunk(chunk, key);
+        }
+    }
 
-        // 3-7. Detector Core + Hybrid Envelopes + Weighting (represented)
-        // Phase 4B.1 — inject LowEndGuard dynamic detector HPF recommendation (measurement path only)
-        // NOTE: LowEndGuard is processed later in the block currently; this feeds the most recently computed HPF value.
-        detectorCore.setDetectorHpfCutoffHz(lowEndGuard.getDynamicHpfFreqHz());
-        detectorCore.process(buffer);
-        transientGuard.setTransientLinear(detectorCore.getTransientLinear());
-        // Phase 4A.1 LowEndGuard integration — control plumbing only.
-        // NOTE: low-end dominance is an injected signal; until DetectorCore exposes it,
-        // we keep a neutral placeholder (0.0).
-        // Phase 4A.2 placeholder — low-end dominance source not available yet.
-        // Keep 0.0 (neutral) until DetectorCore exposes a real dominance01 signal.
-// Placeholders until parameter wiring / proper sources exist:
-                lowEndGuard.setLowEndDominance(detectorCore.getLowEndDominance());
-        lowEndGuard.setCurrentReleaseMs(targetReleaseMs);
-                const double userRatio = smoothedRatio;
-lowEndGuard.setCurrentRatio(userRatio);
-        lowEndGuard.process(buffer);
+    // At most maxBlock samples
+    void processChunk (Buffer& buffer, const Buffer* sidechain)
+    {
+        // Phase 6: idle fast path (see kIdleFloor)
+        const int numSamples = buffer.getNumSamples();
+        const bool quiet = isQuiet(&buffer) && isQuiet(sidechain);
+        if (quiet && (idle || (quietSamples >= idleHoldSamples && outputQuiet
+                               && dualStageRelease.isSettled(kIdleFloor))))
+        {
+            if (!idle)
+                settleToSilence();
+            idle = true;
+            skipIdleBlock(numSamples);
+            processIdle(buffer);
+            return;
+        }
 
-        
+        idle = false;
+        processActive(buffer, sidechain);
+        quietSamples = (quiet ? juce::jmin(quietSamples + numSamples, idleHoldSamples) : 0);
+        outputQuiet = quiet && isQuiet(&buffer);
+    }
 
-        // Phase 4E.2 — DualStageRelease integrated (plumbing-only; no behavior change)
-                // Phase 4E.3 — DualStageRelease injection wiring (plumbing-only; no behavior change)
-        dualStageRelease.setReleaseNormalized(detectorCore.getReleaseNormalized());
-        // Program-material indicator source (existing placeholder signal; no new math)
-        dualStageRelease.setProgramMaterial01(detectorCore.getCrestNormalized());
-        // GR depth readout source (existing readout; DualStageRelease remains no-op)
-        dualStageRelease.setGainReductionDbIn(gainComputer.getGainReductionDb());
+    void processActive (Buffer& buffer, const Buffer* sidechain)
+    {
+        // Phase 5: smooth injected parameters (Phase 6: per-sample ramps towards the targets; preserves history)
+        // Phase 6: block-rate smoothers (every stage's, plus the ratio bias) advance by this block's tiles
+        smoothers.beginBlock(buffer.getNumSamples());
 
-        dualStageRelease.process(buffer); // no-op stub
+        // Targets (sanitized)
+        setRampTargets();
 
-        // Phase 4E.6 — Apply LowEndGuard releaseAdjustmentFactor into existing release control lane
-        // Compute final effective release ms, then map back to normalized release lane (no new params/UI)
-        static double smoothedReleaseNorm = 0.0;
-        {
-            const double baseEffMs = dualStageRelease.getEffectiveReleaseMs();
-            const double leFactor  = lowEndGuard.getReleaseAdjustmentFactor();
-            double finalEffMs = baseEffMs * leFactor;
+        // Block-rate laws see the ramps at the block start
+        BlockSignals block { buffer };
+        block.sidechain       = sidechain;
+        block.releaseNormUser = releaseNormRamp.getCurrent();
+        block.userRatio       = ratioRamp.getCurrent();
 
-            if (!std::isfinite(finalEffMs) || finalEffMs <= 0.0)
-                finalEffMs = baseEffMs;
+        // Inject into existing control lanes before DSP runs
+        gainComputer.setThresholdDb(thresholdRamp.getCurrent());
+        detectorCore.setAttackNormalized(attackNormRamp.getCurrent());
+        detectorCore.setReleaseNormalized(block.releaseNormUser);
 
-            // Clamp to the canonical release range used by the sealed base mapping (40..1200 ms)
-            auto clampMs = [](double x, double lo, double hi)
-            {
-                if (!std::isfinite(x)) return lo;
-                if (x < lo) return lo;
-                if (x > hi) return hi;
-                return x;
-            };
+        // Phase 6: one step per stage, folded over the stage list in topology order (see step() below)
+        StageList::forEachStage(stages(), [this, &block] (auto& stage) { step(stage, block); });
+    }
 
-            finalEffMs = clampMs(finalEffMs, 40.0, 1200.0);
+    // ----------------------------
+    // Phase 6: stage steps. process() runs step(stage, block) for every entry of stages(), in list order; each
+    // step is that stage's injection wiring + process() call. Values a stage hands to a later one travel in
+    // BlockSignals (this block only); values a later stage hands back to an earlier one (TransientGuard bias,
+    // LowEndGuard HPF) are latched in Latched and read on the next block.
+    // ----------------------------
+    struct BlockSignals
+    {
+        Buffer& buffer;
+        const Buffer* sidechain = nullptr;
+        const Buffer* detectorSource = nullptr; // DetectorSplit: main input or external key
+        double releaseNormUser = 0.0;           // ramps at the block start
+        double userRatio = 4.0;
+        double effectiveRatio = 4.0;            // user ratio + LowEndGuard ratio bias
+        double detectorLin = 0.0;               // detector readouts, latched once per block
+        double crestNorm = 0.0;
+        double attackNorm = 0.0;
+        double attackBiased = 0.0;              // attack lane after the TransientGuard bias
+    };
+
+    struct Latched
+    {
+        double detectorHpfHz = 0.0; // LowEndGuard dynamic HPF -> DetectorCore measurement HPF
+        double attackBias01  = 0.0; // Phase 4D.2A TransientGuard attack bias -> envelope attack lane
+    };
 
-            // Invert smoothstep(0..1) ~= 3x^2 - 2x^3 via deterministic Newton iterations
-            auto smoothstepInv01 = [](double y)
-            {
-                auto clamp01_local = [](double x)
-                {
-                    if (!std::isfinite(x)) return 0.0;
-                    if (x < 0.0) return 0.0;
-                    if (x > 1.0) return 1.0;
-                    return x;
-                };
+    // Placeholders (kIsNoOp stages compile away)
+    template <typename Stage>
+    void step (Stage& stage, BlockSignals& block) { StageList::runStage(stage, block.buffer); }
 
-                y = clamp01_local(y);
-                // Start near y (reasonable for monotonic)
-                double x = y;
+    // 2. Detector Split (pointer selection: main input or sidechain key, no copy)
+    void step (DetectorSplit<SampleType>&, BlockSignals& block)
+    {
+        detectorSplit.setExternalKey(block.sidechain);
+        detectorSplit.process(block.buffer);
+        block.detectorSource = &detectorSplit.getDetectorSource();
+    }
 
-                for (int i = 0; i < 6; ++i)
-                {
-                    // f(x) = 3x^2 - 2x^3 - y
-                    const double f  = (3.0 * x * x) - (2.0 * x * x * x) - y;
-                    // f'(x) = 6x - 6x^2
-                    const double fp = (6.0 * x) - (6.0 * x * x);
+    // 3-7. Detector Core + Hybrid Envelopes + Weighting (represented)
+    void step (DetectorCore<SampleType>&, BlockSignals& block)
+    {
+        // Phase 4B.1 — inject LowEndGuard dynamic detector HPF recommendation (measurement path only).
+        // LowEndGuard runs later in the block: this is the previous block's value (Latched).
+        detectorCore.setDetectorHpfCutoffHz(latched.detectorHpfHz);
+        detectorCore.setGroupedMeasurement(!detectorSplit.isUsingExternalKey());
+        detectorCore.process(*block.detectorSource);
+
+        // Phase 6: detector readouts latched once per block (each getter re-clamps)
+        block.detectorLin = detectorCore.getDetectorLinear();
+        block.crestNorm   = detectorCore.getCrestNormalized();
+        block.attackNorm  = detectorCore.getAttackNormalized();
+    }
 
-                    if (!std::isfinite(fp) or fp == 0.0)
-                        break;
+    // Phase 4A.1 LowEndGuard integration + Phase 4B.2 ratio softening (control wiring only; no parameters/UI)
+    void step (LowEndGuard&, BlockSignals& block)
+    {
+        lowEndGuard.setLowEndDominance(detectorCore.getLowEndDominance());
+        lowEndGuard.setCurrentReleaseMs(targetReleaseMs);
+        lowEndGuard.setCurrentRatio(block.userRatio);
+        lowEndGuard.process(block.buffer);
+        latched.detectorHpfHz = lowEndGuard.getDynamicHpfFreqHz();
 
-                    x = x - (f / fp);
-                    x = clamp01_local(x);
-                }
-                return clamp01_local(x);
-            };
-
-            // Map ms -> normalized using inverse of baseReleaseMs = lerp(40,1200,smooth01(R))
-            const double t = (finalEffMs - 40.0) / (1200.0 - 40.0);
-            const double targetR = smoothstepInv01(t);
-
-            // Smooth normalized release to avoid abrupt changes (τ = 10 ms)
-            const double sr_local = (sampleRateHz > 0.0 ? sampleRateHz : 48000.0);
-            const int n_local = buffer.getNumSamples();
-            const double tau = 0.010;
-            const double a = std::exp(-(double)n / (tau * sr));
-            smoothedReleaseNorm = a * smoothedReleaseNorm + (1.0 - a) * targetR;
-        }
-// Phase 4B.2 — Ratio Softening (control wiring only; no parameters/UI)
         // Smooth ratioBias (τ = 10 ms) then apply additively to injected userRatio.
-        static double smoothedRatioBias = 0.0;
         const double targetRatioBias = lowEndGuard.getRatioBias();
-        const double sr_local = (sampleRateHz > 0.0 ? sampleRateHz : 48000.0);
-        const int n_local = buffer.getNumSamples();
-        const double tau = 0.010; // 10 ms
-        const double a = std::exp(-(double)n / (tau * sr));
-        smoothedRatioBias = a * smoothedRatioBias + (1.0 - a) * targetRatioBias;
-
-        double effectiveRatio = userRatio + smoothedRatioBias;
-        if (!std::isfinite(effectiveRatio) || effectiveRatio < 1.5)
-            effectiveRatio = 1.5;
+        smoothedRatioBias = smoothers.process(ratioBiasSlot, targetRatioBias); // same τ as the parameter ramps
 
-        gainComputer.setRatio(effectiveRatio);
-
- // no-op in Phase 4A.0 stub
+        block.effectiveRatio = block.userRatio + smoothedRatioBias;
+        if (!std::isfinite(block.effectiveRatio) || block.effectiveRatio < 1.5)
+            block.effectiveRatio = 1.5;
 
+        gainComputer.setRatio(block.effectiveRatio);
+    }
 
+    void step (HybridEnvelopeEngine&, BlockSignals& block)
+    {
         // Wire detector outputs into hybrid engine (Phase 2 plumbing only)
-        hybridEnvelopeEngine.setDetectorLinear(detectorCore.getDetectorLinear());
-                // Phase 4D.2A — TransientGuard wiring (attackBias01 -> next-block attack bias)
+        hybridEnvelopeEngine.setDetectorLinear(block.detectorLin);
+        // Phase 4D.2A — TransientGuard wiring (attackBias01 -> next-block attack bias)
         // NOTE: attackBias01 is computed later in the block (after gainComputer), so we apply it next block.
-        static double tgAttackBias01 = 0.0;
-        auto clamp01_local = [](double x)
-        {
-            if (x < 0.0) return 0.0;
-            if (x > 1.0) return 1.0;
-            return x;
-        };
         constexpr double kTgAttackBiasK = 0.25; // sealed
-        const double A0 = detectorCore.getAttackNormalized();
-        const double Ab = clamp01_local(A0 + kTgAttackBiasK * clamp01_local(tgAttackBias01));
-        hybridEnvelopeEngine.setAttackNormalized(Ab);
+        block.attackBiased = clamp01(block.attackNorm + kTgAttackBiasK * clamp01(latched.attackBias01));
+        hybridEnvelopeEngine.setAttackNormalized(block.attackBiased);
+
+        // Phase 6: hybrid weights see the user release intent directly (no release -> normalized round trip)
+        hybridEnvelopeEngine.setReleaseNormalized(block.releaseNormUser);
+        hybridEnvelopeEngine.setCrestNormalized(block.crestNorm);
+        hybridEnvelopeEngine.process(block.buffer);
+    }
 
-        hybridEnvelopeEngine.setReleaseNormalized(smoothedReleaseNorm);
-        hybridEnvelopeEngine.setCrestNormalized(detectorCore.getCrestNormalized());
-        hybridEnvelopeEngine.process(buffer);
+    // Phase 4E — DualStageRelease: block-rate law (weights + stage coefficients)
+    void step (DualStageRelease&, BlockSignals& block)
+    {
+        dualStageRelease.setReleaseNormalized(detectorCore.getReleaseNormalized());
+        // Program-material indicator source (existing placeholder signal; no new math)
+        dualStageRelease.setProgramMaterial01(block.crestNorm);
+        // GR depth readout source (previous block's deepest GR)
+        dualStageRelease.setGainReductionDbIn(gainComputer.getGainReductionDb());
+        // Phase 4E.6 — LowEndGuard releaseAdjustmentFactor tightens both release stages directly
+        dualStageRelease.setReleaseAdjustmentFactor(lowEndGuard.getReleaseAdjustmentFactor());
+        // Shared attack (ms) from the biased attack lane (sealed 0.10 .. 30 ms smoothstep map)
+        dualStageRelease.setAttackMs(attackNormToMs(block.attackBiased));
+        dualStageRelease.process(block.buffer);
+    }
 
+    // 8. Gain Computer + soft knee (block-rate: curve table upkeep + block estimate)
+    void step (GainComputer&, BlockSignals& block)
+    {
         // Wire hybrid detector/envelope into gain computer (Phase 3 plumbing only)
-        gainComputer.setDetectorLinear(detectorCore.getDetectorLinear());
+        gainComputer.setDetectorLinear(block.detectorLin);
         gainComputer.setHybridEnvLinear(hybridEnvelopeEngine.getHybridEnv());
+        gainComputer.process(block.buffer);
+    }
 
-        // 8. Gain Computer + soft knee (represented)
-        gainComputer.process(buffer);
-
-
-        transientGuard.setGainReductionDb(gainComputer.getGainReductionDb());
-        transientGuard.process(buffer); // no-op stub (Phase 4 plumbing)
-        // Phase 4D.2A — latch computed TransientGuard output for next block’s envelope wiring
-        tgAttackBias01 = transientGuard.getAttackBias01();
-
-        // 9.5 Stereo Link control (Phase 3 plumbing only)
+    // 9.5 Stereo Link control (Phase 3 plumbing only)
+    // Block-rate: correlation measurement + per-group link amount (measures pre-GR audio).
+    void step (StereoLink<SampleType>&, BlockSignals& block)
+    {
         stereoLink.setGainReductionDbIn(gainComputer.getGainReductionDb());
         stereoLink.setGainReductionLinearIn(gainComputer.getGainReductionLinear());
-        // Placeholder link amount until parameter wiring (Phase 5)
-        // Placeholder correlation until measurement / dynamic law wiring (Phase 5)
-        stereoLink.process(buffer);
-
-
-        // 10. Gain Reduction application (represented)
-        // Wire gain computer outputs into gain reduction stage (Phase 3 plumbing only)
-        gainReductionStage.setGainReductionDb(stereoLink.getGainReductionDbOut());
-        gainReductionStage.setGainReductionLinear(stereoLink.getGainReductionLinearOut());
-
-        gainReductionStage.process(buffer);
-
-        // 10.5 Character Engine (wet path — Phase 3 placement)
-        // 11. Parallel Mixer (represented)
-        parallelMixer.process(buffer);
-
-        // 12. Stereo Link application (represented)
-        // (processed earlier as control plumbing before GainReductionStage)
-
-        // 13-15. Output + Auto-makeup + Safety (represented)
-        outputStage.process(buffer);
-        // Phase 4 Step 3 — Oversampling Safety injections (control-only)
-
-        // Sealed attackMs estimate from attack normalized (A in [0..1]):
-
-        //  map A -> [0.10 .. 30.0] ms using smoothstep
+        stereoLink.setDetectorSource(block.detectorSource);
+        stereoLink.setGroupedMeasurement(!detectorSplit.isUsingExternalKey());
+        stereoLink.process(block.buffer);
+    }
 
-        auto smooth01_local = [](double x)
+    // Phase 6 (Mastering): delay the audio so GR from the undelayed detector leads the transient
+    void step (LookaheadDelay<SampleType>&, BlockSignals& block)
+    {
+        if constexpr (Traits::lookaheadMs > 0.0)
+            lookahead.process(block.buffer);
+    }
 
+    // Phase 6 — per-sample control tiles, one lane per channel:
+    // tile detection -> link blend (group vs own detection) -> hybrid target -> dual-stage envelope -> GR law
+    // -> 10. Gain Reduction application (M/S fused in mid/side mode)
+    // Eco tier (or CpuGovernor::kShedPerSampleControl): one envelope / GR step per lane per tile,
+    // GR ramped linearly across the tile. The per-sample path keeps lastGrDb current so either switch
+    // direction is continuous.
+    void step (GainReductionStage<SampleType>&, BlockSignals& block)
+    {
+        Buffer& buffer = block.buffer;
+        const int n_local = buffer.getNumSamples();
+        const bool tileRateControl = (!Traits::perSampleControl
+                                      || degradationLevel >= CpuGovernor::kShedPerSampleControl);
+        const int numLanes = juce::jmin(buffer.getNumChannels(), linkGroups.getNumChannels(),
+                                        hotState.getNumChannels());
+        double* const lastGrDb   = grStateRow(kLastGrRow);
+        double* const ctrlGrFrom = grStateRow(kCtrlGrFromRow);
+        double* const ctrlGrTo   = grStateRow(kCtrlGrToRow);
+        for (int start = 0; start < n_local; start += kControlTileSize)
         {
+            const int len = juce::jmin(kControlTileSize, n_local - start);
+
+            // This tile's detection (DetectorCore tile lanes), link-blended and hybrid-weighted per lane
+            const int tile = start / kControlTileSize;
+            double envTarget[ChannelGroups::kMaxLanes];
+            stereoLink.blendDetectors(detectorCore.getTileGroupDetectorLinear(tile),
+                                      detectorCore.getTileChannelDetectorLinear(tile), envTarget, numLanes);
+            hybridEnvelopeEngine.blendLanes(envTarget, envTarget, numLanes);
+
+            // Automation ramps: threshold per sample, ratio (+ block-rate LowEndGuard bias) per tile
+            double thresholdLane[kControlTileSize];
+            thresholdRamp.fill(thresholdLane, len);
+            const double tileRatio = ratioRamp.advance(len) + smoothedRatioBias;
+            gainComputer.setRatio(std::isfinite(tileRatio) && tileRatio >= 1.5 ? tileRatio : 1.5);
+            attackNormRamp.advance(len);
+            releaseNormRamp.advance(len);
+
+            if (!tileRateControl && controlDecimation > 1)
+            {
+                // Multirate: control samples at every D-th full-rate sample (threshold sampled there),
+                // GR ramped back up to full rate
+                int first = 0;
+                const int m = numControlSamples(len, first);
+                double thresholdCtrl[kControlTileSize];
+                for (int j = 0; j < m; ++j)
+                    thresholdCtrl[j] = thresholdLane[first + j * controlDecimation];
+                for (int k = 0; k < numLanes; ++k)
+                    std::fill(envLanes[k], envLanes[k] + m, envTarget[k]);
+
+                dualStageRelease.processEnvelope(envLanes, envLanes, numLanes, m);
+                gainComputer.template processTile<Traits::accuracy>(envLanes, envLanes, numLanes, m, thresholdCtrl);
+                interpolateControlGr(envLanes, numLanes, len);
+            }
+            else if (!tileRateControl)
+            {
+                for (int k = 0; k < numLanes; ++k)
+                    std::fill(envLanes[k], envLanes[k] + len, envTarget[k]);
 
-            if (!std::isfinite(x)) return 0.0;
+                dualStageRelease.processEnvelope(envLanes, envLanes, numLanes, len);
+                gainComputer.template processTile<Traits::accuracy>(envLanes, grLanes, numLanes, len, thresholdLane);
 
-            if (x < 0.0) x = 0.0;
+                for (int k = 0; k < numLanes; ++k)
+                    lastGrDb[k] = grLanes[k][len - 1];
+            }
+            else
+            {
+                for (int k = 0; k < numLanes; ++k)
+                    envLanes[k][0] = envTarget[k];
 
-            if (x > 1.0) x = 1.0;
+                // The envelope counts control-rate samples (multirate mode: the tile's decimated share)
+                int first = 0;
+                const int envSamples = (controlDecimation > 1 ? numControlSamples(len, first) : len);
+                dualStageRelease.processEnvelopeTileRate(envLanes, envLanes, numLanes, envSamples);
+                gainComputer.template processTile<Traits::accuracy>(envLanes, grLanes, numLanes, 1,
+                                                                    thresholdLane + (len - 1));
 
-            return x * x * (3.0 - 2.0 * x);
+                for (int k = 0; k < numLanes; ++k)
+                {
+                    const double g0 = lastGrDb[k];
+                    const double g1 = grLanes[k][0];
+                    const double step = (g1 - g0) / (double) len;
+                    double* gr = grLanes[k];
+                    for (int i = 0; i < len; ++i)
+                        gr[i] = g0 + step * (double) (i + 1);
+                    lastGrDb[k] = g1;
+                    ctrlGrFrom[k] = ctrlGrTo[k] = g1; // a multirate segment resumes flat from here
+                }
+                controlPhase = (controlPhase + len) % controlDecimation;
+            }
 
-        };
+            gainReductionStage.template processTile<Traits::accuracy>(buffer, start, grLanes, len);
+        }
+    }
 
-        const double A_forOS = clamp01_local(detectorCore.getAttackNormalized());
+    void step (TransientGuard&, BlockSignals& block)
+    {
+        transientGuard.setTransientLinear(detectorCore.getTransientLinear());
+        transientGuard.setGainReductionDb(gainComputer.getGainReductionDb());
+        transientGuard.process(block.buffer); // no-op stub (Phase 4 plumbing)
+        // Phase 4D.2A — latch computed TransientGuard output for next block’s envelope wiring
+        latched.attackBias01 = transientGuard.getAttackBias01();
+    }
 
-        const double aCurve  = smooth01_local(A_forOS);
+    // 13-15. Output + Auto-makeup + Safety (represented)
+    // Phase 6: band pipelines (multiband mode) skip both; the output guards run once on the band sum.
+    void step (OutputStage<SampleType>&, BlockSignals& block)
+    {
+        if (outputStagesEnabled)
+            outputStage.process(block.buffer);
+    }
 
-        const double attackMsForOS = 0.10 + (30.0 - 0.10) * aCurve;
+    // Phase 4 Step 3 — Oversampling Safety injections (control-only)
+    void step (OversamplingAndSafety<SampleType>&, BlockSignals& block)
+    {
+        // Phase 6 (Eco): no oversampling stage at all (OutputStage's soft-limit remains)
+        if constexpr (!Traits::oversampling)
+            return;
 
+        if (!outputStagesEnabled)
+            return;
 
-        // Peak abs for saturation-risk trigger (sealed)
+        // Sealed attackMs estimate from attack normalized (A in [0..1]):
+        //  map A -> [0.10 .. 30.0] ms using smoothstep
+        const double attackMsForOS = attackNormToMs(block.attackNorm);
 
+        // Peak abs for saturation-risk trigger (sealed)
+        const Buffer& buffer = block.buffer;
         double peakAbs = 0.0;
-
         for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-
         {
+            const SampleType* p = buffer.getReadPointer(ch);
+            SampleType chPeak = 0;
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const SampleType v = std::abs(p[i]);
+                if (v > chPeak) chPeak = v;
+            }
+            if ((double) chPeak > peakAbs) peakAbs = (double) chPeak;
+        }
 
-            const float* p = buffer.getReadPointer(ch);
+        oversamplingAndSafety.setRatio(block.effectiveRatio);
+        oversamplingAndSafety.setAttackMs(attackMsForOS);
+        oversamplingAndSafety.setPeakAbs(peakAbs);
+        oversamplingAndSafety.process(block.buffer);
+    }
 
-            for (int i = 0; i < buffer.getNumSamples(); ++i)
+    // Multirate: control samples among the next n full-rate samples (one where controlPhase wraps to 0);
+    // first = offset of the first one
+    int numControlSamples (int n, int& first) const
+    {
+        first = (controlPhase == 0 ? 0 : controlDecimation - controlPhase);
+        return (first < n ? (n - 1 - first) / controlDecimation + 1 : 0);
+    }
 
+    // Multirate: full-rate GR lanes from the tile's control-rate GR (ctrlGr, one value per control sample).
+    // Each control sample starts a D-sample linear segment from the previous control value, so the curve
+    // is continuous and reaches each control value D - 1 samples after its control instant.
+    void interpolateControlGr (const ControlLanes& ctrlGr, int numLanes, int len)
+    {
+        const int d = controlDecimation;
+        const double invD = 1.0 / (double) d;
+        double* const lastGrDb   = grStateRow(kLastGrRow);
+        double* const ctrlGrFrom = grStateRow(kCtrlGrFromRow);
+        double* const ctrlGrTo   = grStateRow(kCtrlGrToRow);
+        for (int k = 0; k < numLanes; ++k)
+        {
+            const double* src = ctrlGr[k];
+            double* gr = grLanes[k];
+            double from = ctrlGrFrom[k];
+            double to = ctrlGrTo[k];
+            int pos = controlPhase;
+            int j = 0;
+            for (int i = 0; i < len;)
             {
+                if (pos == 0)
+                {
+                    from = to;
+                    to = src[j++];
+                }
+                const int seg = juce::jmin(d - pos, len - i);
+                const double step = (to - from) * invD;
+                for (int s = 0; s < seg; ++s)
+                    gr[i + s] = from + step * (double) (pos + s + 1);
+                i += seg;
+                pos = (pos + seg < d ? pos + seg : 0);
+            }
+            ctrlGrFrom[k] = from;
+            ctrlGrTo[k] = to;
+            lastGrDb[k] = gr[len - 1];
+        }
+        controlPhase = (controlPhase + len) % d;
+    }
 
-                const double v = std::abs((double)p[i]);
+    void resetParamRamps()
+    {
+        thresholdRamp.reset(juce::jlimit(-60.0, 0.0, targetThresholdDb));
+        ratioRamp.reset(juce::jlimit(1.5, 20.0, targetRatio));
+        attackNormRamp.reset(attackMsToNorm01(targetAttackMs));
+        releaseNormRamp.reset(releaseMsToNorm01(targetReleaseMs));
+    }
 
-                if (v > peakAbs) peakAbs = v;
+    // Map attack/release (ms) -> normalized [0..1] using sealed log mapping (log bounds precomputed:
+    // attack 0.1 .. 100 ms, release 10 .. 1000 ms)
+    static double attackMsToNorm01 (double ms)  { return msToNorm01(ms, 0.1, 100.0, -2.302585092994046, 6.907755278982137); }
+    static double releaseMsToNorm01 (double ms) { return msToNorm01(ms, 10.0, 1000.0, 2.302585092994046, 4.605170185988092); }
 
-            }
+    static double msToNorm01 (double ms, double msMin, double msMax, double logMin, double logSpan)
+    {
+        if (!std::isfinite(ms)) ms = msMin;
+        if (ms < msMin) ms = msMin;
+        if (ms > msMax) ms = msMax;
+        const double x  = (std::log(ms) - logMin) / logSpan;
+        if (!std::isfinite(x)) return 0.0;
+        if (x < 0.0) return 0.0;
+        if (x > 1.0) return 1.0;
+        return x;
+    }
 
-        }
+    // Clamp to [0..1]; non-finite reads as 0
+    static double clamp01 (double x)
+    {
+        if (!std::isfinite(x)) return 0.0;
+        if (x < 0.0) return 0.0;
+        if (x > 1.0) return 1.0;
+        return x;
+    }
 
+    void setRampTargets()
+    {
+        const double thrT  = juce::jlimit(-60.0, 0.0, (std::isfinite(targetThresholdDb) ? targetThresholdDb : -18.0));
+        const double ratioT= juce::jlimit(1.5, 20.0, (std::isfinite(targetRatio) ? targetRatio : 4.0));
+        const double aNormT= clamp01(attackMsToNorm01(targetAttackMs));
+        const double rNormT= clamp01(releaseMsToNorm01(targetReleaseMs));
 
-        oversamplingAndSafety.setRatio(effectiveRatio);
+        thresholdRamp.setTarget(thrT);
+        ratioRamp.setTarget(ratioT);
+        attackNormRamp.setTarget(aNormT);
+        releaseNormRamp.setTarget(rNormT);
+    }
 
-        oversamplingAndSafety.setAttackMs(attackMsForOS);
+    // Phase 6: idle fast path — entry settles the control memories to silence (no allocation). The audio
+    // delay lines are left alone: they hold the last latency's worth of (quiet) input and keep running.
+    void settleToSilence()
+    {
+        hotState.clearState();
+    }
 
-        oversamplingAndSafety.setPeakAbs(peakAbs);
+    // Idle block: input passed through, delayed by the tier latency
+    void processIdle (Buffer& buffer)
+    {
+        if constexpr (Traits::lookaheadMs > 0.0)
+            lookahead.process(buffer);
+        if (outputStagesEnabled)
+            oversamplingAndSafety.processIdle(buffer);
+    }
+
+    void resetIdle()
+    {
+        idle = false;
+        outputQuiet = false;
+        quietSamples = 0;
+    }
+
+    static double attackNormToMs (double a)
+    {
+        if (!std::isfinite(a)) a = 0.0;
+        if (a < 0.0) a = 0.0;
+        if (a > 1.0) a = 1.0;
+        const double aCurve = a * a * (3.0 - 2.0 * a);
+        return 0.10 + (30.0 - 0.10) * aCurve;
+    }
+
+    // Phase 6: compile-time stage list in topology order (prepare / reset / process fold over it; see StageList.h)
+    auto stages()
+    {
+        return std::tie(inputConditioning, detectorSplit, detectorCore, lowEndGuard, hybridEnvelopeEngine,
+                        dualStageRelease, gainComputer, stereoLink, lookahead, gainReductionStage, transientGuard,
+                        parallelMixer, outputStage, oversamplingAndSafety);
+    }
 
-        oversamplingAndSafety.process(buffer);
+    // Phase 6: link groups + per-channel control lanes (preallocated with the pipeline)
+    LinkGroupMap linkGroups = LinkGroupMap::allLinked(2);
+    StereoMode stereoMode = StereoMode::leftRight;
+    bool outputStagesEnabled = true;
+    int maxBlock = 512; // prepared block size (process() chunks longer blocks)
+    ControlLanes envLanes;
+    ControlLanes grLanes;
+
+    // Phase 6: multirate control state (decimation factor, position in the current D-sample segment;
+    // per-lane segment endpoints live in the hot-state block)
+    static constexpr int kMaxControlDecimation = 4;
+    bool multirateControl = Traits::multirateControl;
+    int controlDecimation = 1;
+    int controlPhase = 0;
+
+    // Phase 6: idle fast path state
+    bool idle = false;
+    bool outputQuiet = false; // last processed block's output at or below kIdleFloor
+    int quietSamples = 0;     // quiet input samples processed so far (capped at idleHoldSamples)
+    int idleHoldSamples = kControlTileSize;
+
+    // Phase 6: per-sample state of every stage (filter memories, envelopes), one cache-aligned block.
+    // Pipeline rows, one value per lane: GR at the end of the previous tile (tile-rate ramp start) and the
+    // current multirate segment's endpoints.
+    enum { kLastGrRow, kCtrlGrFromRow, kCtrlGrToRow, kNumGrRows };
+    HotStateBlock hotState;
+    int grStateOffset = 0;
+
+    double* grStateRow (int row) { return hotState.get<double> (grStateOffset) + row * hotState.getNumChannels(); }
+
+    // Phase 6: buffer arena (the instance's, or localArena for a standalone pipeline)
+    DspArena localArena;
+    DspArena* arena = nullptr;
+
+    void attachArena (DspArena& a)
+    {
+        arena = &a;
+        detectorCore.setArena(a);
+        lookahead.setArena(a, "lookahead");
+        oversamplingAndSafety.setArena(a);
     }
+    int degradationLevel = CpuGovernor::kFull;
+
+    // Cross-block control state (per instance)
+    double smoothedRatioBias = 0.0; // Phase 4B.2 ratio softening (τ = 10 ms, SmootherBank slot)
+    Latched latched;                // Phase 6: later stages' outputs for earlier stages, next block
+    SmootherBank smoothers;         // Phase 6: block-rate control smoothers of every stage
+    int ratioBiasSlot = SmootherBank::kScratchSlot;
 
     InputConditioning      inputConditioning;
-    DetectorSplit          detectorSplit;
-    DetectorCore           detectorCore;
+    DetectorSplit<SampleType> detectorSplit;
+    DetectorCore<SampleType>  detectorCore;
     LowEndGuard           lowEndGuard;
         TransientGuard      transientGuard;
     
         DualStageRelease   dualStageRelease;
 HybridEnvelopeEngine   hybridEnvelopeEngine;
     GainComputer           gainComputer;
-        GainReductionStage     gainReductionStage;
+    LookaheadDelay<SampleType> lookahead;
+        GainReductionStage<SampleType> gainReductionStage;
     ParallelMixer          parallelMixer;
-    StereoLink             stereoLink;
-    OutputStage            outputStage;
-    OversamplingAndSafety  oversamplingAndSafety;
+    StereoLink<SampleType> stereoLink;
+    OutputStage<SampleType> outputStage;
+    OversamplingAndSafety<SampleType> oversamplingAndSafety;
 };
@@ -0,0 +1,138 @@
+// Phase 6 — CpuGovernor (real-time budget watchdog, audio thread)
+// Measures each block's wall time against its real-time budget (numSamples / sampleRate) with
+// steady_clock and sheds optional work, one level at a time, under sustained pressure:
+//
+//   kFull                  everything the tier provides
+//   kShedOversampling      oversampled safety stage faded out (30 ms ramp; latency kept by a delay)
+//   kShedTruePeak          + detector true-peak estimate faded out (30 ms blend to sample peak)
+//   kShedPerSampleControl  + envelope / GR at tile rate (GR ramped across each tile, continuous)
+//
+// Hysteresis: shed when the smoothed load stays above kShedLoad for kShedHoldSec; restore when it stays
+// below kRestoreLoad for the restore hold, which doubles (up to kMaxRestoreHoldSec) whenever a restore is
+// followed by a re-shed within kFlapWindowSec. Every change waits kSettleSec before the next decision.
+// Disabled (level pinned at kFull) for offline renders. No allocation.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+struct CpuGovernor
+{
+    using Clock = std::chrono::steady_clock;
+
+    enum Level : int
+    {
+        kFull = 0,
+        kShedOversampling,
+        kShedTruePeak,
+        kShedPerSampleControl,
+        kMaxLevel = kShedPerSampleControl
+    };
+
+    // Sealed policy (fractions of the block's real-time budget / seconds)
+    static constexpr double kShedLoad          = 0.35;
+    static constexpr double kRestoreLoad       = 0.15;
+    static constexpr double kLoadTauSec        = 0.100;
+    static constexpr double kShedHoldSec       = 0.250;
+    static constexpr double kRestoreHoldSec    = 2.0;
+    static constexpr double kMaxRestoreHoldSec = 30.0;
+    static constexpr double kFlapWindowSec     = 5.0;
+    static constexpr double kSettleSec         = 0.250;
+
+    void prepare (double sampleRate)
+    {
+        fs = (std::isfinite(sampleRate) && sampleRate > 0.0 ? sampleRate : 48000.0);
+        reset();
+    }
+
+    void reset()
+    {
+        loadSmoothed = 0.0;
+        overSec = underSec = 0.0;
+        sinceChangeSec = kSettleSec;
+        sinceRestoreSec = kFlapWindowSec;
+        restoreHoldSec = kRestoreHoldSec;
+        level.store(kFull, std::memory_order_relaxed);
+        load.store(0.0f, std::memory_order_relaxed);
+    }
+
+    // false = offline render: never shed (level returns to kFull immediately)
+    void setEnabled (bool shouldGovern)
+    {
+        enabled = shouldGovern;
+        if (!enabled)
+            reset();
+    }
+
+    static Clock::time_point now() noexcept { return Clock::now(); }
+
+    // Once per processBlock, after the work being measured
+    void endBlock (Clock::time_point blockStart, int numSamples)
+    {
+        if (!enabled || numSamples <= 0)
+            return;
+
+        const double blockSec   = (double) numSamples / fs;
+        const double elapsedSec = std::chrono::duration<double> (Clock::now() - blockStart).count();
+        const double blockLoad  = elapsedSec / blockSec;
+        if (!std::isfinite(blockLoad))
+            return;
+
+        const double a = std::exp(-blockSec / kLoadTauSec);
+        loadSmoothed = a * loadSmoothed + (1.0 - a) * blockLoad;
+        load.store((float) loadSmoothed, std::memory_order_relaxed);
+
+        sinceChangeSec  += blockSec;
+        sinceRestoreSec += blockSec;
+        overSec  = (loadSmoothed > kShedLoad    ? overSec + blockSec  : 0.0);
+        underSec = (loadSmoothed < kRestoreLoad ? underSec + blockSec : 0.0);
+        if (sinceChangeSec < kSettleSec)
+            return;
+
+        const int current = level.load(std::memory_order_relaxed);
+        if (current < kMaxLevel && overSec >= kShedHoldSec)
+        {
+            // Re-shedding shortly after a restore: that restore was premature, wait longer next time
+            if (sinceRestoreSec < kFlapWindowSec)
+                restoreHoldSec = std::min(2.0 * restoreHoldSec, kMaxRestoreHoldSec);
+            changeLevel(current + 1);
+        }
+        else if (current > kFull && underSec >= restoreHoldSec)
+        {
+            changeLevel(current - 1);
+            sinceRestoreSec = 0.0;
+        }
+        else if (current == kFull && sinceRestoreSec >= kFlapWindowSec)
+        {
+            restoreHoldSec = kRestoreHoldSec;
+        }
+    }
+
+    // Telemetry (any thread)
+    int getLevel() const noexcept     { return level.load(std::memory_order_relaxed); }
+    float getLoad() const noexcept    { return load.load(std::memory_order_relaxed); }
+
+private:
+    void changeLevel (int newLevel)
+    {
+        level.store(newLevel, std::memory_order_relaxed);
+        sinceChangeSec = 0.0;
+        overSec = underSec = 0.0;
+    }
+
+    double fs = 48000.0;
+    bool enabled = true;
+
+    double loadSmoothed = 0.0;
+    double overSec = 0.0;
+    double underSec = 0.0;
+    double sinceChangeSec = kSettleSec;
+    double sinceRestoreSec = kFlapWindowSec;
+    double restoreHoldSec = kRestoreHoldSec;
+
+    std::atomic<int>   level { kFull };
+    std::atomic<float> load { 0.0f };
+};
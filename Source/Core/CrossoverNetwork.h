@@ -0,0 +1,218 @@
+// Phase 6 — CrossoverNetwork (multiband split)
+// Linkwitz-Riley 4th-order crossovers (two cascaded Butterworth biquads per LP/HP), 2..4 bands.
+// No parameters. No allocation after prepare().
+//
+// Topology (serial split, phase compensated):
+//   x -> [X0] -> band 0 | rest -> [X1] -> band 1 | rest -> [X2] -> band 2 | band 3
+//   Each lower band also passes the 2nd-order allpass of every later crossover, so all bands share the
+//   same phase response and the band sum is flat (an allpass of the input).
+//
+// Layout:
+// - State is structure-of-arrays in the owner's HotStateBlock: z1 and z2 rows per biquad, channel-packed at the
+//   prepared channel count. Work tiles are sample-major (tile[i * kMaxChannels + ch]) so every biquad's inner
+//   loop runs across channels with shared coefficients.
+// - Crossover frequencies are smoothed once per block (τ = 20 ms, owner's SmootherBank) and redesigned only
+//   when they move.
+// - Templated on the sample type: designs are computed in double, tiles and state are SampleType.
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "ChannelGroups.h"
+#include "HotStateBlock.h"
+#include "SidechainFilterBank.h"
+#include "SmootherBank.h"
+#include "../Util/DenormalGuard.h"
+
+template <typename SampleType>
+struct CrossoverNetwork
+{
+    static constexpr int kMaxBands      = 4;
+    static constexpr int kMaxCrossovers = kMaxBands - 1;
+    static constexpr int kMaxChannels   = ChannelGroups::kMaxChannels;
+    static constexpr int kTileSize      = ChannelGroups::kTileSize;
+
+    void prepare (double sampleRate)
+    {
+        fs = (sampleRate > 0.0 ? sampleRate : 48000.0);
+        stride = hot->getNumChannels();
+        stateOffset = hot->reserve<SampleType> (2 * kNumBiquads * stride);
+        hzSlot = smoothers->add(0.020, 0.0, kMaxCrossovers);
+        for (int x = 0; x < kMaxCrossovers; ++x)
+        {
+            smoothedHz[x] = targetHz[x];
+            smoothers->set(hzSlot + x, smoothedHz[x]);
+        }
+        redesign(true);
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill_n(hot->get<SampleType> (stateOffset), 2 * kNumBiquads * stride, (SampleType) 0);
+    }
+
+    // ----------------------------
+    // Injection slots (NOT parameters)
+    // ----------------------------
+    void setNumBands (int n) { numBands = juce::jlimit(2, kMaxBands, n); }
+
+    // Crossover x (0 = lowest). Kept ascending at design time with a 1/3-octave minimum spacing.
+    void setCrossoverHz (int x, double hz)
+    {
+        if (x >= 0 && x < kMaxCrossovers && std::isfinite(hz) && hz > 0.0)
+            targetHz[x] = hz;
+    }
+
+    // Owner's smoother bank (not owned). Attach before prepare(); the frequency slots are added there.
+    void setSmootherBank (SmootherBank& bank) { smoothers = &bank; }
+
+    // Owner's hot-state block (not owned). Attach before prepare(); the biquad memories are reserved there.
+    void setHotState (HotStateBlock& block) { hot = &block; }
+
+    int getNumBands() const              { return numBands; }
+    double getCrossoverHz (int x) const  { return smoothedHz[x]; }
+
+    // Splits numCh planar channels of in (numSamples) into numBands planar band buffers (up to the prepared
+    // channel count).
+    void process (const juce::AudioBuffer<SampleType>& in, juce::AudioBuffer<SampleType>* bands)
+    {
+        const int numCh = juce::jmin(in.getNumChannels(), stride);
+        const int numS  = in.getNumSamples();
+        if (numCh <= 0 || numS <= 0)
+            return;
+
+        // Block-rate frequency smoothing (τ = 20 ms; owner's SmootherBank)
+        for (int x = 0; x < kMaxCrossovers; ++x)
+            smoothers->setTarget(hzSlot + x, targetHz[x]);
+        smoothers->step(hzSlot, kMaxCrossovers);
+        for (int x = 0; x < kMaxCrossovers; ++x)
+            smoothedHz[x] = smoothers->get(hzSlot + x);
+        redesign(false);
+
+        const int numX = numBands - 1;
+        SampleType rest[kTileSize * kMaxChannels];
+        SampleType band[kTileSize * kMaxChannels];
+
+        for (int start = 0; start < numS; start += kTileSize)
+        {
+            const int n = juce::jmin(kTileSize, numS - start);
+
+            for (int ch = 0; ch < numCh; ++ch)
+            {
+                const SampleType* x = in.getReadPointer(ch, start);
+                for (int i = 0; i < n; ++i)
+                    rest[i * kMaxChannels + ch] = x[i];
+            }
+
+            for (int x = 0; x < numX; ++x)
+            {
+                // Low side of crossover x -> band x (then allpass of every later crossover)
+                std::copy(rest, rest + n * kMaxChannels, band);
+                runBiquad(lpIndex(x, 0), band, n, numCh);
+                runBiquad(lpIndex(x, 1), band, n, numCh);
+                for (int later = x + 1; later < numX; ++later)
+                    runBiquad(apIndex(x, later), band, n, numCh);
+                scatter(band, bands[x], start, n, numCh);
+
+                // High side continues down the chain
+                runBiquad(hpIndex(x, 0), rest, n, numCh);
+                runBiquad(hpIndex(x, 1), rest, n, numCh);
+            }
+
+            scatter(rest, bands[numX], start, n, numCh);
+        }
+
+        // Phase 6: biquad memories stop at exact zero on a fade-out
+        DenormalGuard::flush(hot->get<SampleType> (stateOffset), 2 * kNumBiquads * stride);
+    }
+
+private:
+    // Biquad slots: per crossover x: LP0, LP1, HP0, HP1; then allpass (band x, crossover later > x)
+    static constexpr int kPerCrossover = 4;
+    static constexpr int kNumAllpass   = kMaxCrossovers * kMaxCrossovers;
+    static constexpr int kNumBiquads   = kMaxCrossovers * kPerCrossover + kNumAllpass;
+
+    static int lpIndex (int x, int k)          { return x * kPerCrossover + k; }
+    static int hpIndex (int x, int k)          { return x * kPerCrossover + 2 + k; }
+    static int apIndex (int bandX, int later)  { return kMaxCrossovers * kPerCrossover + bandX * kMaxCrossovers + later; }
+
+    using Coeffs = BiquadCoeffs;
+
+    void redesign (bool force)
+    {
+        // Ascending, 1/3 octave apart, inside (20 Hz .. 0.45 fs)
+        constexpr double kMinSpacing = 1.2599210498948732; // 2^(1/3)
+        double hz[kMaxCrossovers];
+        double lo = 20.0;
+        for (int x = 0; x < kMaxCrossovers; ++x)
+        {
+            hz[x] = juce::jlimit(lo, 0.45 * fs, smoothedHz[x]);
+            lo = hz[x] * kMinSpacing;
+        }
+
+        for (int x = 0; x < kMaxCrossovers; ++x)
+        {
+            if (!force && std::abs(hz[x] - designedHz[x]) <= 1e-4 * designedHz[x])
+                continue;
+
+            designedHz[x] = hz[x];
+            coeffs[lpIndex(x, 0)] = coeffs[lpIndex(x, 1)] = Coeffs::lowPass(hz[x], kButterworthQ, fs);
+            coeffs[hpIndex(x, 0)] = coeffs[hpIndex(x, 1)] = Coeffs::highPass(hz[x], kButterworthQ, fs);
+            for (int bandX = 0; bandX < x; ++bandX)
+                coeffs[apIndex(bandX, x)] = Coeffs::allPass(hz[x], kButterworthQ, fs);
+        }
+    }
+
+    // TDF-II biquad over a sample-major tile; the channel loop shares coefficients (vectorizes over channels).
+    void runBiquad (int b, SampleType* tile, int n, int numCh)
+    {
+        const SampleType b0 = (SampleType) coeffs[b].b0, b1 = (SampleType) coeffs[b].b1, b2 = (SampleType) coeffs[b].b2;
+        const SampleType a1 = (SampleType) coeffs[b].a1, a2 = (SampleType) coeffs[b].a2;
+        SampleType* z1 = hot->get<SampleType> (stateOffset) + 2 * b * stride;
+        SampleType* z2 = z1 + stride;
+        for (int i = 0; i < n; ++i)
+        {
+            SampleType* v0 = tile + i * kMaxChannels;
+            for (int ch = 0; ch < numCh; ++ch)
+            {
+                const SampleType x = v0[ch];
+                const SampleType y = b0 * x + z1[ch];
+                z1[ch] = b1 * x - a1 * y + z2[ch];
+                z2[ch] = b2 * x - a2 * y;
+                v0[ch] = y;
+            }
+        }
+    }
+
+    static void scatter (const SampleType* tile, juce::AudioBuffer<SampleType>& dest, int start, int n, int numCh)
+    {
+        for (int ch = 0; ch < numCh; ++ch)
+        {
+            SampleType* y = dest.getWritePointer(ch, start);
+            for (int i = 0; i < n; ++i)
+                y[i] = tile[i * kMaxChannels + ch];
+        }
+    }
+
+    static constexpr double kButterworthQ = 0.70710678118654752;
+
+    double fs = 48000.0;
+    int numBands = 3;
+
+    double targetHz[kMaxCrossovers]   { 120.0, 1000.0, 6000.0 };
+    double smoothedHz[kMaxCrossovers] { 120.0, 1000.0, 6000.0 };
+    SmootherBank* smoothers = nullptr;
+    int hzSlot = SmootherBank::kScratchSlot;
+    double designedHz[kMaxCrossovers] { 0.0, 0.0, 0.0 };
+
+    Coeffs coeffs[kNumBiquads];
+
+    // SoA state in the owner's HotStateBlock: rows z1, z2 per biquad
+    HotStateBlock* hot = nullptr;
+    int stateOffset = 0;
+    int stride = 0; // channels per row (0 until prepared)
+};
@@ -1,27 +1,63 @@
-// Phase 1 Skeleton (NO-OP): structural placeholder only.
-// No DSP math. No parameters. No UI logic.
-// Must remain transparent pass-through.
+// Phase 2 DetectorCore
+// Phase 6: sidechain detector (measurement path only; audio untouched).
+// - SidechainFilterBank: biquad cascade (dynamic HPF / tilt / emphasis) + 120 Hz low-band tap per channel,
+//   optional M/S encode and multirate decimation
+// - per channel peak + RMS (true peak on the 4x interpolated signal in Mastering), folded into link groups
+//   (group peak = loudest member, group RMS over the members) and blended α*peak + β*rms + γ*transient by the
+//   smoothed attack (A); per channel detections use the same law
+// - per-tile lanes (held peak, mean-square one-pole) for the envelopes, independent of the host block size
+// - low-end dominance (low-band RMS / total RMS) for LowEndGuard
+// No parameters. No UI.
 
 #pragma once
 #include <JuceHeader.h>
 
-#include <vector>
-struct DetectorCore
-{
-    void prepare (double sr, int)
-    {
-        sampleRate = (sr > 0.0 ? sr : 48000.0);
+#include <algorithm>
 
-        // Smoothing constants from DSP & Math Constitution:
-        // A smoothing τ = 250 µs
-        setOnePoleTimeConstantSeconds(aSmoother, 250e-6);
+#include "ChannelGroups.h"
+#include "DspArena.h"
+#include "DspKernels.h"
+#include "FastMath.h"
+#include "HotStateBlock.h"
+#include "SidechainFilterBank.h"
+#include "SmootherBank.h"
+#include "TruePeakDetector.h"
 
+template <typename SampleType>
+struct DetectorCore
+{
+    using FilterBank = SidechainFilterBank<SampleType>;
 
-        // Detector-only HPF cutoff smoothing (sealed): τ = 2 ms
-        setOnePoleTimeConstantSeconds(hpfCutoffSmoother, 2e-3);
+    // Phase 6: detection is also published per tile of this many samples (see getTileGroupDetectorLinear)
+    static constexpr int kTileSize = FilterBank::kMaxTileSize;
 
-        // Low-end dominance smoothing (sealed for Phase 4C.1): τ = 30 ms
-        setOnePoleTimeConstantSeconds(dominanceSmoother, 0.030);
+    void prepare (double sr, int maxBlockSize)
+    {
+        sampleRate = (sr > 0.0 ? sr : 48000.0);
+        numMeasChannels = hot->getNumChannels();
+
+        // Phase 6: per-tile detection. Hot state: held tile peak and mean-square one-pole per channel;
+        // arena: the block's tile lanes (group detections, then channel detections, per tile)
+        tileStateOffset = hot->reserve<double> (kNumTileStateRows * juce::jmax(1, numMeasChannels));
+        laneStride = juce::jmax(1, numMeasChannels);
+        maxTiles = juce::jmax(1, (maxBlockSize + kTileSize - 1) / kTileSize);
+        tileLanesOffset = arena->reserve<double> (maxTiles * 2 * laneStride, "detector tile lanes");
+        msTileCoeff = 1.0 - std::exp(-(double) kTileSize / (kRmsTauSec * sampleRate));
+
+        // Smoothing constants from DSP & Math Constitution (Phase 6: slots in the owner's SmootherBank):
+        // A smoothing τ = 250 µs, low-end dominance τ = 30 ms (sealed for Phase 4C.1)
+        smootherSlot = smoothers->add(250e-6);
+        smoothers->add(0.030);
+
+
+        // Detector-only HPF cutoff smoothing (sealed): τ = 2 ms (stepped once per filter tile)
+        hpfCutoffTileCoeff = 1.0 - std::exp(-(double) kFilterTileSize / (2e-3 * sampleRate));
+
+        // Sidechain biquad bank (HPF / tilt / emphasis + 120 Hz low-band tap)
+        filterBank.prepare(sampleRate, (truePeak ? 1 : decimation)); // inter-sample peaks need the full rate
+        truePeakDetector.prepare();
+        kernels = &DspKernels::getActive<SampleType>();
+        truePeakMixTileStep = (double) kFilterTileSize / (0.030 * sampleRate); // governor blend: 30 ms linear
         reset();
     }
 
@@ -32,88 +68,174 @@ struct DetectorCore
         transientLin = 0.0;
 
         detectorLin = 0.0;
+        clearGroupReadouts();
+        if (numMeasChannels > 0)
+            std::fill_n(hot->get<double> (tileStateOffset), kNumTileStateRows * numMeasChannels, 0.0);
 
         attackNormTarget = 0.0;
         attackNormSmoothed = 0.0;
+        smoothers->set(smootherSlot + kAttackSmoother, 0.0);
 
         // Detector-only HPF (measurement path only) — disabled by default
         detectorHpfCutoffHzTarget   = 0.0;   // 0 = disabled
         detectorHpfCutoffHzSmoothed = 0.0;
-        hpfCutoffSmoother.reset(0.0);
-        for (auto& z : hpfLpState) z = 0.0;
+        filterBank.setHighPassHz(0.0);
+        filterBank.reset();
+        truePeakDetector.reset();
+        truePeakMix = (truePeak && !truePeakShed ? 1.0 : 0.0);
 
         // Low-end dominance (detector-only measurement)
         lowEndDominance01 = 0.0;
-        dominanceSmoother.reset(0.0);
-        for (auto& z : lowLpState) z = 0.0;
+        smoothers->set(smootherSlot + kDominanceSmoother, 0.0);
     }
 
     // Phase 2: Peak/RMS + detector blend math (α/β/γ) is implemented.
     // Transient detector *definition* is not in the provided constitutions; transientLin remains an injected slot for now.
-    void process (juce::AudioBuffer<float>& buffer)
+    // buffer = detector source (main input or sidechain key, see DetectorSplit); read-only.
+    // Phase 6: block readouts (peak / RMS over the block; they drive the block-rate laws) plus per-tile lanes
+    // for the envelopes: each tile's peak and a mean-square one-pole (τ = kRmsTauSec) stepped per tile, so the
+    // envelope input does not depend on the host block size. Blocks up to the prepared size.
+    void process (const juce::AudioBuffer<SampleType>& buffer)
     {
         const int numCh = buffer.getNumChannels();
         const int numS  = buffer.getNumSamples();
-        if (numCh <= 0 || numS <= 0)
+        if (numCh <= 0 || numS <= 0 || numMeasChannels <= 0)
         {
             peakLin = rmsLin = detectorLin = 0.0;
+            clearGroupReadouts();
+            if (numMeasChannels > 0)
+                std::fill_n(arena->get<double> (tileLanesOffset), maxTiles * 2 * laneStride, 0.0);
             return;
         }
 
 
-        // Detector-only HPF: affects measurement only (no audio-path change)
-        if ((int)hpfLpState.size() < numCh)
-            hpfLpState.resize((size_t)numCh, 0.0);
+        // Detector-only filter bank: affects measurement only (no audio-path change)
+        const SampleType* const* in = buffer.getArrayOfReadPointers();
+        const int measCh = juce::jmin(numCh, numMeasChannels);
 
-        // Low-end dominance LP state (measurement path only)
-        if ((int)lowLpState.size() < numCh)
-            lowLpState.resize((size_t)numCh, 0.0);
+        // Per-channel peak + sum of squares over the block (linear domain, SoA across channels);
+        // folded into link groups afterwards.
+        double chPeak[kMaxChannels] {};
+        long double chSumSq[kMaxChannels] {};
 
-        // Smooth cutoff (Hz). 0 => disabled.
-        detectorHpfCutoffHzSmoothed = hpfCutoffSmoother.process(detectorHpfCutoffHzTarget);
-        const double fc = detectorHpfCutoffHzSmoothed;
-        const bool hpfEnabled = (std::isfinite(fc) && fc > 0.0);
-        const double fs = (sampleRate > 0.0 ? sampleRate : 48000.0);
-        const double gHpf = hpfEnabled ? (1.0 - std::exp(-2.0 * juce::MathConstants<double>::pi * fc / fs)) : 0.0;
-        // Compute peak + RMS over the block (linear domain), across all channels.
-        double peak = 0.0;
-        long double sumSq = 0.0L;
-        const long double invN = 1.0L / (long double)(numCh * numS);
-
-        // Low-end dominance measurement (detector-only): one-pole LP @ 120 Hz on measurement signal
+        // Low-end dominance measurement (detector-only): 120 Hz low-band tap of the filtered measurement signal
         long double sumSqLow = 0.0L;
-        constexpr double kLowFcHz = 120.0;
-        const double gLow = 1.0 - std::exp(-2.0 * juce::MathConstants<double>::pi * kLowFcHz / fs);
 
-                for (int ch = 0; ch < numCh; ++ch)
+        // Zeroed: the statistics kernel reads whole column groups (columns past measCh must be finite)
+        alignas(64) SampleType y[FilterBank::kMaxTileSize * FilterBank::kMaxChannels] {};
+        alignas(64) SampleType low[FilterBank::kMaxTileSize * FilterBank::kMaxChannels] {};
+
+        // Phase 6: tile state rows (held peak, mean square) and this block's tile lanes
+        double* const heldPeak = hot->get<double> (tileStateOffset);
+        double* const meanSq   = heldPeak + numMeasChannels;
+        jassert(numS <= maxTiles * kTileSize); // owners chunk to the prepared block size (CompressorPipeline::process)
+        const int numTiles = juce::jmin(maxTiles, (numS + kTileSize - 1) / kTileSize);
+
+        int numMeas = 0; // measured samples (numS / decimation in multirate mode)
+        for (int start = 0; start < numS; start += kFilterTileSize)
         {
-            const float* x = buffer.getReadPointer(ch);
-            double lp = hpfLpState[(size_t)ch];
-            double lowLp = lowLpState[(size_t)ch];
-            for (int i = 0; i < numS; ++i)
-            {
-                const double v = (double) x[i];
+            const int len = juce::jmin(kFilterTileSize, numS - start);
+            const int tile = start / kFilterTileSize;
+
+            // Smooth cutoff (Hz) per tile. 0 => disabled (identity HPF).
+            detectorHpfCutoffHzSmoothed += hpfCutoffTileCoeff * (detectorHpfCutoffHzTarget - detectorHpfCutoffHzSmoothed);
+            if (detectorHpfCutoffHzTarget <= 0.0 && detectorHpfCutoffHzSmoothed < 1.0)
+                detectorHpfCutoffHzSmoothed = 0.0;
+            filterBank.setHighPassHz(detectorHpfCutoffHzSmoothed);
 
-                // Measurement signal: optional HPF (y = x - lp)
-                if (hpfEnabled)
+            const int m = filterBank.processTile(in, measCh, start, len, y, low); // len, or decimated count
+            if (m <= 0)
+            {
+                storeTileStats(tile, numTiles, heldPeak, meanSq); // nothing measured: the tile holds
+                continue;
+            }
+            numMeas += m;
+
+            // Tile sums in SampleType (<= 64 samples, per channel, dispatched kernel); block totals widen
+            // once per tile
+            SampleType tilePeak[kMaxChannels] {};
+            SampleType tileSumSq[kMaxChannels] {};
+            SampleType tileSumSqLowCh[kMaxChannels] {};
+            kernels->tileStats(y, low, m, measCh, tilePeak, tileSumSq, tileSumSqLowCh);
+            SampleType tileSumSqLow = 0;
+            for (int ch = 0; ch < measCh; ++ch)
+                tileSumSqLow += tileSumSqLowCh[ch];
+            // Phase 6 (Mastering tier): inter-sample peaks of the filtered measurement signal,
+            // blended toward the sample peak while the CPU governor sheds them
+            if (truePeak)
+            {
+                const double mixTarget = (truePeakShed ? 0.0 : 1.0);
+                if (truePeakMix <= 0.0 && mixTarget > 0.0)
+                    truePeakDetector.reset(); // history is stale after a shed
+                truePeakMix = (mixTarget > truePeakMix ? juce::jmin(mixTarget, truePeakMix + truePeakMixTileStep)
+                                                       : juce::jmax(mixTarget, truePeakMix - truePeakMixTileStep));
+                if (truePeakMix > 0.0)
                 {
-                    lp += gHpf * (v - lp);
+                    SampleType tp[kMaxChannels];
+                    std::copy(tilePeak, tilePeak + measCh, tp);
+                    truePeakDetector.processTile(y, FilterBank::kMaxChannels, measCh, m, tp);
+                    const SampleType w = (SampleType) truePeakMix;
+                    for (int ch = 0; ch < measCh; ++ch)
+                        tilePeak[ch] += w * (tp[ch] - tilePeak[ch]);
                 }
-                const double y = hpfEnabled ? (v - lp) : v;
-
-                // Low-end band proxy (measurement only): one-pole low-pass of y
-                lowLp += gLow * (y - lowLp);
-                sumSqLow += (long double)lowLp * (long double)lowLp;
+            }
+            for (int ch = 0; ch < measCh; ++ch)
+            {
+                chPeak[ch]   = ((double) tilePeak[ch] > chPeak[ch] ? (double) tilePeak[ch] : chPeak[ch]);
+                chSumSq[ch] += (long double) tileSumSq[ch];
+            }
+            sumSqLow += (long double) tileSumSqLow;
 
-                const double a = std::abs(y);
-                if (a > peak) peak = a;
-                sumSq += (long double)y * (long double)y;
+            // Tile lanes: this tile's peak; mean square stepped by the tile's duration
+            const double msCoeff = (len == kTileSize ? msTileCoeff
+                                                     : 1.0 - std::exp(-(double) len / (kRmsTauSec * sampleRate)));
+            for (int ch = 0; ch < measCh; ++ch)
+            {
+                heldPeak[ch] = (double) tilePeak[ch];
+                meanSq[ch] += msCoeff * ((double) tileSumSq[ch] / (double) m - meanSq[ch]);
             }
-            hpfLpState[(size_t)ch] = lp;
-            lowLpState[(size_t)ch] = lowLp;
+            storeTileStats(tile, numTiles, heldPeak, meanSq);
         }
 
-        peakLin = peak;
+        // Multirate mode: a block shorter than the decimation factor may hold no measured sample (keep readouts;
+        // the tile lanes hold the last measured tile)
+        if (numMeas <= 0)
+        {
+            double alpha, beta, gamma;
+            blendCoefficients(clamp01(attackNormSmoothed), alpha, beta, gamma);
+            foldTileLanes(numTiles, measCh, alpha, beta, gamma);
+            return;
+        }
+
+        // Fold channels into link groups. An external key (groupedMeasurement == false) is measured as
+        // one signal and drives every group.
+        const int numGroups = linkGroups.getNumGroups();
+        double gPeak[ChannelGroups::kMaxGroups] {};
+        long double gSumSq[ChannelGroups::kMaxGroups] {};
+        int gCount[ChannelGroups::kMaxGroups] {};
+        long double sumSq = 0.0L;
+        for (int ch = 0; ch < measCh; ++ch)
+        {
+            const int g = (groupedMeasurement ? linkGroups.getGroup(ch) : 0);
+            gPeak[g] = (chPeak[ch] > gPeak[g] ? chPeak[ch] : gPeak[g]);
+            gSumSq[g] += chSumSq[ch];
+            ++gCount[g];
+            sumSq += chSumSq[ch];
+        }
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            const int src = (groupedMeasurement ? g : 0);
+            groupPeakLin[g] = gPeak[src];
+            groupRmsLin[g]  = (gCount[src] > 0 ? std::sqrt((double) (gSumSq[src] / (long double) (gCount[src] * numMeas))) : 0.0);
+        }
+
+        // Scalar readouts: loudest group (identical to the old all-channel values for a single group)
+        peakLin = 0.0;
+        for (int g = 0; g < numGroups; ++g)
+            peakLin = (groupPeakLin[g] > peakLin ? groupPeakLin[g] : peakLin);
+
+        const long double invN = 1.0L / (long double)(measCh * numMeas);
         rmsLin  = std::sqrt((double)(sumSq * invN));
 
         // Low-end dominance01 (detector-only): ratio of low-band RMS to total RMS, shaped by pow(·, 0.7)
@@ -123,31 +245,58 @@ struct DetectorCore
         double ratio = lowRms / std::max(totalRms, kEps);
         if (!std::isfinite(ratio)) ratio = 0.0;
         ratio = clamp01(ratio);
-        double domRaw = std::pow(ratio, 0.7);
+        double domRaw = FastMath::pow(ratio, 0.7);
         if (!std::isfinite(domRaw)) domRaw = 0.0;
         domRaw = clamp01(domRaw);
 
-        lowEndDominance01 = dominanceSmoother.process(domRaw);
+        // Both smoothers step together once the dominance target is known
+        smoothers->setTarget(smootherSlot + kDominanceSmoother, domRaw);
+        smoothers->setTarget(smootherSlot + kAttackSmoother, clamp01(attackNormTarget));
+        smoothers->step(smootherSlot, kNumSmoothers);
+
+        lowEndDominance01 = smoothers->get(smootherSlot + kDominanceSmoother);
         if (!std::isfinite(lowEndDominance01)) lowEndDominance01 = 0.0;
         lowEndDominance01 = clamp01(lowEndDominance01);
 
         // A = attack_normalized ∈ [0,1], one-pole smoothed τ = 250 µs
-        attackNormSmoothed = aSmoother.process(clamp01(attackNormTarget));
+        attackNormSmoothed = smoothers->get(smootherSlot + kAttackSmoother);
 
         const double A = clamp01(attackNormSmoothed);
 
         // Detector blend coefficients (exact, from DSP & Math Constitution)
-        const double alpha = 0.40 + 0.20 * (A * A);
-        const double beta  = 0.60 - 0.25 * A;
-        const double gamma = 0.10 + 0.35 * (1.0 - A);
+        double alpha, beta, gamma;
+        blendCoefficients(A, alpha, beta, gamma);
 
-        // detector = α*peak + β*rms + γ*transient
+        // detector = α*peak + β*rms + γ*transient (per link group)
         // NOTE: transientLin is currently an injected slot pending an explicit transient detector definition.
-        detectorLin = alpha * peakLin + beta * rmsLin + gamma * transientLin;
+        detectorLin = 0.0;
+        for (int g = 0; g < numGroups; ++g)
+        {
+            double d = alpha * groupPeakLin[g] + beta * groupRmsLin[g] + gamma * transientLin;
+
+            // Safety: prevent NaNs/Infs from propagating
+            if (!std::isfinite(d) || d < 0.0)
+                d = 0.0;
+
+            groupDetectorLin[g] = d;
+            detectorLin = (d > detectorLin ? d : detectorLin);
+        }
+
+        // Phase 6: independent per-channel detection (same blend law). An external key has no per-channel
+        // meaning for the main bus, so every channel sees its group's (shared key) detection.
+        const int numMainCh = linkGroups.getNumChannels();
+        for (int ch = 0; ch < numMainCh; ++ch)
+        {
+            double d = 0.0;
+            if (!groupedMeasurement)
+                d = groupDetectorLin[linkGroups.getGroup(ch)];
+            else if (ch < measCh)
+                d = alpha * chPeak[ch] + beta * std::sqrt((double) (chSumSq[ch] / (long double) numMeas)) + gamma * transientLin;
+
+            channelDetectorLin[ch] = (std::isfinite(d) && d > 0.0) ? d : 0.0;
+        }
 
-        // Safety: prevent NaNs/Infs from propagating
-        if (!std::isfinite(detectorLin) || detectorLin < 0.0)
-            detectorLin = 0.0;
+        foldTileLanes(numTiles, measCh, alpha, beta, gamma);
     }
 
     // ----------------------------
@@ -174,6 +323,46 @@ struct DetectorCore
         const double clamped = juce::jlimit(1.0, 20000.0, hz);
         detectorHpfCutoffHzTarget = clamped;
     }
+    // Detector-only tilt (low-shelf) and band emphasis (peak). 0 dB = neutral (stage skipped).
+    // Injected control feeds (NOT parameters); applied from the next filter tile.
+    void setDetectorTilt (double hz, double gainDb)                 { filterBank.setLowShelf(hz, gainDb); }
+    void setDetectorEmphasis (double hz, double q, double gainDb)   { filterBank.setBandPeak(hz, q, gainDb); }
+
+    // Phase 6: link groups (channel -> group). Call from prepare/suspended context, not per block.
+    void setLinkGroups (const LinkGroupMap& map) { linkGroups = map; }
+
+    // Phase 6: multirate control (1, 2 or 4; call before prepare). The sidechain filter bank decimates the
+    // measurement signal and runs at sampleRate / factor; ignored in true-peak mode.
+    void setControlDecimation (int factor) { decimation = factor; }
+
+    // Phase 6: owner's smoother bank (not owned). Attach before prepare(); slots are added there.
+    void setSmootherBank (SmootherBank& bank) { smoothers = &bank; }
+
+    // Phase 6: owner's arena (not owned). Attach before prepare(); the tile lanes are reserved there.
+    void setArena (DspArena& owner) { arena = &owner; }
+
+    // Phase 6: owner's hot-state block (not owned). Attach before prepare(); the filter memories and the
+    // true-peak history are reserved there, packed at the block's channel count (channels past it are not
+    // measured).
+    void setHotState (HotStateBlock& block)
+    {
+        filterBank.setHotState(block);
+        truePeakDetector.setHotState(block);
+        hot = &block;
+    }
+
+    // false = detector source is an external key with its own channel layout: measure it as one signal
+    // and feed the result to every link group.
+    void setGroupedMeasurement (bool shouldGroup) { groupedMeasurement = shouldGroup; }
+
+    // Channels 0/1 measured as mid/side (StereoMode::midSide); forwarded to the filter bank's input encode.
+    void setMidSide (bool shouldEncode) { filterBank.setMidSide(shouldEncode); }
+
+    // Peak detection on the 4x interpolated measurement signal (QualityTier::mastering). Prepare-time switch.
+    void setTruePeak (bool shouldUseTruePeak) { truePeak = shouldUseTruePeak; }
+    // Phase 6: CPU governor shed request (block-rate); blends to sample peak over 30 ms and back
+    void setTruePeakShed (bool shouldShed) { truePeakShed = shouldShed; }
+
     // Release normalized (R) placeholder feed for Phase 2+ weighting logic (defined in HybridEnvelopeEngine).
     // Stored here for convenience if you want DetectorCore to be the single "detector state" carrier.
     void setReleaseNormalized (double r)
@@ -202,6 +391,22 @@ struct DetectorCore
     double getTransientLinear() const { return transientLin; }
     double getDetectorLinear() const  { return detectorLin; }
 
+    // Per link group (g < getNumGroups())
+    int getNumGroups() const                  { return linkGroups.getNumGroups(); }
+    double getPeakLinear (int g) const        { return groupPeakLin[g]; }
+    double getRmsLinear (int g) const         { return groupRmsLin[g]; }
+    double getDetectorLinear (int g) const    { return groupDetectorLin[g]; }
+    const double* getGroupDetectorLinear() const { return groupDetectorLin; }
+
+    // Per channel (ch < link map channel count); channels 0/1 are M/S in mid/side mode
+    double getChannelDetectorLinear (int ch) const   { return channelDetectorLin[ch]; }
+    const double* getChannelDetectorLinear() const   { return channelDetectorLin; }
+
+    // Phase 6: per-tile detection of the last block (tile t = samples [t * kTileSize, (t + 1) * kTileSize)),
+    // per link group and per channel, same blend law as the block readouts. Valid after process().
+    const double* getTileGroupDetectorLinear (int tile) const   { return getTileLane(tile); }
+    const double* getTileChannelDetectorLinear (int tile) const { return getTileLane(tile) + laneStride; }
+
     double getLowEndDominance() const { return clamp01(lowEndDominance01); }
 
     double getAttackNormalized() const  { return clamp01(attackNormSmoothed); }
@@ -209,19 +414,83 @@ struct DetectorCore
     double getCrestNormalized() const   { return clamp01(crestNorm); }
 
 private:
-    // One-pole smoother: y[n] = y[n-1] + g * (x - y[n-1])
-    struct OnePole
+    static constexpr int kMaxChannels = FilterBank::kMaxChannels;
+    static_assert(kMaxChannels >= ChannelGroups::kMaxChannels, "filter bank must cover every bus channel");
+
+    void clearGroupReadouts()
+    {
+        for (int g = 0; g < ChannelGroups::kMaxGroups; ++g)
+            groupPeakLin[g] = groupRmsLin[g] = groupDetectorLin[g] = 0.0;
+        for (int ch = 0; ch < ChannelGroups::kMaxChannels; ++ch)
+            channelDetectorLin[ch] = 0.0;
+    }
+
+    // Detector blend coefficients for attack normalized A (exact, from DSP & Math Constitution)
+    static void blendCoefficients (double A, double& alpha, double& beta, double& gamma)
+    {
+        alpha = 0.40 + 0.20 * (A * A);
+        beta  = 0.60 - 0.25 * A;
+        gamma = 0.10 + 0.35 * (1.0 - A);
+    }
+
+    const double* getTileLane (int tile) const
     {
-        void setCoeff(double gIn) { g = gIn; }
-        void reset(double v = 0.0) { z = v; }
-        double process(double x)
+        return arena->get<double> (tileLanesOffset) + juce::jlimit(0, maxTiles - 1, tile) * 2 * laneStride;
+    }
+
+    // Raw tile statistics (held peak, mean square per measured channel) until foldTileLanes() replaces them
+    void storeTileStats (int tile, int numTiles, const double* peak, const double* ms)
+    {
+        if (tile >= numTiles)
+            return;
+        double* const lane = arena->get<double> (tileLanesOffset) + tile * 2 * laneStride;
+        std::copy(peak, peak + numMeasChannels, lane);
+        std::copy(ms, ms + numMeasChannels, lane + laneStride);
+    }
+
+    // Tile statistics -> group and channel detections, in place (same fold and blend as the block readouts)
+    void foldTileLanes (int numTiles, int measCh, double alpha, double beta, double gamma)
+    {
+        const int numGroups = juce::jmin(linkGroups.getNumGroups(), laneStride);
+        const int numMainCh = juce::jmin(linkGroups.getNumChannels(), laneStride);
+        const auto sanitize = [] (double d) { return (std::isfinite(d) && d > 0.0) ? d : 0.0; };
+
+        for (int t = 0; t < numTiles; ++t)
         {
-            z += g * (x - z);
-            return z;
+            double* const lane = arena->get<double> (tileLanesOffset) + t * 2 * laneStride;
+            double peak[kMaxChannels], ms[kMaxChannels];
+            std::copy(lane, lane + measCh, peak);
+            std::copy(lane + laneStride, lane + laneStride + measCh, ms);
+
+            double gPeak[ChannelGroups::kMaxGroups] {};
+            double gMs[ChannelGroups::kMaxGroups] {};
+            int gCount[ChannelGroups::kMaxGroups] {};
+            for (int ch = 0; ch < measCh; ++ch)
+            {
+                const int g = (groupedMeasurement ? linkGroups.getGroup(ch) : 0);
+                gPeak[g] = (peak[ch] > gPeak[g] ? peak[ch] : gPeak[g]);
+                gMs[g] += ms[ch];
+                ++gCount[g];
+            }
+
+            for (int g = 0; g < numGroups; ++g)
+            {
+                const int src = (groupedMeasurement ? g : 0);
+                const double rms = (gCount[src] > 0 ? std::sqrt(gMs[src] / (double) gCount[src]) : 0.0);
+                lane[g] = sanitize(alpha * gPeak[src] + beta * rms + gamma * transientLin);
+            }
+
+            for (int ch = 0; ch < numMainCh; ++ch)
+            {
+                double d = 0.0;
+                if (!groupedMeasurement)
+                    d = lane[linkGroups.getGroup(ch)];
+                else if (ch < measCh)
+                    d = alpha * peak[ch] + beta * std::sqrt(ms[ch]) + gamma * transientLin;
+                lane[laneStride + ch] = sanitize(d);
+            }
         }
-        double g = 0.0;
-        double z = 0.0;
-    };
+    }
 
     static double clamp01(double x)
     {
@@ -230,17 +499,6 @@ private:
         return x;
     }
 
-    void setOnePoleTimeConstantSeconds(OnePole& op, double tauSeconds)
-    {
-        // Standard one-pole coefficient from time constant.
-        // g = 1 - exp(-1/(tau*fs))
-        const double fs = (sampleRate > 0.0 ? sampleRate : 48000.0);
-        const double tau = (tauSeconds > 0.0 ? tauSeconds : 1e-3);
-        const double g = 1.0 - std::exp(-1.0 / (tau * fs));
-        op.setCoeff(g);
-        op.reset(0.0);
-    }
-
     double sampleRate = 48000.0;
 
     // Detector primitives (linear domain)
@@ -248,24 +506,60 @@ private:
     double rmsLin = 0.0;
     double transientLin = 0.0;
 
-    // Blended detector output (linear domain)
+    // Blended detector output (linear domain; loudest group)
     double detectorLin = 0.0;
 
+    // Phase 6: per link group readouts (SoA)
+    LinkGroupMap linkGroups = LinkGroupMap::allLinked(2);
+    bool groupedMeasurement = true;
+    double groupPeakLin[ChannelGroups::kMaxGroups] {};
+    double groupRmsLin[ChannelGroups::kMaxGroups] {};
+    double groupDetectorLin[ChannelGroups::kMaxGroups] {};
+    double channelDetectorLin[ChannelGroups::kMaxChannels] {};
+
     // A smoothing (τ = 250 µs)
     double attackNormTarget = 0.0;
     double attackNormSmoothed = 0.0;
-    OnePole aSmoother;
+
+    // Phase 6: block-rate smoothers live in the owner's bank (consecutive slots from smootherSlot)
+    enum { kAttackSmoother, kDominanceSmoother, kNumSmoothers };
+    SmootherBank* smoothers = nullptr;
+    int smootherSlot = SmootherBank::kScratchSlot;
 
 
     // Detector-only HPF (measurement path only)
     double detectorHpfCutoffHzTarget   = 0.0; // 0 = disabled
     double detectorHpfCutoffHzSmoothed = 0.0;
-    OnePole hpfCutoffSmoother;
-    std::vector<double> hpfLpState;
+    double hpfCutoffTileCoeff = 1.0;
+
+    // Phase 6: sidechain biquad bank (replaces the HPF and 120 Hz one-poles)
+    static constexpr int kFilterTileSize = FilterBank::kMaxTileSize;
+    FilterBank filterBank;
+    int decimation = 1;
+    HotStateBlock* hot = nullptr;
+    int numMeasChannels = 0; // prepared channel count (hot-state row stride; 0 until prepared)
+
+    // Phase 6: ISA-dispatched hot loops (picked at prepare)
+    const DspKernels::Table<SampleType>* kernels = &DspKernels::getActive<SampleType>();
+
+    // Phase 6: inter-sample peak estimate (Mastering tier only)
+    TruePeakDetector<SampleType> truePeakDetector;
+    bool truePeak = false;
+    bool truePeakShed = false;
+    double truePeakMix = 0.0;          // 1 = true peak, 0 = sample peak
+    double truePeakMixTileStep = 1.0;
+
+    // Phase 6: per-tile detection (tile state rows in the hot block, lanes in the arena)
+    static constexpr double kRmsTauSec = 0.010; // mean-square one-pole (≈ a 512-sample block at 48 kHz)
+    enum { kHeldPeakRow, kMeanSquareRow, kNumTileStateRows };
+    DspArena* arena = nullptr;
+    int tileStateOffset = 0;
+    int tileLanesOffset = 0;
+    int laneStride = 1; // channels per lane row (the prepared channel count)
+    int maxTiles = 1;   // tiles per prepared block
+    double msTileCoeff = 1.0;
 
     // Low-end dominance (detector-only measurement)
-    OnePole dominanceSmoother;
-    std::vector<double> lowLpState;
     double lowEndDominance01 = 0.0;
     // Placeholder normalized feeds for later phases / weighting logic
     double releaseNorm = 0.0; // R
@@ -1,15 +1,45 @@
-// Phase 1 Skeleton (NO-OP): structural placeholder only.
-// No DSP math. No parameters. No UI logic.
-// Must remain transparent pass-through.
+// Phase 6 — DetectorSplit (routing only)
+// Selects the detector (measurement) source: main input or external sidechain key.
+// Selection is by pointer — no copy, no allocation. Never modifies audio.
 
 #pragma once
 #include <JuceHeader.h>
 
+template <typename SampleType>
 struct DetectorSplit
 {
     void prepare (double, int) {}
-    void reset() {}
+    void reset()
+    {
+        externalKey = nullptr;
+        detectorSource = nullptr;
+    }
 
-    // Phase 1: no-op. Later: feed detector path vs audio path.
-    void process (juce::AudioBuffer<float>&) {}
+    // Selects the detector source for this block.
+    // External key is used only when it is present, has channels and matches the block length.
+    void process (juce::AudioBuffer<SampleType>& buffer)
+    {
+        const bool keyUsable = (externalKey != nullptr
+                                && externalKey->getNumChannels() > 0
+                                && externalKey->getNumSamples() == buffer.getNumSamples());
+
+        detectorSource = keyUsable ? externalKey : &buffer;
+    }
+
+    // ----------------------------
+    // Injection slots (NOT parameters)
+    // ----------------------------
+    // External sidechain key for the current block (nullptr = detect from main input).
+    void setExternalKey (const juce::AudioBuffer<SampleType>* key) { externalKey = key; }
+
+    // ----------------------------
+    // Readouts
+    // ----------------------------
+    // Valid after process() for the rest of the block.
+    const juce::AudioBuffer<SampleType>& getDetectorSource() const { return *detectorSource; }
+    bool isUsingExternalKey() const { return detectorSource != nullptr && detectorSource == externalKey; }
+
+private:
+    const juce::AudioBuffer<SampleType>* externalKey    = nullptr;
+    const juce::AudioBuffer<SampleType>* detectorSource = nullptr;
 };
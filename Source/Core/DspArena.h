@@ -0,0 +1,156 @@
+// Phase 6 — DspArena (per-instance buffer arena) + MemoryFootprint (per-stage report)
+// Every audio-thread buffer of a plugin instance (dry copies, delay lines, band buffers, the oversampling
+// dry path) is carved from one arena owned by the instance:
+// - Laid out in prepare: the owner calls clear(numChannels), stages reserve() tagged regions (cache-line
+//   aligned, zeroed) and the owner calls finish(), which leaves one allocation of exactly the laid-out size.
+// - The block may move while it is laid out; offsets stay valid, so stages keep offsets and resolve them per
+//   block with get(). Region contents survive the moves (stages may reset their regions during layout).
+// - process() never allocates.
+// MemoryFootprint collects bytes per stage name: the arena's regions plus whatever owners add for memory the
+// arena cannot hold (objects, hot state, JUCE-owned buffers).
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "ChannelGroups.h"
+
+struct MemoryFootprint
+{
+    static constexpr int kMaxItems = 32;
+
+    struct Item
+    {
+        const char* stage = "";
+        size_t bytes = 0;
+    };
+
+    // Adds bytes to a stage (equal names merge; once full, the last item absorbs the rest)
+    void add (const char* stage, size_t bytes)
+    {
+        for (int i = 0; i < numItems; ++i)
+        {
+            if (std::strcmp(items[(size_t) i].stage, stage) == 0)
+            {
+                items[(size_t) i].bytes += bytes;
+                return;
+            }
+        }
+
+        if (numItems < kMaxItems)
+            items[(size_t) numItems++] = { stage, bytes };
+        else
+            items[(size_t) kMaxItems - 1].bytes += bytes;
+    }
+
+    void clear() { numItems = 0; }
+
+    int getNumItems() const            { return numItems; }
+    const Item& getItem (int i) const  { return items[(size_t) i]; }
+
+    size_t getTotalBytes() const
+    {
+        size_t total = 0;
+        for (int i = 0; i < numItems; ++i)
+            total += items[(size_t) i].bytes;
+        return total;
+    }
+
+private:
+    std::array<Item, kMaxItems> items {};
+    int numItems = 0;
+};
+
+struct DspArena
+{
+    static constexpr int kAlignment = 64; // cache line
+
+    DspArena() = default;
+    DspArena (const DspArena&) = delete;
+    DspArena& operator= (const DspArena&) = delete;
+
+    // Owner prepare, before the stages reserve: drops the layout (storage is kept until finish()) and sets the
+    // instance's channel count (1 .. kMaxChannels) for per-channel regions
+    void clear (int numChannelsToUse)
+    {
+        numChannels = std::min(std::max(1, numChannelsToUse), (int) ChannelGroups::kMaxChannels);
+        used = 0;
+        regions.clear();
+    }
+
+    int getNumChannels() const { return numChannels; }
+
+    // Stage prepare: count value-initialized (zero) T, starting on a cache line. Returns the region's offset.
+    template <typename T>
+    int reserve (int count, const char* stage)
+    {
+        const size_t offset = used;
+        const size_t bytes = roundUp(sizeof(T) * (size_t) std::max(1, count));
+        if (offset + bytes > capacity)
+            reallocate(std::max(offset + bytes, 2 * capacity));
+
+        std::uninitialized_value_construct_n(get<T> ((int) offset), (size_t) std::max(1, count));
+        used = offset + bytes;
+        regions.add(stage, bytes);
+        return (int) offset;
+    }
+
+    // Owner prepare, after the last reserve: one allocation of exactly the laid-out size
+    void finish()
+    {
+        if (capacity != used)
+            reallocate(used);
+    }
+
+    template <typename T>
+    T* get (int offset) { return reinterpret_cast<T*> (data + offset); }
+
+    template <typename T>
+    const T* get (int offset) const { return reinterpret_cast<const T*> (data + offset); }
+
+    size_t getNumBytes() const { return used; }
+
+    // Laid-out regions, by stage
+    void addFootprint (MemoryFootprint& footprint) const
+    {
+        for (int i = 0; i < regions.getNumItems(); ++i)
+            footprint.add(regions.getItem(i).stage, regions.getItem(i).bytes);
+    }
+
+private:
+    static size_t roundUp (size_t bytes)
+    {
+        return (bytes + (size_t) kAlignment - 1) & ~((size_t) kAlignment - 1);
+    }
+
+    // Off the audio thread: keeps the laid-out prefix
+    void reallocate (size_t newCapacity)
+    {
+        std::unique_ptr<unsigned char[]> newStorage;
+        unsigned char* newData = nullptr;
+        if (newCapacity > 0)
+        {
+            newStorage.reset(new unsigned char[newCapacity + kAlignment - 1]);
+            const auto addr = reinterpret_cast<std::uintptr_t> (newStorage.get());
+            newData = newStorage.get() + (roundUp((size_t) addr) - (size_t) addr);
+            if (used > 0)
+                std::memcpy(newData, data, used);
+        }
+
+        storage = std::move(newStorage);
+        data = newData;
+        capacity = newCapacity;
+    }
+
+    std::unique_ptr<unsigned char[]> storage;
+    unsigned char* data = nullptr; // storage, aligned to kAlignment
+    size_t capacity = 0;
+    size_t used = 0;
+    int numChannels = 0;
+    MemoryFootprint regions;
+};
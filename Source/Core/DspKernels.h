@@ -0,0 +1,666 @@
+// Phase 6 — DspKernels (runtime ISA dispatch for the hot loops)
+// One binary, several instruction sets: each kernel body below is written once and instantiated per ISA
+// level through GCC/Clang `target` attributes (the body is force-inlined into an ISA-specific entry point,
+// so only that entry point is compiled for the wider ISA; nothing else in the plugin is). The best level
+// the CPU and OS support is picked once, on first use, into a function-pointer table; stages cache the
+// table pointer at construction / prepare().
+//
+//   Isa::baseline  the target's default flags (SSE2 on x86-64, NEON on arm64, plain C++ elsewhere)
+//   Isa::avx2      x86 with AVX2   (GCC / Clang only)
+//   Isa::avx512    x86 with AVX-512F (GCC / Clang only)
+//
+// MSVC and non-x86 builds carry the baseline table only (every Isa resolves to it).
+//
+// Modes (Mode::deterministic is the default; COMPASS_DSP_FAST_MATH=1 makes Mode::fast the build default,
+// setMode() switches at runtime):
+//
+//   Mode::deterministic  bit-identical across every ISA level and thread count (renders can be compared
+//                        bit for bit between machines). Bodies never reassociate (reductions run per
+//                        channel / lane, in sample order), floating-point contraction is off for the kernel
+//                        section (AVX-512F implies FMA, and a fused multiply-add rounds differently from the
+//                        baseline's multiply + add) and tanh comes from libm.
+//   Mode::fast           FastBody: FMA contraction allowed (AVX2 entry adds FMA), tile sums split across
+//                        interleaved accumulators, tanh from FastMath::exp2 (vectorized, no libm call).
+//                        Results depend on the ISA level; tolerances against deterministic mode:
+//
+//     kernel         fast-mode difference vs deterministic (measured, random inputs; float / double)
+//     -------------  ---------------------------------------------------------------------------------
+//     tileStats      sums <= 5 ulp relative (64-sample tile); peak exact
+//     gainLane       0 / <= 2 ulp (contraction only; FastMath accuracy tier unchanged)
+//     applyGain*     <= 2 ulp (applyGain itself is exact in both modes)
+//     softClip       1.2e-7 / 1.3e-9 absolute (tanh approximation: <= 1.1e-8 absolute)
+//     dcBlockLimit   2.7e-6 / 3.3e-9 absolute (float: FMA in the DC recursion, a = 0.999, on AVX levels)
+//     envelope       identical (recursion along samples: both modes share the deterministic body)
+//
+//   End to end (tests/test_kernel_equivalence: 400 blocks of 512, 2 ch, any tier / ISA level): CompressorPipeline
+//   float <= 5e-6 (-106 dBFS), double <= 3.5e-9 (-169 dBFS); MultibandCompressor (4 bands) float <= 3e-5
+//   (-90 dBFS), double <= 3.5e-9. The detector runs on per-tile sums, so a sum that differs in its last bits
+//   can move a tile's gain by a few float ulps; double absorbs that.
+//
+// Everything outside these kernels is plain scalar code built for the baseline, and MultibandCompressor
+// sums its bands in a fixed order whatever the worker count, so the kernel mode decides reproducibility.
+//
+// Kernels:
+//   tileStats     detector statistics: per-channel peak, sum of squares, low-band sum of squares (one tile)
+//   envelope      dual-stage envelope (shared attack, fast + slow release), lanes processed side by side
+//   gainLane      GR dB lane -> linear gain (Fine / Coarse FastMath)
+//   applyGain     x *= g;  applyGainMidSide: fused M/S encode -> gain -> decode
+//   softClip      oversampled safety clip (sealed tanh curve above 0.9)
+//   dcBlockLimit  OutputStage DC block + -0.3 dBFS soft limit (one channel)
+// No state. No allocation.
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "ChannelGroups.h"
+#include "FastMath.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+ #define COMPASS_DSPKERNELS_X86 1
+ #define COMPASS_DSPKERNELS_INLINE __attribute__((always_inline)) inline
+#elif defined(__GNUC__) || defined(__clang__)
+ #define COMPASS_DSPKERNELS_X86 0
+ #define COMPASS_DSPKERNELS_INLINE __attribute__((always_inline)) inline
+#else
+ #define COMPASS_DSPKERNELS_X86 0
+ #define COMPASS_DSPKERNELS_INLINE inline
+#endif
+
+// No FMA contraction inside kernel bodies (GCC: optimize pragma over the section below; Clang: per body)
+#if defined(__clang__)
+ #define COMPASS_DSPKERNELS_NO_CONTRACT _Pragma("clang fp contract(off)")
+#else
+ #define COMPASS_DSPKERNELS_NO_CONTRACT
+#endif
+
+namespace DspKernels
+{
+    enum class Isa
+    {
+        baseline,
+        avx2,
+        avx512
+    };
+
+    enum class Mode
+    {
+        deterministic,
+        fast
+    };
+
+   #ifndef COMPASS_DSP_FAST_MATH
+    #define COMPASS_DSP_FAST_MATH 0
+   #endif
+
+    constexpr Mode kDefaultMode = (COMPASS_DSP_FAST_MATH ? Mode::fast : Mode::deterministic);
+
+    inline const char* getIsaName (Isa isa)
+    {
+        switch (isa)
+        {
+            case Isa::avx2:   return "AVX2";
+            case Isa::avx512: return "AVX-512";
+            case Isa::baseline:
+            default:
+               #if defined(__aarch64__) || defined(__ARM_NEON)
+                return "NEON";
+               #elif defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+                return "SSE2";
+               #else
+                return "generic";
+               #endif
+        }
+    }
+
+    // Envelope law inputs (block-rate values from DualStageRelease; modScale is per sample)
+    struct EnvelopeCoeffs
+    {
+        double gA = 0.0, gF = 0.0, gS = 0.0;
+        double wFast = 1.0, wSlow = 0.0;
+        const double* modScale = nullptr;
+    };
+
+   #if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC push_options
+    #pragma GCC optimize ("fp-contract=off")
+   #endif
+
+    // ----------------------------
+    // Kernel bodies (ISA-neutral C++; inlined into each entry point)
+    // ----------------------------
+    template <typename T>
+    struct Body
+    {
+        static constexpr int kStride = ChannelGroups::kMaxChannels; // sample-major tile row
+
+        template <int Cols>
+        static COMPASS_DSPKERNELS_INLINE void tileStatsCols (const T* y, const T* low, int n,
+                                                             T* peak, T* sumSq, T* sumSqLow)
+        {
+            COMPASS_DSPKERNELS_NO_CONTRACT
+            T p[Cols], s[Cols], sl[Cols];
+            for (int ch = 0; ch < Cols; ++ch)
+            {
+                p[ch] = peak[ch];
+                s[ch] = sumSq[ch];
+                sl[ch] = sumSqLow[ch];
+            }
+            for (int i = 0; i < n; ++i)
+            {
+                const T* v = y + i * kStride;
+                const T* l = low + i * kStride;
+                for (int ch = 0; ch < Cols; ++ch)
+                {
+                    const T a = std::abs(v[ch]);
+                    p[ch] = (a > p[ch] ? a : p[ch]);
+                    s[ch] += v[ch] * v[ch];
+                    sl[ch] += l[ch] * l[ch];
+                }
+            }
+            for (int ch = 0; ch < Cols; ++ch)
+            {
+                peak[ch] = p[ch];
+                sumSq[ch] = s[ch];
+                sumSqLow[ch] = sl[ch];
+            }
+        }
+
+        // Columns are processed in fixed widths (2 / 4 / 8 / 16): columns past numCh must hold finite
+        // values (callers keep them zeroed) and their results are ignored.
+        static COMPASS_DSPKERNELS_INLINE void tileStats (const T* y, const T* low, int n, int numCh,
+                                                         T* peak, T* sumSq, T* sumSqLow)
+        {
+            if (numCh <= 2)      tileStatsCols<2>  (y, low, n, peak, sumSq, sumSqLow);
+            else if (numCh <= 4) tileStatsCols<4>  (y, low, n, peak, sumSq, sumSqLow);
+            else if (numCh <= 8) tileStatsCols<8>  (y, low, n, peak, sumSq, sumSqLow);
+            else                 tileStatsCols<16> (y, low, n, peak, sumSq, sumSqLow);
+        }
+
+        // W lanes side by side (the recursion runs along samples, the vector across lanes)
+        template <int W>
+        static COMPASS_DSPKERNELS_INLINE void envelopeLanes (const ControlLanes& in, ControlLanes& out, int k0, int n,
+                                                             const EnvelopeCoeffs& c,
+                                                             double* fastEnv, double* slowEnv, double* envOut)
+        {
+            COMPASS_DSPKERNELS_NO_CONTRACT
+            double ef[W], es[W], y[W];
+            for (int k = 0; k < W; ++k)
+            {
+                ef[k] = fastEnv[k0 + k];
+                es[k] = slowEnv[k0 + k];
+                y[k]  = envOut[k0 + k];
+            }
+
+            for (int i = 0; i < n; ++i)
+            {
+                const double m  = c.modScale[i];
+                const double gF = c.gF * m;
+                const double gS = c.gS * m;
+                for (int k = 0; k < W; ++k)
+                {
+                    double x = in[k0 + k][i];
+                    if (!std::isfinite(x) || x < 0.0) x = 0.0;
+
+                    ef[k] += (x > ef[k] ? c.gA : gF) * (x - ef[k]);
+                    es[k] += (x > es[k] ? c.gA : gS) * (x - es[k]);
+
+                    y[k] = c.wFast * ef[k] + c.wSlow * es[k];
+                    out[k0 + k][i] = y[k];
+                }
+            }
+
+            for (int k = 0; k < W; ++k)
+            {
+                fastEnv[k0 + k] = ef[k];
+                slowEnv[k0 + k] = es[k];
+                envOut[k0 + k]  = y[k];
+            }
+        }
+
+        // State arrays are per lane; the caller sanitizes them afterwards. in / out may alias.
+        static COMPASS_DSPKERNELS_INLINE void envelope (const ControlLanes& in, ControlLanes& out, int numLanes, int n,
+                                                        const EnvelopeCoeffs& c,
+                                                        double* fastEnv, double* slowEnv, double* envOut)
+        {
+            int k = 0;
+            for (; k + 4 <= numLanes; k += 4)
+                envelopeLanes<4>(in, out, k, n, c, fastEnv, slowEnv, envOut);
+            for (; k + 2 <= numLanes; k += 2)
+                envelopeLanes<2>(in, out, k, n, c, fastEnv, slowEnv, envOut);
+            for (; k < numLanes; ++k)
+                envelopeLanes<1>(in, out, k, n, c, fastEnv, slowEnv, envOut);
+        }
+
+        // GR dB (clamped to [0, maxDb]; NaN -> 0) -> linear gain
+        template <FastMath::Accuracy A>
+        static COMPASS_DSPKERNELS_INLINE void gainLane (const double* grDb, T* gains, int n, double maxDb)
+        {
+            COMPASS_DSPKERNELS_NO_CONTRACT
+            for (int i = 0; i < n; ++i)
+            {
+                double db = grDb[i];
+                db = (db > 0.0 ? db : 0.0);
+                db = (db < maxDb ? db : maxDb);
+                gains[i] = (T) FastMath::dbToGainInRange<A>(-db);
+            }
+        }
+
+        static COMPASS_DSPKERNELS_INLINE void applyGain (T* x, const T* gains, int n)
+        {
+            COMPASS_DSPKERNELS_NO_CONTRACT
+            for (int i = 0; i < n; ++i)
+                x[i] *= gains[i];
+        }
+
+        //   L' = a*L + b*R, R' = b*L + a*R   with a = (gM + gS)/2, b = (gM - gS)/2
+        static COMPASS_DSPKERNELS_INLINE void applyGainMidSide (T* l, T* r, const T* gM, const T* gS, int n)
+        {
+            COMPASS_DSPKERNELS_NO_CONTRACT
+            for (int i = 0; i < n; ++i)
+            {
+                const T a = T (0.5) * (gM[i] + gS[i]);
+                const T b = T (0.5) * (gM[i] - gS[i]);
+                const T xl = l[i];
+                const T xr = r[i];
+                l[i] = a * xl + b * xr;
+                r[i] = b * xl + a * xr;
+            }
+        }
+
+        // Sealed gentle curve: tanh-based with conservative drive (bounded output, no hard corners)
+        static COMPASS_DSPKERNELS_INLINE T softClipCurve (T x)
+        {
+            const T drive = (T) 1.20;
+            return std::tanh(drive * x) / std::tanh(drive);
+        }
+
+        // Sealed: only samples above 0.90 are touched (non-finite samples are left as they are).
+        // A vectorized scan per chunk skips the scalar curve pass for chunks with nothing to clip.
+        static COMPASS_DSPKERNELS_INLINE void softClip (T* p, int n)
+        {
+            constexpr int kChunk = 32;
+            for (int start = 0; start < n; start += kChunk)
+            {
+                const int end = (n - start < kChunk ? n : start + kChunk);
+                int hot = 0;
+                for (int i = start; i < end; ++i)
+                    hot |= (int) (std::abs(p[i]) > (T) 0.90);
+                if (hot == 0)
+                    continue;
+
+                for (int i = start; i < end; ++i)
+                {
+                    T x = p[i];
+                    if (!std::isfinite(x)) x = 0;
+                    if (std::abs(x) > (T) 0.90)
+                        p[i] = softClipCurve(x);
+                }
+            }
+        }
+
+        // DC block (1st-order HP) + sealed -0.3 dBFS soft limit; non-finite in/out -> 0
+        static COMPASS_DSPKERNELS_INLINE void dcBlockLimit (T* p, int n, T a, T& x1, T& y1)
+        {
+            COMPASS_DSPKERNELS_NO_CONTRACT
+            constexpr T kClip = (T) 0.96593632892484; // 10^(-0.3/20)
+            T px1 = x1;
+            T py1 = y1;
+            for (int i = 0; i < n; ++i)
+            {
+                T x = p[i];
+                if (!std::isfinite(x)) x = 0;
+
+                const T y = (x - px1) + a * py1;
+                px1 = x;
+                py1 = y;
+
+                T out = y;
+                if (!std::isfinite(out)) out = 0;
+
+                p[i] = kClip * std::tanh(out / kClip);
+            }
+            x1 = px1;
+            y1 = py1;
+        }
+    };
+
+    // ----------------------------
+    // Function-pointer table
+    // ----------------------------
+    template <typename T>
+    struct Table
+    {
+        Mode mode = Mode::deterministic;
+        Isa isa = Isa::baseline;
+        void (*tileStats) (const T*, const T*, int, int, T*, T*, T*) = nullptr;
+        void (*envelope) (const ControlLanes&, ControlLanes&, int, int, const EnvelopeCoeffs&,
+                          double*, double*, double*) = nullptr;
+        void (*gainLaneFine) (const double*, T*, int, double) = nullptr;
+        void (*gainLaneCoarse) (const double*, T*, int, double) = nullptr;
+        void (*applyGain) (T*, const T*, int) = nullptr;
+        void (*applyGainMidSide) (T*, T*, const T*, const T*, int) = nullptr;
+        void (*softClip) (T*, int) = nullptr;
+        void (*dcBlockLimit) (T*, int, T, T&, T&) = nullptr;
+
+        template <FastMath::Accuracy A>
+        void gainLane (const double* grDb, T* gains, int n, double maxDb) const
+        {
+            if constexpr (A == FastMath::Accuracy::Coarse)
+                gainLaneCoarse(grDb, gains, n, maxDb);
+            else
+                gainLaneFine(grDb, gains, n, maxDb);
+        }
+    };
+
+    // Per-ISA entry points for one kernel body
+    template <auto Kernel>
+    struct Entry;
+
+    template <typename R, typename... Args, R (*Kernel) (Args...)>
+    struct Entry<Kernel>
+    {
+        static R baseline (Args... args) { return Kernel(args...); }
+       #if COMPASS_DSPKERNELS_X86
+        __attribute__((target("avx2")))    static R avx2 (Args... args)   { return Kernel(args...); }
+        __attribute__((target("avx512f"))) static R avx512 (Args... args) { return Kernel(args...); }
+       #endif
+    };
+
+   #if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC pop_options
+   #endif
+
+    // ----------------------------
+    // Fast-mode bodies (Mode::fast; outside the no-contract section)
+    // ----------------------------
+    template <typename T>
+    struct FastBody
+    {
+        static constexpr int kStride = Body<T>::kStride;
+
+        // tanh without libm or selects (keeps the loops if-convertible): |x| is clamped to kMax with the
+        // min(a, b) = (a + b - |a - b|) / 2 identity, then tanh(c) = (1 - e) / (1 + e) with e = 2^(-2c log2e).
+        static COMPASS_DSPKERNELS_INLINE double tanhApprox (double x)
+        {
+            constexpr double kMax = 9.5; // tanh(9.5) = 1 - 1.1e-8 (below float resolution at 1.0)
+            const double ax = std::abs(x);
+            const double c  = 0.5 * ((ax + kMax) - std::abs(ax - kMax));
+            const double e  = FastMath::exp2InRange<FastMath::Accuracy::Fine>((-2.0 * FastMath::kLog2e) * c);
+            return std::copysign((1.0 - e) / (1.0 + e), x);
+        }
+
+        // take ? a : b as a bit mask (a ternary here gets turned back into a branch around the curve)
+        static COMPASS_DSPKERNELS_INLINE T blend (bool take, T a, T b)
+        {
+            using Bits = std::conditional_t<sizeof (T) == 4, std::uint32_t, std::uint64_t>;
+            Bits ua, ub;
+            std::memcpy(&ua, &a, sizeof (T));
+            std::memcpy(&ub, &b, sizeof (T));
+            const Bits mask = Bits (0) - (Bits) take;
+            const Bits u = (ua & mask) | (ub & ~mask);
+            T r;
+            std::memcpy(&r, &u, sizeof (T));
+            return r;
+        }
+
+        // Two interleaved accumulators per column (sample pairs), combined at the end
+        template <int Cols>
+        static COMPASS_DSPKERNELS_INLINE void tileStatsCols (const T* y, const T* low, int n,
+                                                             T* peak, T* sumSq, T* sumSqLow)
+        {
+            T p[Cols], s0[Cols], s1[Cols], l0[Cols], l1[Cols];
+            for (int ch = 0; ch < Cols; ++ch)
+            {
+                p[ch] = peak[ch];
+                s0[ch] = sumSq[ch];
+                l0[ch] = sumSqLow[ch];
+                s1[ch] = l1[ch] = T (0);
+            }
+            int i = 0;
+            for (; i + 2 <= n; i += 2)
+            {
+                const T* v = y + i * kStride;
+                const T* l = low + i * kStride;
+                for (int ch = 0; ch < Cols; ++ch)
+                {
+                    const T a = std::abs(v[ch]);
+                    const T b = std::abs(v[kStride + ch]);
+                    const T m = (a > b ? a : b);
+                    p[ch] = (m > p[ch] ? m : p[ch]);
+                    s0[ch] += v[ch] * v[ch];
+                    s1[ch] += v[kStride + ch] * v[kStride + ch];
+                    l0[ch] += l[ch] * l[ch];
+                    l1[ch] += l[kStride + ch] * l[kStride + ch];
+                }
+            }
+            for (; i < n; ++i)
+            {
+                const T* v = y + i * kStride;
+                const T* l = low + i * kStride;
+                for (int ch = 0; ch < Cols; ++ch)
+                {
+                    const T a = std::abs(v[ch]);
+                    p[ch] = (a > p[ch] ? a : p[ch]);
+                    s0[ch] += v[ch] * v[ch];
+                    l0[ch] += l[ch] * l[ch];
+                }
+            }
+            for (int ch = 0; ch < Cols; ++ch)
+            {
+                peak[ch] = p[ch];
+                sumSq[ch] = s0[ch] + s1[ch];
+                sumSqLow[ch] = l0[ch] + l1[ch];
+            }
+        }
+
+        static COMPASS_DSPKERNELS_INLINE void tileStats (const T* y, const T* low, int n, int numCh,
+                                                         T* peak, T* sumSq, T* sumSqLow)
+        {
+            // Eight columns and up already keep enough independent sums in flight
+            if (numCh <= 2)      tileStatsCols<2> (y, low, n, peak, sumSq, sumSqLow);
+            else if (numCh <= 4) tileStatsCols<4> (y, low, n, peak, sumSq, sumSqLow);
+            else                 Body<T>::tileStats(y, low, n, numCh, peak, sumSq, sumSqLow);
+        }
+
+        template <FastMath::Accuracy A>
+        static COMPASS_DSPKERNELS_INLINE void gainLane (const double* grDb, T* gains, int n, double maxDb)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                double db = grDb[i];
+                db = (db > 0.0 ? db : 0.0);
+                db = (db < maxDb ? db : maxDb);
+                gains[i] = (T) FastMath::dbToGainInRange<A>(-db);
+            }
+        }
+
+        static COMPASS_DSPKERNELS_INLINE void applyGainMidSide (T* l, T* r, const T* gM, const T* gS, int n)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                const T a = T (0.5) * (gM[i] + gS[i]);
+                const T b = T (0.5) * (gM[i] - gS[i]);
+                const T xl = l[i];
+                const T xr = r[i];
+                l[i] = a * xl + b * xr;
+                r[i] = b * xl + a * xr;
+            }
+        }
+
+        // Same sealed curve and chunk skip as Body::softClip; hot chunks are clipped with a blend
+        static COMPASS_DSPKERNELS_INLINE void softClip (T* p, int n)
+        {
+            constexpr double kDrive   = 1.20;
+            constexpr double kInvNorm = 1.1995375441923508; // 1 / tanh(1.2)
+            constexpr T kMaxFinite    = std::numeric_limits<T>::max();
+            constexpr int kChunk = 32;
+            for (int start = 0; start < n; start += kChunk)
+            {
+                const int end = (n - start < kChunk ? n : start + kChunk);
+                int hot = 0;
+                for (int i = start; i < end; ++i)
+                    hot |= (int) (std::abs(p[i]) > (T) 0.90);
+                if (hot == 0)
+                    continue;
+
+                for (int i = start; i < end; ++i)
+                {
+                    const T x = p[i];
+                    const T a = std::abs(x);
+                    const T c = (T) (kInvNorm * tanhApprox(kDrive * (double) x));
+                    p[i] = blend((a > (T) 0.90) & (a <= kMaxFinite), c, x);
+                }
+            }
+        }
+
+        // DC-block recursion first (serial, sanitized as in Body), then the limit curve as a vector pass
+        static COMPASS_DSPKERNELS_INLINE void dcBlockLimit (T* p, int n, T a, T& x1, T& y1)
+        {
+            constexpr double kClip = 0.96593632892484; // 10^(-0.3/20)
+            T px1 = x1;
+            T py1 = y1;
+            for (int i = 0; i < n; ++i)
+            {
+                T x = p[i];
+                if (!std::isfinite(x)) x = 0;
+
+                const T y = (x - px1) + a * py1;
+                px1 = x;
+                py1 = y;
+
+                p[i] = (std::isfinite(y) ? y : T (0));
+            }
+            x1 = px1;
+            y1 = py1;
+
+            for (int i = 0; i < n; ++i)
+                p[i] = (T) (kClip * tanhApprox((double) p[i] * (1.0 / kClip)));
+        }
+    };
+
+    // Fast-mode entry points (contraction allowed; the AVX2 level adds FMA)
+    template <auto Kernel>
+    struct FastEntry;
+
+    template <typename R, typename... Args, R (*Kernel) (Args...)>
+    struct FastEntry<Kernel>
+    {
+        static R baseline (Args... args) { return Kernel(args...); }
+       #if COMPASS_DSPKERNELS_X86
+        __attribute__((target("avx2,fma"))) static R avx2 (Args... args)   { return Kernel(args...); }
+        __attribute__((target("avx512f")))  static R avx512 (Args... args) { return Kernel(args...); }
+       #endif
+    };
+
+    template <Mode M, Isa I, auto Kernel>
+    constexpr auto entry()
+    {
+        using E = std::conditional_t<M == Mode::fast, FastEntry<Kernel>, Entry<Kernel>>;
+       #if COMPASS_DSPKERNELS_X86
+        if constexpr (I == Isa::avx512) return &E::avx512;
+        else if constexpr (I == Isa::avx2) return &E::avx2;
+        else
+       #endif
+        return &E::baseline;
+    }
+
+    template <typename T, Mode M, Isa I>
+    Table<T> makeTable()
+    {
+        using B = Body<T>;
+        using F = std::conditional_t<M == Mode::fast, FastBody<T>, Body<T>>;
+        Table<T> t;
+        t.mode             = M;
+        t.isa              = (COMPASS_DSPKERNELS_X86 ? I : Isa::baseline);
+        t.tileStats        = entry<M, I, &F::tileStats>();
+        // The envelope is a recursion along samples: wider vectors only add lane gathers (measured slower
+        // than the baseline four-lane grouping at 2..12 lanes), so every level uses the baseline entry.
+        // Nothing in it can be reassociated, so both modes share the deterministic body.
+        t.envelope         = entry<Mode::deterministic, Isa::baseline, &B::envelope>();
+        t.gainLaneFine     = entry<M, I, &F::template gainLane<FastMath::Accuracy::Fine>>();
+        t.gainLaneCoarse   = entry<M, I, &F::template gainLane<FastMath::Accuracy::Coarse>>();
+        t.applyGain        = entry<Mode::deterministic, I, &B::applyGain>(); // one multiply: exact in both
+        t.applyGainMidSide = entry<M, I, &F::applyGainMidSide>();
+        // SSE2 has no 64-bit blend to vectorize FastBody<double>::softClip with, and scalar, the approximation
+        // is slower than libm tanh: the double baseline keeps the deterministic clip.
+        constexpr bool exactClip = (I == Isa::baseline && std::is_same_v<T, double>);
+        t.softClip         = (exactClip ? entry<Mode::deterministic, I, &B::softClip>()
+                                        : entry<M, I, &F::softClip>());
+        t.dcBlockLimit     = entry<M, I, &F::dcBlockLimit>();
+        return t;
+    }
+
+    // ----------------------------
+    // Selection
+    // ----------------------------
+    // Widest level this CPU + OS can run (detected once)
+    inline Isa getDetectedIsa()
+    {
+        static const Isa detected = []
+        {
+           #if COMPASS_DSPKERNELS_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return Isa::avx512;
+            if (__builtin_cpu_supports("avx2"))    return Isa::avx2;
+           #endif
+            return Isa::baseline;
+        }();
+        return detected;
+    }
+
+    inline bool isSupported (Isa isa) { return (int) isa <= (int) getDetectedIsa(); }
+
+    template <typename T>
+    const Table<T>& getTable (Mode mode, Isa isa)
+    {
+        static const Table<T> tables[2][3] = {
+            { makeTable<T, Mode::deterministic, Isa::baseline>(),
+              makeTable<T, Mode::deterministic, Isa::avx2>(),
+              makeTable<T, Mode::deterministic, Isa::avx512>() },
+            { makeTable<T, Mode::fast, Isa::baseline>(),
+              makeTable<T, Mode::fast, Isa::avx2>(),
+              makeTable<T, Mode::fast, Isa::avx512>() }
+        };
+        return tables[(int) mode][(int) isa];
+    }
+
+    template <typename T>
+    const Table<T>& getTable (Isa isa) { return getTable<T>(kDefaultMode, isa); }
+
+    template <typename T>
+    std::atomic<const Table<T>*>& activeSlot()
+    {
+        static std::atomic<const Table<T>*> slot { &getTable<T>(kDefaultMode, getDetectedIsa()) };
+        return slot;
+    }
+
+    // Table stages use (build-default mode, best supported level unless overridden)
+    template <typename T>
+    const Table<T>& getActive() { return *activeSlot<T>().load(std::memory_order_acquire); }
+
+    inline Mode getMode() { return getActive<double>().mode; }
+
+    // Stages pick a change of mode / level up at their next prepare() (process-wide, both precisions)
+    inline void select (Mode mode, Isa isa)
+    {
+        activeSlot<float>().store(&getTable<float>(mode, isa), std::memory_order_release);
+        activeSlot<double>().store(&getTable<double>(mode, isa), std::memory_order_release);
+    }
+
+    inline void setMode (Mode mode) { select(mode, getActive<double>().isa); }
+
+    // Override the level (tests / diagnostics). Returns false (and changes nothing) if the CPU cannot run it.
+    inline bool forceIsa (Isa isa)
+    {
+        if (!isSupported(isa))
+            return false;
+        select(getMode(), isa);
+        return true;
+    }
+}
@@ -1,23 +1,43 @@
-// Phase 4E.1 — DualStageRelease (stub only)
-// Structural plumbing only: injection slots + neutral readouts.
-// No DSP math. No parameters. No UI. Must remain transparent/no-op.
+// Phase 4E.1 — DualStageRelease
+// Phase 6: per-sample two-stage release envelope (control-only; audio untouched).
+// - process(): block-rate law — fast/slow blend weights + stage coefficients from injected controls
+// - processEnvelope(): per-sample envelope loop — shared attack, parallel fast + slow release decays,
+//   blended by the program-material weights, with a recursive (rotating phasor) micro-modulation oscillator.
+// No parameters. No UI.
 
 #pragma once
 #include <JuceHeader.h>
 
+#include "ChannelGroups.h"
+#include "DspKernels.h"
+#include "FastMath.h"
+#include "HotStateBlock.h"
+#include "../Util/DenormalGuard.h"
+
 struct DualStageRelease
 {
-    void prepare (double sr, int)
+    // Phase 6: owner's hot-state block (not owned). Attach before prepare(); the per-lane envelopes are
+    // reserved there (one row each, packed at the block's channel count).
+    void setHotState (HotStateBlock& block) { hot = &block; }
 
+    void prepare (double sr, int)
     {
+        numLanesPrepared = hot->getNumChannels();
+        envOffset = hot->reserve<double> (kNumEnvRows * numLanesPrepared);
 
-        sampleRateHz = (sr > 0.0 ? sr : 48000.0);
+        // Phase 6: the envelope runs at the control rate (sample rate / decimation in multirate mode)
+        sampleRateHz = (sr > 0.0 ? sr : 48000.0) / (double) decimation;
 
-        // Deterministic phase accumulator for micro-modulation (control-only)
-
-        microPhase = 0.0;
+        // Recursive micro-modulation oscillator: per-sample rotation by 2*pi*f/fs (sealed f = 0.25 Hz)
+        const double w = (2.0 * juce::MathConstants<double>::pi) * (kMicroModHz / sampleRateHz);
+        oscRotCos = std::cos(w);
+        oscRotSin = std::sin(w);
+        oscRotRadians = w;
 
+        kernels = &DspKernels::getActive<double>();
+        reset();
     }
+
     void reset()
     {
         releaseNormIn      = 0.0;
@@ -34,12 +54,25 @@ struct DualStageRelease
 
         microModDepth01    = 0.0;
         microMod01         = 0.0;
-        microPhase         = 0.0;
+
+        attackMs             = 10.0;
+        releaseAdjustFactor  = 1.0;
+
+        gAttack      = 0.0;
+        gFastRelease = 0.0;
+        gSlowRelease = 0.0;
+
+        // Deterministic oscillator start (phase 0)
+        oscCos = 1.0;
+        oscSin = 0.0;
+
+        std::fill_n(hot->get<double> (envOffset), kNumEnvRows * numLanesPrepared, 0.0);
     }
 
-    // Phase 4E.1 stub: no-op (no audio modification).
-    // Control-only: clamp/sanitize injected values and keep neutral outputs.
-    void process (juce::AudioBuffer<float>&)
+    // Block-rate control law (no audio modification).
+    // Control-only: clamp/sanitize injected values, derive blend weights + per-sample stage coefficients.
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>&)
     {
         // Sanitize injected inputs
         releaseNormIn     = clamp01(releaseNormIn);
@@ -59,7 +92,8 @@ struct DualStageRelease
         //   - grDbIn (0..24 dB): GR depth indicator
         // Outputs:
         //   - fastBlend01, slowBlend01 (0..1): blend weights (sum to 1)
-        //   - effectiveReleaseMs: blended dual-stage release time (ms), with tiny bounded micro-modulation
+        //   - gFastRelease, gSlowRelease, gAttack: per-sample one-pole coefficients for processEnvelope()
+        //   - effectiveReleaseMs: blended dual-stage release time (ms) readout, with micro-modulation
 
         const double R = clamp01(releaseNormIn);
                 const double transient01 = clamp01(programMaterial01);
@@ -109,33 +143,134 @@ struct DualStageRelease
 
         // 3) Dual-stage times derived from base
         // Fast stage: quick recovery; Slow stage: tail settling.
-        fastReleaseMs = clampMs(baseReleaseMs * 0.20, 5.0, 500.0);
-        slowReleaseMs = clampMs(baseReleaseMs * 1.80, 50.0, 5000.0);
+        // LowEndGuard release tightening applies to both stages (1.0 = no change).
+        const double leFactor = clampMs(releaseAdjustFactor, 0.65, 1.0);
+        fastReleaseMs = clampMs(baseReleaseMs * 0.20 * leFactor, 5.0, 500.0);
+        slowReleaseMs = clampMs(baseReleaseMs * 1.80 * leFactor, 50.0, 5000.0);
 
-        // 4) Blend to effective release
+        // 4) Blend to effective release (readout only; the envelope runs both stages in parallel)
         double effMs = fastBlend01 * fastReleaseMs + slowBlend01 * slowReleaseMs;
         if (!std::isfinite(effMs) || effMs <= 0.0) effMs = baseReleaseMs;
 
         // 5) Micro-modulation (tiny, bounded, deterministic)
         // Depth grows slightly with transientness and GR depth, but remains subtle.
         microModDepth01 = clamp01(0.10 + 0.60 * tCurve + 0.30 * smooth01(gr01));
-        // Max +/- 3% at full depth
-        const double maxPct = 0.03;
-        // Fixed very-low modulation frequency (Hz)
-        const double fHz = 0.25;
-        const double fs = (sampleRateHz > 0.0 ? sampleRateHz : 48000.0);
-
-        microPhase += (2.0 * juce::MathConstants<double>::pi) * (fHz / fs);
-        if (microPhase > 2.0 * juce::MathConstants<double>::pi)
-            microPhase = std::fmod(microPhase, 2.0 * juce::MathConstants<double>::pi);
 
-        const double mod = std::sin(microPhase);
+        const double mod = oscSin;
         microMod01 = clamp01(0.5 + 0.5 * mod); // 0..1 visibility
-        const double pct = maxPct * microModDepth01 * mod; // -max..+max
-        effMs *= (1.0 + pct);
+        effectiveReleaseMs = clampMs(effMs * (1.0 + kMicroModMaxPct * microModDepth01 * mod), 5.0, 5000.0);
 
-        effectiveReleaseMs = clampMs(effMs, 5.0, 5000.0);
+        // 6) Per-sample one-pole coefficients: g = 1 - exp(-1/(tau*fs))
+        const double fs = (sampleRateHz > 0.0 ? sampleRateHz : 48000.0);
+        gAttack      = onePoleCoeff(clampMs(attackMs, 0.05, 100.0), fs);
+        gFastRelease = onePoleCoeff(fastReleaseMs, fs);
+        gSlowRelease = onePoleCoeff(slowReleaseMs, fs);
+    }
+
+    // Per-sample envelope loop (control-only). in/out are linear detector levels, one lane per channel;
+    // in may alias out. Both release stages run in parallel from a shared attack; output = fast*wFast + slow*wSlow.
+    // Micro-modulation scales release time by (1 + pct); coefficient scales by ~(1 - pct) for |pct| <= 3%.
+    // The oscillator is shared: it runs once per tile and every lane reads the same modulation values.
+    void processEnvelope (const ControlLanes& in, ControlLanes& out, int numLanes, int n)
+    {
+        numLanes = std::min(numLanes, numLanesPrepared);
+        const double wFast  = fastBlend01;
+        const double wSlow  = slowBlend01;
+        const double gA     = gAttack;
+        const double gF     = gFastRelease;
+        const double gS     = gSlowRelease;
+        const double modAmt = kMicroModMaxPct * microModDepth01;
+        const double rc     = oscRotCos;
+        const double rs     = oscRotSin;
+
+        double c = oscCos;
+        double s = oscSin;
+
+        double modScale[ChannelGroups::kTileSize];
+        for (int i = 0; i < n; ++i)
+        {
+            modScale[i] = 1.0 - modAmt * s;
+
+            // Rotate phasor one sample (recursive oscillator, no std::sin)
+            const double cNext = c * rc - s * rs;
+            s = s * rc + c * rs;
+            c = cNext;
+        }
+
+        // Amplitude renormalization (first-order, once per call) keeps the phasor on the unit circle.
+        const double k = 1.5 - 0.5 * (c * c + s * s);
+        oscCos = c * k;
+        oscSin = s * k;
+
+        // Phase 6: lanes side by side in the ISA-dispatched kernel
+        DspKernels::EnvelopeCoeffs coeffs;
+        coeffs.gA = gA;
+        coeffs.gF = gF;
+        coeffs.gS = gS;
+        coeffs.wFast = wFast;
+        coeffs.wSlow = wSlow;
+        coeffs.modScale = modScale;
+        double* fastEnv = fastEnvRow();
+        double* slowEnv = slowEnvRow();
+        double* envOut = envOutRow();
+        kernels->envelope(in, out, numLanes, n, coeffs, fastEnv, slowEnv, envOut);
+
+        for (int k = 0; k < numLanes; ++k)
+        {
+            fastEnv[k] = std::isfinite(fastEnv[k]) ? fastEnv[k] : 0.0;
+            slowEnv[k] = std::isfinite(slowEnv[k]) ? slowEnv[k] : 0.0;
+            envOut[k]  = std::isfinite(envOut[k])  ? envOut[k]  : 0.0;
+        }
+        flushEnvelopes();
+    }
 
+    // Eco tier: tile-rate envelope. The input is held for the tile, so each stage's n-sample one-pole run
+    // collapses to a single step of 1 - (1 - g)^n; the modulation is sampled once at the tile start.
+    // out[k][0] = envelope at the end of the tile (the caller ramps across the tile).
+    void processEnvelopeTileRate (const ControlLanes& in, ControlLanes& out, int numLanes, int n)
+    {
+        if (n <= 0)
+            return;
+        numLanes = std::min(numLanes, numLanesPrepared);
+
+        const double modScale = 1.0 - kMicroModMaxPct * microModDepth01 * oscSin;
+        const double gA = tileCoeff(gAttack, n);
+        const double gF = tileCoeff(gFastRelease * modScale, n);
+        const double gS = tileCoeff(gSlowRelease * modScale, n);
+
+        // Advance the shared oscillator by n samples (same phasor as the per-sample path)
+        double c = oscCos;
+        double s = oscSin;
+        for (int i = 0; i < n; ++i)
+        {
+            const double cNext = c * oscRotCos - s * oscRotSin;
+            s = s * oscRotCos + c * oscRotSin;
+            c = cNext;
+        }
+        const double k = 1.5 - 0.5 * (c * c + s * s);
+        oscCos = c * k;
+        oscSin = s * k;
+
+        double* fastEnv = fastEnvRow();
+        double* slowEnv = slowEnvRow();
+        double* envOut = envOutRow();
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            double x = in[lane][0];
+            if (!std::isfinite(x) || x < 0.0) x = 0.0;
+
+            double ef = fastEnv[lane];
+            double es = slowEnv[lane];
+            ef += (x > ef ? gA : gF) * (x - ef);
+            es += (x > es ? gA : gS) * (x - es);
+            const double y = fastBlend01 * ef + slowBlend01 * es;
+
+            fastEnv[lane] = std::isfinite(ef) ? ef : 0.0;
+            slowEnv[lane] = std::isfinite(es) ? es : 0.0;
+            envOut[lane]  = std::isfinite(y)  ? y  : 0.0;
+            out[lane][0]  = envOut[lane];
+        }
+        flushEnvelopes();
     }
 
     // ----------------------------
@@ -146,6 +281,16 @@ struct DualStageRelease
     void setReleaseNormalized (double r) { setReleaseNormalizedIn(r); }
 
     void setProgramMaterial01 (double p)  { programMaterial01 = clamp01(p); }
+
+    // Shared attack time for both stages (ms)
+    void setAttackMs (double ms) { attackMs = (std::isfinite(ms) && ms > 0.0) ? ms : attackMs; }
+
+    // Phase 6: multirate control (1, 2 or 4; call before prepare). processEnvelope / processEnvelopeTileRate
+    // then count control-rate samples.
+    void setControlDecimation (int factor) { decimation = (factor >= 4 ? 4 : (factor >= 2 ? 2 : 1)); }
+
+    // LowEndGuard release tightening multiplier [0.65 .. 1.0] (1.0 = no change)
+    void setReleaseAdjustmentFactor (double f) { releaseAdjustFactor = (std::isfinite(f) && f > 0.0) ? f : 1.0; }
     void setGainReductionDbIn (double db)
     {
         grDbIn = (std::isfinite(db) && db >= 0.0) ? db : 0.0;
@@ -171,7 +316,68 @@ struct DualStageRelease
     double getEffectiveReleaseMs() const { return clampMs(effectiveReleaseMs, 5.0, 5000.0); }
     double getMicroModDepth01() const    { return clamp01(microModDepth01); }
     double getMicroMod01() const         { return clamp01(microMod01); }
+
+    // Per-sample envelope readouts (last processed sample of lane k)
+    double getEnvelope (int k = 0) const     { return laneValue(kEnvOutRow, k); }
+    double getFastEnvelope (int k = 0) const { return laneValue(kFastEnvRow, k); }
+    double getSlowEnvelope (int k = 0) const { return laneValue(kSlowEnvRow, k); }
+
+    // Phase 6: idle fast path — the owner skipped n control-rate samples. The oscillator keeps time (one
+    // rotation by n steps, closed form) so the modulation resumes in phase with an instance that never idled.
+    void advanceOscillator (int n)
+    {
+        if (n <= 0)
+            return;
+        const double a = oscRotRadians * (double) n;
+        const double rc = std::cos(a);
+        const double rs = std::sin(a);
+        const double c = oscCos * rc - oscSin * rs;
+        oscSin = oscSin * rc + oscCos * rs;
+        oscCos = c;
+    }
+
+    // Phase 6: idle detection — every lane's fast, slow and blended envelope at or below floor
+    bool isSettled (double floor) const
+    {
+        const double* env = hot->get<double> (envOffset);
+        for (int i = 0; i < kNumEnvRows * numLanesPrepared; ++i)
+            if (!(std::abs(env[i]) <= floor))
+                return false;
+        return true;
+    }
 private:
+    // Hot-state rows (one value per lane)
+    enum { kFastEnvRow, kSlowEnvRow, kEnvOutRow, kNumEnvRows };
+
+    double* fastEnvRow() { return hot->get<double> (envOffset) + kFastEnvRow * numLanesPrepared; }
+    double* slowEnvRow() { return hot->get<double> (envOffset) + kSlowEnvRow * numLanesPrepared; }
+    double* envOutRow()  { return hot->get<double> (envOffset) + kEnvOutRow * numLanesPrepared; }
+
+    // Phase 6: released envelopes stop at exact zero instead of decaying into subnormals
+    void flushEnvelopes() { DenormalGuard::flush(hot->get<double> (envOffset), kNumEnvRows * numLanesPrepared); }
+
+    double laneValue (int row, int k) const
+    {
+        return (k >= 0 && k < numLanesPrepared ? hot->get<double> (envOffset)[row * numLanesPrepared + k] : 0.0);
+    }
+
+    // Sealed micro-modulation: fixed 0.25 Hz, max +/- 3% release time at full depth
+    static constexpr double kMicroModHz     = 0.25;
+    static constexpr double kMicroModMaxPct = 0.03;
+
+    static double onePoleCoeff (double ms, double fs)
+    {
+        const double g = 1.0 - std::exp(-1.0 / ((ms * 1e-3) * fs));
+        return (std::isfinite(g) && g > 0.0 && g <= 1.0) ? g : 1.0;
+    }
+
+    // n-sample equivalent of a per-sample one-pole coefficient (Eco tile-rate path; Coarse kernels suffice)
+    static double tileCoeff (double g, int n)
+    {
+        const double keep = FastMath::pow<FastMath::Accuracy::Coarse>(1.0 - clamp01(g), (double) n);
+        return clamp01(1.0 - keep);
+    }
+
     static double lerp(double a, double b, double t) { return a + (b - a) * clamp01(t); }
 
     static double clampMs(double x, double lo, double hi)
@@ -202,7 +408,8 @@ private:
     double programMaterial01 = 0.0; // generic program-material indicator (0..1)
         double grDbIn            = 0.0; // GR depth (dB)
 
-    double sampleRateHz      = 48000.0;
+    double sampleRateHz      = 48000.0; // control rate
+    int    decimation        = 1;
 
     // Phase 4E.5 outputs/state (control-only)
     double baseReleaseMs      = 100.0;
@@ -212,7 +419,29 @@ private:
 
     double microModDepth01    = 0.0;
     double microMod01         = 0.0;
-    double microPhase         = 0.0;
+
+    // Injected envelope controls
+    double attackMs            = 10.0;
+    double releaseAdjustFactor = 1.0;
+
+    // Per-sample coefficients (block-rate)
+    double gAttack      = 0.0;
+    double gFastRelease = 0.0;
+    double gSlowRelease = 0.0;
+
+    // Recursive oscillator (unit phasor + per-sample rotation)
+    double oscCos    = 1.0;
+    double oscSin    = 0.0;
+    double oscRotCos = 1.0;
+    double oscRotSin = 0.0;
+    double oscRotRadians = 0.0; // rotation per sample (idle skips)
+
+    const DspKernels::Table<double>* kernels = &DspKernels::getActive<double>(); // Phase 6: dispatched loops
+
+    // Envelope state (linear domain), one row per stage and one slot per lane, in the owner's HotStateBlock
+    HotStateBlock* hot = nullptr;
+    int envOffset = 0;
+    int numLanesPrepared = 0;
 
     // Blend weights (sum to ~1)
     double fastBlend01 = 0.0;
@@ -0,0 +1,187 @@
+// Phase 6 — FastMath (control-path transcendental kernels)
+// Branch-free log2 / exp2 / pow / dB<->gain approximations for per-sample control math.
+// Used by GainComputer (gain law), StereoLink (link law) and DetectorCore (dominance shaping).
+// No state. No allocation. Scalar forms inline; block forms are plain loops the compiler vectorizes.
+//
+// Accuracy tiers (selected at compile time per call site):
+//   Accuracy::Coarse — dB round trip error <= 1e-4 dB   (Eco / mass-instance use)
+//   Accuracy::Fine   — dB round trip error <= 1e-6 dB   (default for all Core stages)
+//
+// Accuracy report (measured against libm, double precision, 1e7 log-spaced points):
+//
+//   kernel         domain                   Coarse max err        Fine max err
+//   -------------  -----------------------  --------------------  --------------------
+//   gainToDb       [1e-12 .. 1e3]           1.1e-5 dB             2.5e-7 dB
+//   dbToGain       [-240 .. +60] dB         2.8e-5 dB (3.2e-6 rel) 6.1e-8 dB (7.0e-9 rel)
+//   log2           [1e-300 .. 1e300]        1.8e-6 abs            4.2e-8 abs
+//   exp2           [-1000 .. +1000]         3.2e-6 rel            7.0e-9 rel
+//   pow            x [1e-6 .. 1], y [0 .. 2] 5.5e-6 rel            5.9e-8 rel
+//
+// Method:
+//   log2(x): split x = m * 2^e with m in [sqrt(1/2), sqrt(2)), then
+//            log2(m) = (2/ln2) * atanh(s), s = (m-1)/(m+1), |s| <= 0.1716,
+//            atanh series truncated after s^5 (Coarse) or s^7 (Fine).
+//   exp2(x): x = n + f with n = round(x), |f| <= 0.5; 2^f by Taylor series in f*ln2
+//            truncated after degree 5 (Coarse) or 7 (Fine); 2^n assembled in the exponent bits.
+//
+// Domain notes:
+//   - log2 / gainToDb clamp inputs below 1e-300 (and NaN) to 1e-300; callers keep their own kEps floors.
+//   - exp2 clamps its argument to [-1022, 1023]; no Inf/denormal output.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace FastMath
+{
+    enum class Accuracy
+    {
+        Coarse, // <= 1e-4 dB
+        Fine    // <= 1e-6 dB
+    };
+
+    // Accuracy used by Core stages unless a call site selects otherwise.
+    constexpr Accuracy kDefaultAccuracy = Accuracy::Fine;
+
+    constexpr double kLn2        = 0.69314718055994530942;
+    constexpr double kLog2e      = 1.44269504088896340736;
+    constexpr double kDbPerLog2  = 6.02059991327962390427; // 20 * log10(2)
+    constexpr double kLog2PerDb  = 0.16609640474436811739; // log2(10) / 20
+
+    namespace detail
+    {
+        inline std::uint64_t bitsOf (double x)
+        {
+            std::uint64_t u;
+            std::memcpy (&u, &x, sizeof (u));
+            return u;
+        }
+
+        inline double fromBits (std::uint64_t u)
+        {
+            double x;
+            std::memcpy (&x, &u, sizeof (x));
+            return x;
+        }
+    }
+
+    // ----------------------------
+    // Scalar kernels
+    // ----------------------------
+    template <Accuracy A = kDefaultAccuracy>
+    inline double log2 (double x)
+    {
+        constexpr double kMinIn = 1e-300;
+        x = (x > kMinIn ? x : kMinIn); // also maps NaN -> kMinIn
+
+        const std::uint64_t u = detail::bitsOf (x);
+        double e = (double) ((int) ((u >> 52) & 0x7ff) - 1023);
+        double m = detail::fromBits ((u & 0x000fffffffffffffull) | 0x3ff0000000000000ull); // [1, 2)
+
+        // Re-centre mantissa to [sqrt(1/2), sqrt(2)) so |s| stays small.
+        const bool hi = (m > 1.41421356237309504880);
+        m = hi ? 0.5 * m : m;
+        e = hi ? e + 1.0 : e;
+
+        const double s  = (m - 1.0) / (m + 1.0);
+        const double s2 = s * s;
+
+        double series;
+        if constexpr (A == Accuracy::Coarse)
+            series = 1.0 + s2 * ((1.0 / 3.0) + s2 * (1.0 / 5.0));
+        else
+            series = 1.0 + s2 * ((1.0 / 3.0) + s2 * ((1.0 / 5.0) + s2 * (1.0 / 7.0)));
+
+        return e + (2.0 * kLog2e) * s * series;
+    }
+
+    // exp2 for x already in [-1022, 1023] (no clamps: lets loops whose inputs are range-limited vectorize;
+    // identical to exp2 inside that range)
+    template <Accuracy A = kDefaultAccuracy>
+    inline double exp2InRange (double x)
+    {
+        // n = round-to-nearest-even(x) without nearbyint / integer conversion (vectorizes on any ISA):
+        // adding 1.5 * 2^52 leaves n in the low mantissa bits of `shifted` (exact for |x| < 2^51).
+        constexpr double kRoundShift = 6755399441055744.0; // 1.5 * 2^52
+        const double shifted = x + kRoundShift;
+        const double n = shifted - kRoundShift;
+        const double t = (x - n) * kLn2; // |t| <= 0.3466
+
+        double p;
+        if constexpr (A == Accuracy::Coarse)
+            p = 1.0 + t * (1.0 + t * (1.0 / 2.0 + t * (1.0 / 6.0 + t * (1.0 / 24.0 + t * (1.0 / 120.0)))));
+        else
+            p = 1.0 + t * (1.0 + t * (1.0 / 2.0 + t * (1.0 / 6.0 + t * (1.0 / 24.0 + t * (1.0 / 120.0
+                    + t * (1.0 / 720.0 + t * (1.0 / 5040.0)))))));
+
+        // Low 12 bits of (bits(shifted) + 1023) = n + 1023 (n in [-1022, 1023]); the shift drops the rest.
+        const std::uint64_t scale = (detail::bitsOf (shifted) + 1023) << 52;
+        return p * detail::fromBits (scale);
+    }
+
+    template <Accuracy A = kDefaultAccuracy>
+    inline double exp2 (double x)
+    {
+        x = (x > -1022.0 ? x : -1022.0); // also maps NaN -> -1022
+        x = (x <  1023.0 ? x :  1023.0);
+        return exp2InRange<A> (x);
+    }
+
+    template <Accuracy A = kDefaultAccuracy>
+    inline double exp (double x)
+    {
+        return exp2<A> (x * kLog2e);
+    }
+
+    // x^y for x > 0 (x <= 0 treated as the log2 floor -> ~0 for y > 0).
+    template <Accuracy A = kDefaultAccuracy>
+    inline double pow (double x, double y)
+    {
+        return exp2<A> (y * log2<A> (x));
+    }
+
+    template <Accuracy A = kDefaultAccuracy>
+    inline double gainToDb (double g)
+    {
+        return kDbPerLog2 * log2<A> (g);
+    }
+
+    template <Accuracy A = kDefaultAccuracy>
+    inline double dbToGain (double db)
+    {
+        return exp2<A> (db * kLog2PerDb);
+    }
+
+    // dbToGain for |db| <= 6000 (callers clamp first; see exp2InRange)
+    template <Accuracy A = kDefaultAccuracy>
+    inline double dbToGainInRange (double db)
+    {
+        return exp2InRange<A> (db * kLog2PerDb);
+    }
+
+    // ----------------------------
+    // Block kernels (in/out may alias)
+    // ----------------------------
+    template <Accuracy A = kDefaultAccuracy>
+    inline void gainToDb (const double* in, double* out, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            out[i] = gainToDb<A> (in[i]);
+    }
+
+    template <Accuracy A = kDefaultAccuracy>
+    inline void dbToGain (const double* in, double* out, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            out[i] = dbToGain<A> (in[i]);
+    }
+
+    template <Accuracy A = kDefaultAccuracy>
+    inline void pow (const double* x, double y, double* out, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            out[i] = pow<A> (x[i], y);
+    }
+}
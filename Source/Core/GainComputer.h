@@ -5,9 +5,17 @@
 #pragma once
 #include <JuceHeader.h>
 
+#include "ChannelGroups.h"
+#include "FastMath.h"
+#include "GainCurveTable.h"
+
 struct GainComputer
 {
-    void prepare (double, int) {}
+    void prepare (double, int)
+    {
+        curveTable.reset(ratio);
+    }
+
     void reset()
     {
         detectorLin = 0.0;
@@ -16,19 +24,19 @@ struct GainComputer
         // Phase 3 outputs (placeholders until GR law is implemented)
         grDb  = 0.0;
         grLin = 1.0;
+        tileGrMaxDb = 0.0;
     }
 
     // Phase 3: threshold shaping + soft knee + GR computation.
     // Phase 3.0A.2: plumbing only (NO DSP yet, NO audio modification).
-    void process (juce::AudioBuffer<float>&)
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>&)
 {
     // Phase 3B.1: Implement sealed GR law (control only; NO audio modification).
 
     // ---- Sealed constants ----
-    // Soft knee width (fixed): 12 dB
-    constexpr double kKneeWidthDb = 12.0;
-    // Hard safety clamp: Max GR = 24 dB (Safety & Anti-Artifact Constitution §8)
-    constexpr double kMaxGrDb = 24.0;
+    // Soft knee width (12 dB) and hard safety clamp (Max GR = 24 dB, Safety & Anti-Artifact Constitution §8)
+    // live with the tabulated law in GainCurveTable.
     // Log safety epsilon
     constexpr double kEps = 1e-12;
 
@@ -40,40 +48,77 @@ struct GainComputer
     double r = (std::isfinite(rIn) ? rIn : 1.0);
     if (r < 1.0) r = 1.0;
 
+    // Phase 6: rebuild the tabulated curve only when the smoothed ratio moves (amortized, lock-free swap)
+    curveTable.tick(r);
+
     // Detector in dB (detectorLin is linear amplitude-like)
     const double dLin = (std::isfinite(detectorLin) ? detectorLin : 0.0);
-    const double dDb  = 20.0 * std::log10(std::max(dLin, kEps));
-
-    // Delta above threshold
-    const double deltaDb = dDb - thrDb;
-
-    // Soft knee effective ratio (sealed):
-    // effective_ratio = 1 + (ratio - 1) * (1 - exp(-abs(delta)/12))
-    const double absDelta = std::abs(deltaDb);
-    const double kneeBlend = 1.0 - std::exp(-absDelta / kKneeWidthDb);
-    double effRatio = 1.0 + (r - 1.0) * kneeBlend;
-    if (!std::isfinite(effRatio) || effRatio < 1.0)
-        effRatio = 1.0;
-
-    // Core GR law (sealed):
-    // if detector_dB >= threshold_dB:
-    //   GR_dB = (deltaDb) * (1 - 1/effRatio)
-    // else:
-    //   GR_dB = 0
-    double gr = 0.0;
-    if (deltaDb >= 0.0 && effRatio > 1.0)
-        gr = deltaDb * (1.0 - (1.0 / effRatio));
+    const double dDb  = FastMath::gainToDb(std::max(dLin, kEps));
+
+    // Core GR law (sealed, tabulated): GR_dB = curve(detector_dB - threshold_dB)
+    // Block-rate estimate from the raw detector; processTile() refines the readouts from the released envelope.
+    double gr = computeGainReductionDb(dDb, thrDb);
 
     if (!std::isfinite(gr) || gr < 0.0) gr = 0.0;
-    if (gr > kMaxGrDb) gr = kMaxGrDb;
+    if (gr > GainCurveTable::kMaxGrDb) gr = GainCurveTable::kMaxGrDb;
 
     grDb = gr;
 
     // Linear gain from negative dB reduction
     // grLin = dbToGain(-grDb)
-    const double g = std::pow(10.0, (-grDb) / 20.0);
+    const double g = FastMath::dbToGain(-grDb);
     grLin = (std::isfinite(g) && g > 0.0 && g <= 1.0) ? g : 1.0;
+
+    // Restart per-sample readout tracking for this block's tiles
+    tileGrMaxDb = 0.0;
 }
+    // Per-sample GR (dB) from detector level (dB): table lookup + lerp (see GainCurveTable for error bounds).
+    double computeGainReductionDb (double detectorDb, double thrDb) const
+    {
+        return curveTable.lookupGrDb(detectorDb - thrDb);
+    }
+
+    // Phase 6: per-sample GR lanes (control only), one per channel.
+    // envLin = released envelope (linear), grDbOut = GR (dB, >= 0); may alias.
+    // Readouts (getGainReductionDb/Linear) track the deepest GR seen in any lane since the last process() call.
+    // A selects the dB kernel accuracy (QualityTier: Coarse for Eco).
+    // thresholdLaneDb (optional, n values shared by all lanes) = per-sample threshold automation; nullptr = the
+    // injected threshold. The curve follows the injected ratio per tile.
+    template <FastMath::Accuracy A = FastMath::kDefaultAccuracy>
+    void processTile (const ControlLanes& envLin, ControlLanes& grDbOut, int numLanes, int n,
+                      const double* thresholdLaneDb = nullptr)
+    {
+        constexpr double kEps = 1e-12;
+        double thrConst[ChannelGroups::kTileSize];
+        if (thresholdLaneDb == nullptr)
+        {
+            std::fill(thrConst, thrConst + n, thresholdDb);
+            thresholdLaneDb = thrConst;
+        }
+
+        curveTable.tick(ratio);
+
+        double grMax = tileGrMaxDb;
+        for (int k = 0; k < numLanes; ++k)
+        {
+            const double* e0 = envLin[k];
+            double* gr0 = grDbOut[k];
+            for (int i = 0; i < n; ++i)
+            {
+                const double e = e0[i];
+                const double dDb = FastMath::gainToDb<A>(e > kEps ? e : kEps);
+                double gr = computeGainReductionDb(dDb, thresholdLaneDb[i]);
+                gr = (gr > 0.0 ? gr : 0.0); // also maps NaN -> 0
+                gr0[i] = gr;
+                grMax = (gr > grMax ? gr : grMax);
+            }
+        }
+        tileGrMaxDb = grMax;
+
+        grDb = grMax;
+        grLin = FastMath::dbToGain(-grDb);
+    }
+
 // ----------------------------
     // Injection slots (NOT parameters)
     // ----------------------------
@@ -122,4 +167,8 @@ private:
     // Phase 3 gain reduction output placeholders
     double grDb  = 0.0;
     double grLin = 1.0;
+
+    // Phase 6: tabulated soft-knee law (double-buffered)
+    GainCurveTable curveTable;
+    double tileGrMaxDb = 0.0;
 };
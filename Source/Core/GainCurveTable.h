@@ -0,0 +1,154 @@
+// Phase 6 — GainCurveTable (sealed GR law, tabulated)
+// Interpolated lookup of the sealed soft-knee GR law: deltaDb (detector dB - threshold dB) -> GR dB.
+// Control-only. No audio modification. No allocation (fixed-size storage).
+//
+// Layout:
+// - The curve is indexed by deltaDb, so it depends on ratio only; threshold moves never force a rebuild.
+// - Two fixed tables (front/back). Lookups read the front table; rebuilds write the back table.
+// - Rebuild is triggered when the requested ratio moves more than kRatioEpsilon from the built ratio,
+//   and is amortized across calls (kPointsPerTick points per tick()). A finished back table is published
+//   with a single atomic index store (release); readers pick it up with an acquire load.
+// - If the ratio runs away from the built curve by more than kRatioForceEpsilon, the pending rebuild is
+//   completed in the same tick so the curve never lags far behind fast ratio automation.
+//
+// Interpolation error (linear, kNumPoints = 1025 over 0..96 dB, step 0.09375 dB):
+// - The table stores the unclamped law; the 24 dB GR clamp is applied after the lerp,
+//   so the clamp corner adds no error.
+// - Max |lerp - exact| over ratio 1..20: 2.8e-3 dB (worst at the knee origin, ratio 20).
+// - deltaDb beyond 96 dB falls back to the exact law.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+#include "FastMath.h"
+
+struct GainCurveTable
+{
+    static constexpr int    kNumPoints         = 1025;
+    static constexpr double kMaxDeltaDb        = 96.0;
+    static constexpr double kStepDb            = kMaxDeltaDb / (double) (kNumPoints - 1);
+    static constexpr double kInvStepDb         = 1.0 / kStepDb;
+    static constexpr int    kPointsPerTick     = 256;
+    static constexpr double kRatioEpsilon      = 1e-3;
+    static constexpr double kRatioForceEpsilon = 0.25;
+
+    // Sealed constants (shared with GainComputer)
+    static constexpr double kKneeWidthDb = 12.0; // soft knee width (fixed)
+    static constexpr double kMaxGrDb     = 24.0; // hard safety clamp
+
+    // Sealed GR law, unclamped:
+    // effective_ratio = 1 + (ratio - 1) * (1 - exp(-abs(delta)/12))
+    // GR_dB = delta * (1 - 1/effective_ratio) for delta >= 0, else 0
+    static double evaluateLawUnclamped (double deltaDb, double ratio)
+    {
+        if (!(deltaDb >= 0.0))
+            return 0.0;
+
+        const double kneeBlend = 1.0 - FastMath::exp(-deltaDb / kKneeWidthDb);
+        double effRatio = 1.0 + (ratio - 1.0) * kneeBlend;
+        if (!std::isfinite(effRatio) || effRatio <= 1.0)
+            return 0.0;
+
+        const double gr = deltaDb * (1.0 - (1.0 / effRatio));
+        return (std::isfinite(gr) && gr > 0.0) ? gr : 0.0;
+    }
+
+    static double evaluateLaw (double deltaDb, double ratio)
+    {
+        const double gr = evaluateLawUnclamped(deltaDb, ratio);
+        return (gr > kMaxGrDb ? kMaxGrDb : gr);
+    }
+
+    void reset (double ratio)
+    {
+        ratio = sanitizeRatio(ratio);
+        fill(tables[0], ratio, 0, kNumPoints);
+        tableRatio[0] = ratio;
+        tableRatio[1] = ratio;
+        buildPos = -1;
+        active.store(0, std::memory_order_release);
+    }
+
+    // Call once per block/tile with the current smoothed ratio (audio thread).
+    void tick (double ratio)
+    {
+        ratio = sanitizeRatio(ratio);
+        const int front = active.load(std::memory_order_relaxed);
+        const int back  = 1 - front;
+
+        if (buildPos < 0)
+        {
+            if (std::abs(ratio - tableRatio[front]) <= kRatioEpsilon)
+                return;
+
+            buildPos = 0;
+            tableRatio[back] = ratio;
+        }
+        else if (std::abs(ratio - tableRatio[back]) > kRatioEpsilon)
+        {
+            // Target moved mid-build: restart towards the newest ratio.
+            buildPos = 0;
+            tableRatio[back] = ratio;
+        }
+
+        const bool force = std::abs(tableRatio[back] - tableRatio[front]) > kRatioForceEpsilon;
+        const int end = force ? kNumPoints : std::min(kNumPoints, buildPos + kPointsPerTick);
+
+        fill(tables[back], tableRatio[back], buildPos, end);
+        buildPos = end;
+
+        if (buildPos >= kNumPoints)
+        {
+            buildPos = -1;
+            active.store(back, std::memory_order_release);
+        }
+    }
+
+    // Per-sample GR (dB) for a given deltaDb: table lookup + lerp, clamp applied after interpolation.
+    double lookupGrDb (double deltaDb) const
+    {
+        if (!(deltaDb > 0.0))
+            return 0.0;
+
+        const int front = active.load(std::memory_order_acquire);
+
+        if (deltaDb >= kMaxDeltaDb)
+            return evaluateLaw(deltaDb, tableRatio[front]);
+
+        const double x = deltaDb * kInvStepDb;
+        const int i = (int) x;
+        const double t = x - (double) i;
+        const auto& tbl = tables[(size_t) front];
+        const double gr = tbl[(size_t) i] + t * (tbl[(size_t) i + 1] - tbl[(size_t) i]);
+        return (gr > kMaxGrDb ? kMaxGrDb : gr);
+    }
+
+    double getTableRatio() const { return tableRatio[(size_t) active.load(std::memory_order_acquire)]; }
+    bool isRebuilding() const    { return buildPos >= 0; }
+
+private:
+    using Table = std::array<double, (size_t) kNumPoints + 1>; // +1 guard so lerp never reads past the end
+
+    static double sanitizeRatio (double r)
+    {
+        return (std::isfinite(r) && r >= 1.0) ? r : 1.0;
+    }
+
+    static void fill (Table& tbl, double ratio, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+            tbl[(size_t) i] = evaluateLawUnclamped((double) i * kStepDb, ratio);
+
+        if (end >= kNumPoints)
+            tbl[(size_t) kNumPoints] = tbl[(size_t) kNumPoints - 1];
+    }
+
+    std::array<Table, 2>  tables {};
+    std::array<double, 2> tableRatio { 1.0, 1.0 };
+    std::atomic<int>      active { 0 };
+    int                   buildPos = -1; // -1 = idle, else next point to build in the back table
+};
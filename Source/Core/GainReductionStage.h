@@ -1,13 +1,18 @@
 // Phase 3 Sealed DSP (ACTIVE): Gain reduction application stage.
 // No new parameters. No UI logic.
-// This stage applies computed GR (linear) to the audio buffer.
+// This stage applies computed GR (per-sample lanes, one per channel; optional fused M/S) to the audio buffer.
 
 #pragma once
 #include <JuceHeader.h>
 
+#include "ChannelGroups.h"
+#include "DspKernels.h"
+#include "FastMath.h"
+
+template <typename SampleType>
 struct GainReductionStage
 {
-    void prepare (double, int) {}
+    void prepare (double, int) { kernels = &DspKernels::getActive<SampleType>(); }
 
     void reset()
     {
@@ -18,28 +23,65 @@ struct GainReductionStage
 
     // Phase 1: no-op. Later: apply computed GR sample-accurate.
     // Phase 3B.2: apply GR linear to audio (sample-accurate).
-    void process (juce::AudioBuffer<float>& buffer)
+    // Phase 6: GR arrives as per-sample dB lanes, one per channel (lane ch scales channel ch).
+    // Mid/side mode: lanes 0/1 are the M and S gains; encode, gain and decode are fused into one pass:
+    //   L' = a*L + b*R, R' = b*L + a*R   with a = (gM + gS)/2, b = (gM - gS)/2
+    // A selects the dB -> gain kernel accuracy (QualityTier: Coarse for Eco).
+    template <FastMath::Accuracy A = FastMath::kDefaultAccuracy>
+    void processTile (juce::AudioBuffer<SampleType>& buffer, int startSample, const ControlLanes& grDbLanes, int n)
     {
-        const int numCh = buffer.getNumChannels();
-        const int numS  = buffer.getNumSamples();
-        if (numCh <= 0 || numS <= 0)
+        const int numCh = juce::jmin(buffer.getNumChannels(), ChannelGroups::kMaxLanes);
+        if (numCh <= 0 || n <= 0)
             return;
 
-        double g = grLin;
-        // Safety clamp: keep sane domain (0, 1]
-        if (!std::isfinite(g) || g <= 0.0 || g > 1.0)
-            g = 1.0;
+        alignas(64) SampleType gains[ChannelGroups::kMaxLanes][kMaxTileSize];
+        bool unity[ChannelGroups::kMaxLanes];
+        double lastDb = 0.0;
+        for (int ch = 0; ch < numCh; ++ch)
+        {
+            // Phase 6: unity fast path — a lane with no GR anywhere in the tile (0 dB or less, NaN) leaves
+            // its channel untouched
+            const double* lane = grDbLanes[ch];
+            double peakDb = 0.0;
+            for (int i = 0; i < n; ++i)
+                peakDb = (lane[i] > peakDb ? lane[i] : peakDb);
+            unity[ch] = !(peakDb > 0.0);
 
-        const float gf = (float) g;
+            // Safety clamp: keep sane domain (0, 1] (dB clamped to [0, kMaxGrDb], NaN -> 0)
+            if (!unity[ch])
+                kernels->template gainLane<A>(lane, gains[ch], n, kMaxGrDb);
+            lastDb = (lane[n - 1] > lastDb ? lane[n - 1] : lastDb);
+        }
 
-        for (int ch = 0; ch < numCh; ++ch)
+        int firstPlain = 0;
+        if (midSide && numCh >= 2)
         {
-            float* x = buffer.getWritePointer(ch);
-            for (int i = 0; i < numS; ++i)
-                x[i] *= gf;
+            if (!(unity[0] && unity[1]))
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                    if (unity[ch])
+                        std::fill_n(gains[ch], n, (SampleType) 1);
+                kernels->applyGainMidSide(buffer.getWritePointer(0, startSample),
+                                          buffer.getWritePointer(1, startSample), gains[0], gains[1], n);
+            }
+            firstPlain = 2;
         }
+
+        for (int ch = firstPlain; ch < numCh; ++ch)
+            if (!unity[ch])
+                kernels->applyGain(buffer.getWritePointer(ch, startSample), gains[ch], n);
+
+        // Readouts: deepest lane at the last sample of the tile
+        grDb  = juce::jlimit(0.0, kMaxGrDb, lastDb);
+        grLin = FastMath::dbToGain(-grDb);
     }
 
+    // Channels 0/1 carry M/S gain lanes (StereoMode::midSide)
+    void setMidSide (bool isMidSide) { midSide = isMidSide; }
+
+    // Largest tile processTile() accepts (matches CompressorPipeline::kControlTileSize)
+    static constexpr int kMaxTileSize = ChannelGroups::kTileSize;
+
     // ----------------------------
     // Injection slots (NOT parameters)
     // ----------------------------
@@ -61,7 +103,12 @@ struct GainReductionStage
     double getGainReductionLinear() const { return grLin; }
 
 private:
+    static constexpr double kMaxGrDb = 24.0; // Safety & Anti-Artifact Constitution §8
+
     // Phase 3 gain reduction values (plumbing only)
     double grDb  = 0.0;
     double grLin = 1.0;
+
+    bool midSide = false;
+    const DspKernels::Table<SampleType>* kernels = &DspKernels::getActive<SampleType>(); // Phase 6: dispatched loops
 };
@@ -0,0 +1,57 @@
+// Phase 6 — HotStateBlock (per-sample recursive state, one cache-aligned block per owner)
+// The filter memories and envelope values that every sample reads and writes live in one contiguous block
+// owned by the pipeline (or the multiband wrapper); coefficients, configuration and readouts stay in the
+// stages (cold: written at block rate or less).
+// - Laid out in prepare: the owner calls clear(numChannels), then each stage reserves its state in processing
+//   order, then the owner calls finish(). Every region starts on a cache line, and per-channel rows are packed
+//   at the prepared channel count (stride = getNumChannels()), so a stereo instance's detector state spans a
+//   few lines instead of rows sized for the largest bus.
+// - Stages keep byte offsets (stable when the block moves during layout) and resolve them once per block.
+// - Storage is a dedicated DspArena (kept apart from the instance's buffers so it stays small and dense).
+//   process() never allocates.
+// - Every row is zero at rest (filter memories, envelopes, GR in dB), so clearState() puts the whole block
+//   in its digital-silence steady state (idle fast path).
+
+#pragma once
+
+#include "DspArena.h"
+
+struct HotStateBlock
+{
+    static constexpr int kCacheLineBytes = DspArena::kAlignment;
+
+    // Owner prepare, before the stages reserve: drops the layout and sets the per-channel row stride
+    // (1 .. kMaxChannels; 0 until laid out: rows are empty, stages process no channels)
+    void clear (int numChannelsToUse) { storage.clear(numChannelsToUse); }
+
+    int getNumChannels() const { return storage.getNumChannels(); }
+
+    // Stage prepare: count value-initialized (zero) T, starting on a cache line. Returns the region's offset.
+    template <typename T>
+    int reserve (int count) { return storage.reserve<T> (count, "hot state"); }
+
+    // Owner prepare, after the last reserve
+    void finish() { storage.finish(); }
+
+    // Audio thread: zero every laid-out row (no allocation)
+    void clearState()
+    {
+        if (storage.getNumBytes() > 0)
+            std::memset(storage.get<unsigned char> (0), 0, storage.getNumBytes());
+    }
+
+    template <typename T>
+    T* get (int offset) { return storage.get<T> (offset); }
+
+    template <typename T>
+    const T* get (int offset) const { return storage.get<T> (offset); }
+
+    // Bytes laid out by the current prepare (the instance's hot working set)
+    size_t getNumBytes() const { return storage.getNumBytes(); }
+    int getNumCacheLines() const { return (int) (storage.getNumBytes() / (size_t) kCacheLineBytes); }
+
+    void addFootprint (MemoryFootprint& footprint) const { storage.addFootprint(footprint); }
+
+private:
+    DspArena storage;
+};
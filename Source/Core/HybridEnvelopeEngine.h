@@ -5,16 +5,16 @@
 #pragma once
 #include <JuceHeader.h>
 
+#include "SmootherBank.h"
+
 struct HybridEnvelopeEngine
 {
     void prepare (double sr, int)
     {
         sampleRate = (sr > 0.0 ? sr : 48000.0);
 
-        // Weight smoothing law (sealed): one-pole LPF τ = 0.4 ms
-        setOnePoleTimeConstantSeconds(wSmootherSustained, 0.0004);
-        setOnePoleTimeConstantSeconds(wSmootherBalanced,  0.0004);
-        setOnePoleTimeConstantSeconds(wSmootherFast,  0.0004);
+        // Weight smoothing law (sealed): one-pole LPF τ = 0.4 ms (Phase 6: three slots in the owner's SmootherBank)
+        weightSlot = smoothers->add(0.0004, 1.0 / 3.0, kNumWeights);
 
         reset();
     }
@@ -38,16 +38,17 @@ struct HybridEnvelopeEngine
         wFast  = 1.0 / 3.0;
 
         // Reset smoothers to current values
-        wSmootherSustained.reset(wSustained);
-        wSmootherBalanced.reset(wBalanced);
-        wSmootherFast.reset(wFast);
+        smoothers->set(weightSlot + kSustained, wSustained);
+        smoothers->set(weightSlot + kBalanced,  wBalanced);
+        smoothers->set(weightSlot + kFast,      wFast);
 
         grEnv = 0.0;
     }
 
     // Phase 2: Weighting + blend implementation only.
     // No harmonic engine. No gain computer. No GR application. No audio modification.
-    void process (juce::AudioBuffer<float>&)
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>&)
     {
         const double A = clamp01(attackNorm);
         const double R = clamp01(releaseNorm);
@@ -68,9 +69,13 @@ struct HybridEnvelopeEngine
         double nFast  = (sum > 0.0 ? (wFastRaw  / sum) : (1.0 / 3.0));
 
         // One-pole LPF τ = 0.4 ms (sealed)
-        wSustained = wSmootherSustained.process(nSustained);
-        wBalanced  = wSmootherBalanced.process(nBalanced);
-        wFast  = wSmootherFast.process(nFast);
+        smoothers->setTarget(weightSlot + kSustained, nSustained);
+        smoothers->setTarget(weightSlot + kBalanced,  nBalanced);
+        smoothers->setTarget(weightSlot + kFast,      nFast);
+        smoothers->step(weightSlot, kNumWeights);
+        wSustained = smoothers->get(weightSlot + kSustained);
+        wBalanced  = smoothers->get(weightSlot + kBalanced);
+        wFast      = smoothers->get(weightSlot + kFast);
 
         // Envelopes (Phase 2 constitutional-safe placeholder: no invented envelope equations)
         // All three responses receive detectorLin equally for now.
@@ -85,6 +90,19 @@ struct HybridEnvelopeEngine
             grEnv = 0.0;
     }
 
+    // Phase 6: hybrid blend per lane (channel), using the weights from the last process() call.
+    // detLin/envOut hold one value per lane (envOut may alias detLin).
+    void blendLanes (const double* detLin, double* envOut, int numLanes) const
+    {
+        for (int k = 0; k < numLanes; ++k)
+        {
+            // Same placeholder responses as process(): every response receives the lane's detector
+            const double d = detLin[k];
+            const double e = wSustained * d + wBalanced * d + wFast * d;
+            envOut[k] = (std::isfinite(e) && e > 0.0) ? e : 0.0;
+        }
+    }
+
     // ----------------------------
     // Injection slots (NOT parameters)
     // ----------------------------
@@ -93,6 +111,9 @@ struct HybridEnvelopeEngine
     void setReleaseNormalized (double r) { releaseNorm = clamp01(r); } // R
     void setCrestNormalized (double c) { crestNorm = clamp01(c); }     // C
 
+    // Phase 6: owner's smoother bank (not owned). Attach before prepare(); slots are added there.
+    void setSmootherBank (SmootherBank& bank) { smoothers = &bank; }
+
     // ----------------------------
     // Readouts
     // ----------------------------
@@ -107,20 +128,6 @@ struct HybridEnvelopeEngine
     double getHybridEnv() const { return grEnv; }
 
 private:
-    // One-pole smoother: y[n] = y[n-1] + g * (x - y[n-1])
-    struct OnePole
-    {
-        void setCoeff(double gIn) { g = gIn; }
-        void reset(double v = 0.0) { z = v; }
-        double process(double x)
-        {
-            z += g * (x - z);
-            return z;
-        }
-        double g = 0.0;
-        double z = 0.0;
-    };
-
     static double clamp01(double x)
     {
         if (x < 0.0) return 0.0;
@@ -128,16 +135,6 @@ private:
         return x;
     }
 
-    void setOnePoleTimeConstantSeconds(OnePole& op, double tauSeconds)
-    {
-        // g = 1 - exp(-1/(tau*fs))
-        const double fs = (sampleRate > 0.0 ? sampleRate : 48000.0);
-        const double tau = (tauSeconds > 0.0 ? tauSeconds : 1e-3);
-        const double g = 1.0 - std::exp(-1.0 / (tau * fs));
-        op.setCoeff(g);
-        op.reset(1.0 / 3.0);
-    }
-
     double sampleRate = 48000.0;
 
     // Injected inputs
@@ -146,10 +143,10 @@ private:
     double releaseNorm = 0.5; // R
     double crestNorm   = 0.5; // C
 
-    // Weight smoothers (τ = 0.4 ms)
-    OnePole wSmootherSustained;
-    OnePole wSmootherBalanced;
-    OnePole wSmootherFast;
+    // Weight smoothers (τ = 0.4 ms): consecutive SmootherBank slots from weightSlot
+    enum { kSustained, kBalanced, kFast, kNumWeights };
+    SmootherBank* smoothers = nullptr;
+    int weightSlot = SmootherBank::kScratchSlot;
 
     // Smoothed weights (sum ~ 1)
     double wSustained = 1.0 / 3.0;
@@ -7,9 +7,13 @@
 
 struct InputConditioning
 {
+    // Phase 6: placeholder body; CompressorPipeline compiles the process() call away (StageList::runStage)
+    static constexpr bool kIsNoOp = true;
+
     void prepare (double, int) {}
     void reset() {}
 
     // DC block + anti-zipper buffer later. Phase 1 = no-op.
-    void process (juce::AudioBuffer<float>&) {}
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>&) {}
 };
@@ -0,0 +1,262 @@
+// Phase 6 — KeyBus (in-process inter-instance sidechain)
+// Process-wide registry of named "key buses". One instance publishes its pre-compression detector signal;
+// any number of instances subscribe to it as their DetectorCore key (via DetectorSplit's external key slot).
+//
+// Threading:
+// - acquire()/release() (registration) take a mutex and may allocate; call them off the audio thread.
+// - publish() is called by exactly one producer audio thread per bus; read() by any number of consumer
+//   audio threads. Both are lock-free, wait-free and allocation-free.
+//
+// Ring layout:
+// - Broadcast ring of kCapacity frames x kMaxChannels; the producer never waits for consumers.
+// - Every published block carries a timeline timestamp (samples). Contiguous blocks extend the current
+//   segment; a timestamp discontinuity (transport jump) starts a new segment.
+// - Segment metadata is published under a sequence lock (odd = write in progress). Ring frames are relaxed
+//   atomics (plain loads / stores on every target we ship), so a reader racing the producer reads stale or
+//   new frames, never undefined ones, and the validation step decides whether to use them.
+//
+// Clock alignment / underrun:
+// - A consumer asks for the frames at its own block timestamp. If the producer has not reached that
+//   time yet (hosts run tracks in parallel in any order), the newest frames are used instead, provided the
+//   lag stays within maxLagSamples. Otherwise read() fails and the caller falls back to its main input.
+// - Frames that were (or may have been) overwritten while copying also fail the read. The check assumes the
+//   largest block the producer can have in flight (kMaxBlock), not the reader's own block size: a producer
+//   publishing larger blocks than the reader reads must not go undetected.
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+struct KeyBus
+{
+    static constexpr int kMaxChannels   = 2;
+    static constexpr int kCapacity      = 1 << 15; // frames (~0.68 s @ 48 kHz)
+    static constexpr int kMaxNameLength = 32;
+    static constexpr int kMaxBlock      = kCapacity / 2; // largest block publish() / read() accept
+
+    // Producer side (one audio thread per bus). src channels beyond kMaxChannels are ignored;
+    // a mono source is duplicated to both key channels. The ring is float for either precision.
+    template <typename SampleType>
+    void publish (const juce::AudioBuffer<SampleType>& src, std::int64_t timestamp)
+    {
+        const int n = src.getNumSamples();
+        const int srcCh = src.getNumChannels();
+        if (n <= 0 || srcCh <= 0 || n > kMaxBlock)
+            return;
+
+        const std::int64_t pos = writePos.load(std::memory_order_relaxed);
+        const std::uint32_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        // Continue the current segment, or start a new one on a timestamp discontinuity
+        if (timestamp != timeOffset.load(std::memory_order_relaxed) + pos)
+        {
+            segmentStart.store(pos, std::memory_order_relaxed);
+            timeOffset.store(timestamp - pos, std::memory_order_relaxed);
+        }
+
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            const SampleType* x = src.getReadPointer(ch < srcCh ? ch : srcCh - 1);
+            std::atomic<float>* ring = storage.get() + (size_t) ch * kCapacity;
+            const int first = (int) (pos & kMask);
+            const int n1 = juce::jmin(n, kCapacity - first);
+            copySamples(ring + first, x, n1);
+            copySamples(ring, x + n1, n - n1);
+        }
+
+        writePos.store(pos + n, std::memory_order_relaxed);
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    // Consumer side (any audio thread). timestamp < 0 = "newest frames" (no host timeline available).
+    // Returns false on underrun / gap / overwrite; dest is then left unspecified and must not be used.
+    template <typename SampleType>
+    bool read (std::int64_t timestamp, juce::AudioBuffer<SampleType>& dest, int maxLagSamples) const
+    {
+        const int n = dest.getNumSamples();
+        const int destCh = dest.getNumChannels();
+        if (n <= 0 || destCh <= 0 || n > kMaxBlock)
+            return false;
+
+        const std::uint32_t s1 = seq.load(std::memory_order_acquire);
+        if ((s1 & 1u) != 0)
+            return false; // producer mid-publish; do not wait
+
+        const std::int64_t wp  = writePos.load(std::memory_order_relaxed);
+        const std::int64_t off = timeOffset.load(std::memory_order_relaxed);
+        const std::int64_t seg = segmentStart.load(std::memory_order_relaxed);
+
+        std::int64_t start = (timestamp >= 0 ? timestamp - off : wp - n);
+        if (start + n > wp)
+        {
+            // Producer not there yet: accept the newest frames if the lag is bounded
+            if (start + n - wp > (std::int64_t) maxLagSamples)
+                return false;
+            start = wp - n;
+        }
+
+        // Must be inside the current segment and not older than the ring (keep one block of headroom)
+        const std::int64_t oldest = juce::jmax(seg, wp - (std::int64_t) kCapacity + (std::int64_t) n);
+        if (start < oldest)
+            return false;
+
+        for (int ch = 0; ch < destCh; ++ch)
+        {
+            const std::atomic<float>* ring = storage.get() + (size_t) juce::jmin(ch, kMaxChannels - 1) * kCapacity;
+            SampleType* y = dest.getWritePointer(ch);
+            const int first = (int) (start & kMask);
+            const int n1 = juce::jmin(n, kCapacity - first);
+            copySamples(y, ring + first, n1);
+            copySamples(y + n1, ring, n - n1);
+        }
+
+        // Validate: if the producer advanced meanwhile, our frames must be older than anything it may have
+        // been writing. Any frame we copied from a later block makes its start (<= wp2) visible here, and a
+        // block in flight at wp2 overwrites up to kMaxBlock frames past it, i.e. frames before
+        // wp2 + kMaxBlock - kCapacity.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) != s1)
+        {
+            const std::int64_t wp2 = writePos.load(std::memory_order_relaxed);
+            if (start < wp2 + (std::int64_t) kMaxBlock - (std::int64_t) kCapacity)
+                return false;
+        }
+        return true;
+    }
+
+    const char* getName() const       { return name; }
+    int getNumPublishers() const      { return publishers.load(std::memory_order_relaxed); }
+    int getNumSubscribers() const     { return subscribers.load(std::memory_order_relaxed); }
+
+private:
+    friend struct KeyBusRegistry;
+
+    static constexpr std::int64_t kMask = kCapacity - 1;
+
+    // Ring access: relaxed atomic frames (the double path converts to / from the float ring)
+    template <typename Src>
+    static void copySamples (std::atomic<float>* dest, const Src* src, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            dest[i].store((float) src[i], std::memory_order_relaxed);
+    }
+
+    template <typename Dest>
+    static void copySamples (Dest* dest, const std::atomic<float>* src, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            dest[i] = (Dest) src[i].load(std::memory_order_relaxed);
+    }
+
+    char name[kMaxNameLength] {};
+    int refCount = 0; // guarded by the registry mutex
+    std::atomic<int> publishers { 0 };
+    std::atomic<int> subscribers { 0 };
+
+    std::unique_ptr<std::atomic<float>[]> storage; // kMaxChannels * kCapacity, allocated at first registration
+
+    std::atomic<std::uint32_t> seq { 0 };
+    std::atomic<std::int64_t>  writePos { 0 };
+    std::atomic<std::int64_t>  timeOffset { 0 };
+    std::atomic<std::int64_t>  segmentStart { 0 };
+};
+
+// Process-wide registry (fixed slot pool; storage is kept for reuse, so re-registration never allocates)
+struct KeyBusRegistry
+{
+    static constexpr int kMaxBuses = 16;
+
+    enum class Role { publisher, subscriber };
+
+    static KeyBusRegistry& getInstance()
+    {
+        static KeyBusRegistry registry;
+        return registry;
+    }
+
+    // Off the audio thread. Returns nullptr if the name is empty, or all slots are in use,
+    // or a publisher is requested for a bus that already has one. Names are kept (and matched) to their first
+    // kMaxNameLength - 1 bytes.
+    KeyBus* acquire (const char* busName, Role role)
+    {
+        if (busName == nullptr || busName[0] == '\0')
+            return nullptr;
+
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        KeyBus* bus = find(busName);
+        if (bus == nullptr)
+        {
+            for (auto& slot : slots)
+            {
+                if (slot.refCount == 0)
+                {
+                    bus = &slot;
+                    std::strncpy(bus->name, busName, KeyBus::kMaxNameLength - 1);
+                    bus->name[KeyBus::kMaxNameLength - 1] = '\0';
+                    if (bus->storage == nullptr)
+                        bus->storage.reset(new std::atomic<float>[(size_t) KeyBus::kMaxChannels * KeyBus::kCapacity]());
+                    bus->seq.store(0, std::memory_order_relaxed);
+                    bus->writePos.store(0, std::memory_order_relaxed);
+                    bus->timeOffset.store(0, std::memory_order_relaxed);
+                    bus->segmentStart.store(0, std::memory_order_relaxed);
+                    break;
+                }
+            }
+            if (bus == nullptr)
+                return nullptr;
+        }
+
+        if (role == Role::publisher)
+        {
+            if (bus->publishers.load(std::memory_order_relaxed) > 0)
+                return nullptr; // one producer per bus (SPSC per consumer)
+            bus->publishers.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            bus->subscribers.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ++bus->refCount;
+        return bus;
+    }
+
+    // Off the audio thread. The caller must guarantee its audio thread no longer uses the bus.
+    void release (KeyBus* bus, Role role)
+    {
+        if (bus == nullptr)
+            return;
+
+        const std::lock_guard<std::mutex> lock (mutex);
+        if (role == Role::publisher)
+            bus->publishers.fetch_sub(1, std::memory_order_relaxed);
+        else
+            bus->subscribers.fetch_sub(1, std::memory_order_relaxed);
+
+        if (--bus->refCount == 0)
+            bus->name[0] = '\0';
+    }
+
+private:
+    KeyBusRegistry() = default;
+
+    KeyBus* find (const char* busName)
+    {
+        for (auto& slot : slots)
+            if (slot.refCount > 0 && std::strncmp(slot.name, busName, KeyBus::kMaxNameLength - 1) == 0)
+                return &slot;
+        return nullptr;
+    }
+
+    std::mutex mutex;
+    std::array<KeyBus, kMaxBuses> slots;
+};
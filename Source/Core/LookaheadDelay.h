@@ -0,0 +1,86 @@
+// Phase 6 — LookaheadDelay (audio path)
+// Fixed per-channel delay applied to the main audio just before gain reduction, so GR computed from the
+// undelayed detector lands ahead of the transient it reacts to. The delay is reported as plugin latency.
+// setDelayMs() before prepare(); prepare() reserves the delay lines in the owner's DspArena (one line per
+// arena channel), process() does not allocate. 0 ms = pass-through.
+// setDelaySamples() sets an exact delay instead (e.g. to align a dry path with a reported latency).
+
+#pragma once
+#include <JuceHeader.h>
+
+#include "ChannelGroups.h"
+#include "DspArena.h"
+
+template <typename SampleType>
+struct LookaheadDelay
+{
+    // Owner's arena (not owned) and the stage name its lines are reported under. Attach before prepare().
+    void setArena (DspArena& owner, const char* stageName)
+    {
+        arena = &owner;
+        stage = stageName;
+    }
+
+    void setDelayMs (double ms) { delayMs = (std::isfinite(ms) && ms > 0.0 ? ms : 0.0); }
+
+    void prepare (double sampleRate, int)
+    {
+        const double fs = (sampleRate > 0.0 ? sampleRate : 48000.0);
+        setDelaySamples((int) std::lround(delayMs * 0.001 * fs));
+    }
+
+    // Off the audio thread, during the owner's arena layout (reserves new lines); overrides the ms setting
+    // until the next prepare()
+    void setDelaySamples (int numSamples)
+    {
+        delaySamples = juce::jmax(0, numSamples);
+        numChannels = arena->getNumChannels();
+        if (delaySamples > 0)
+            linesOffset = arena->reserve<SampleType> (numChannels * delaySamples, stage);
+        reset();
+    }
+
+    void reset()
+    {
+        if (delaySamples > 0)
+            std::fill_n(arena->get<SampleType> (linesOffset), numChannels * delaySamples, (SampleType) 0);
+        writePos = 0;
+    }
+
+    int getDelaySamples() const { return delaySamples; }
+
+    // Channels past the arena's channel count pass undelayed
+    void process (juce::AudioBuffer<SampleType>& buffer)
+    {
+        const int d = delaySamples;
+        const int n = buffer.getNumSamples();
+        const int numCh = juce::jmin(buffer.getNumChannels(), numChannels);
+        if (d <= 0 || n <= 0)
+            return;
+
+        SampleType* const lines = arena->get<SampleType> (linesOffset);
+        for (int ch = 0; ch < numCh; ++ch)
+        {
+            SampleType* x = buffer.getWritePointer(ch);
+            SampleType* line = lines + ch * d;
+            int w = writePos;
+            for (int i = 0; i < n; ++i)
+            {
+                const SampleType delayed = line[w];
+                line[w] = x[i];
+                x[i] = delayed;
+                w = (w + 1 < d ? w + 1 : 0);
+            }
+        }
+        writePos = (int) ((writePos + n) % d);
+    }
+
+private:
+    DspArena* arena = nullptr;
+    const char* stage = "LookaheadDelay";
+    int linesOffset = 0;
+    int numChannels = 0;
+    double delayMs = 0.0;
+    int delaySamples = 0;
+    int writePos = 0;
+};
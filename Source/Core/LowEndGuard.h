@@ -23,7 +23,8 @@ struct LowEndGuard
     }
 
     // Phase 4A.3: sealed control law active. MUST NOT modify audio.
-    void process (juce::AudioBuffer<float>&)
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>&)
     {
         // Phase 4A.3 sealed law (outputs-only): compute guard recommendations.
         // MUST NOT modify audio in this phase.
@@ -0,0 +1,394 @@
+// Phase 6 — MultibandCompressor
+// CrossoverNetwork -> one full CompressorPipeline per band -> band sum -> OutputStage (once, on the sum).
+// Mastering tier: the always-engaged oversampled safety stage also runs once on the sum, so the reported
+// latency matches the single-band pipeline of the same tier.
+// No parameters. No UI. prepare() allocates; process() does not.
+//
+// - Bands run on BandWorkerPool (the audio thread participates). Blocks shorter than kMinParallelBlockSize
+//   run serially: below that, dispatch + wake-up latency costs more than the band work it spreads
+//   (tests/bench_band_pool measures the crossover on a given machine).
+// - Nothing is allocated until prepare(): an owner that does not run multiband never prepares it (no band
+//   pipelines, no band buffers, no worker threads), and releaseResources() frees all three again.
+// - Band pipelines keep their own control state (detector, envelopes, GR) and share the injected controls;
+//   per-band overrides are available through getBand().
+// - An external key (sidechain) is full-band and drives every band's detector.
+// - Idle fast path (CompressorPipeline::kIdleFloor): once every band pipeline is idle and the sum stages have
+//   drained, quiet blocks skip the crossover, bands and sum stages (band ramps keep time) and pass their input
+//   through, delayed by the reported latency (a band-lookahead line of its own + the sum oversampler's dry
+//   delay). Idle is only entered after latency + one tile of quiet input, so whatever the delay lines hold
+//   when the path switches is at or below the floor too.
+// - Band buffers and the band pipelines' buffers come from one DspArena (the wrapper's own until an owner
+//   attaches the instance's with setArena()).
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+#include <memory>
+
+#include "BandWorkerPool.h"
+#include "CompressorPipeline.h"
+#include "CrossoverNetwork.h"
+
+template <typename SampleType, QualityTier Tier = QualityTier::standard>
+struct MultibandCompressor
+{
+    using Buffer   = juce::AudioBuffer<SampleType>;
+    using Pipeline = CompressorPipeline<SampleType, Tier>;
+
+    static constexpr int kMaxBands             = CrossoverNetwork<SampleType>::kMaxBands;
+    static constexpr int kMinParallelBlockSize = 256;
+
+    // Crossover and sum-stage smoothers and hot state live in this wrapper's bank and block (band pipelines
+    // keep their own)
+    MultibandCompressor()
+    {
+        arena = &localArena;
+        oversamplingAndSafety.setArena(localArena);
+        idleAlign.setArena(localArena, "multiband idle align");
+        crossover.setHotState(hotState);
+        outputStage.setHotState(hotState);
+        crossover.setSmootherBank(smoothers);
+        oversamplingAndSafety.setSmootherBank(smoothers);
+    }
+
+    // Instance arena (not owned; off the audio thread, before prepare). The owner clears it before and finishes
+    // it after prepare().
+    void setArena (DspArena& instanceArena)
+    {
+        arena = &instanceArena;
+        oversamplingAndSafety.setArena(instanceArena);
+        idleAlign.setArena(instanceArena, "multiband idle align");
+    }
+
+    // Off the audio thread (allocates band pipelines and realtime worker threads; lays out band buffers in the
+    // arena).
+    void prepare (double sampleRate, int maxBlockSize, int numChannels)
+    {
+        maxBlock = juce::jmax(1, maxBlockSize);
+        numCh    = juce::jlimit(1, ChannelGroups::kMaxChannels, numChannels);
+
+        smoothers.clear();
+        hotState.clear(numCh);
+        if (arena == &localArena)
+            localArena.clear(numCh);
+        crossover.prepare(sampleRate);
+        for (int b = 0; b < kMaxBands; ++b)
+        {
+            if (bands[(size_t) b] == nullptr)
+                bands[(size_t) b] = std::make_unique<Pipeline>();
+
+            bands[(size_t) b]->setArena(*arena);
+            bands[(size_t) b]->setOutputStagesEnabled(false);
+            bands[(size_t) b]->prepare(sampleRate, maxBlock);
+        }
+        bandBufferOffset = arena->reserve<SampleType> (kMaxBands * numCh * maxBlock, "multiband band buffers");
+        idleAlign.setDelaySamples(bands[0]->getLatencySamples()); // band lookahead (band sum stages are off)
+        outputStage.prepare(sampleRate, maxBlock);
+
+        if constexpr (TierTraits<Tier>::alwaysOversample)
+        {
+            oversamplingAndSafety.setQuality(TierTraits<Tier>::linearPhaseOs, true);
+            oversamplingAndSafety.prepare(sampleRate, maxBlock);
+            oversamplingAndSafety.preallocate(numCh);
+        }
+        smoothers.prepare(sampleRate);
+
+        hotState.finish();
+        if (arena == &localArena)
+            localArena.finish();
+
+        idleHoldSamples = getLatencySamples() + ChannelGroups::kTileSize;
+        resetIdle();
+
+        if (workerCount < 0)
+            pool.start(kMaxBands - 1, maxBlock, sampleRate);
+        else
+            pool.start(workerCount, maxBlock, sampleRate, false);
+        prepared = true;
+    }
+
+    // Off the audio thread: joins the workers and frees the band pipelines (prepare() recreates both)
+    void releaseResources()
+    {
+        prepared = false;
+        pool.stop();
+        for (auto& band : bands)
+            band.reset();
+    }
+
+    bool isPrepared() const { return prepared; }
+
+    // Tests / diagnostics (off the audio thread; applies at the next prepare()): exact band worker count,
+    // spare cores or not. -1 (default) = kMaxBands - 1, capped to the spare cores.
+    void setWorkerCount (int n) { workerCount = juce::jlimit(-1, BandWorkerPool::kMaxWorkers, n); }
+
+    void reset()
+    {
+        smoothers.resetClock();
+        crossover.reset();
+        for (auto& band : bands)
+            if (band != nullptr)
+                band->reset();
+        outputStage.reset();
+        if constexpr (TierTraits<Tier>::alwaysOversample)
+            oversamplingAndSafety.reset();
+        resetIdle();
+    }
+
+    // ----------------------------
+    // Injection slots (NOT parameters) — block-rate, audio thread
+    // ----------------------------
+    void setNumBands (int n)                  { crossover.setNumBands(n); }
+    void setCrossoverHz (int x, double hz)    { crossover.setCrossoverHz(x, hz); }
+
+    void setControlTargets (double thresholdDb, double ratio, double attackMs, double releaseMs)
+    {
+        for (auto& band : bands)
+            if (band != nullptr)
+                band->setControlTargets(thresholdDb, ratio, attackMs, releaseMs);
+    }
+
+    void setStereoMode (StereoMode mode)
+    {
+        for (auto& band : bands)
+            if (band != nullptr)
+                band->setStereoMode(mode);
+    }
+
+    // Phase 6: CPU governor level, forwarded to every band and the sum stage
+    void setDegradationLevel (int level)
+    {
+        for (auto& band : bands)
+            if (band != nullptr)
+                band->setDegradationLevel(level);
+        oversamplingAndSafety.setShed(level >= CpuGovernor::kShedOversampling);
+    }
+
+    // Off the audio thread (same contract as CompressorPipeline::setLinkGroups)
+    void setLinkGroups (const LinkGroupMap& map)
+    {
+        for (auto& band : bands)
+        {
+            if (band == nullptr)
+                band = std::make_unique<Pipeline>();
+            band->setLinkGroups(map);
+        }
+    }
+
+    void process (Buffer& buffer, const Buffer* sidechain = nullptr)
+    {
+        const int chs = juce::jmin(buffer.getNumChannels(), numCh);
+        const int numS = buffer.getNumSamples();
+        if (chs <= 0 || numS <= 0 || !prepared)
+            return;
+
+        // Phase 6: idle fast path (same rule as CompressorPipeline, with every active band idle)
+        const bool quiet = Pipeline::isQuiet(&buffer) && Pipeline::isQuiet(sidechain);
+        if (quiet && (idle || (quietSamples >= idleHoldSamples && outputQuiet && allBandsIdle())))
+        {
+            if (!idle)
+            {
+                hotState.clearState();
+                idleAlign.reset();
+            }
+            idle = true;
+            for (int b = 0; b < crossover.getNumBands(); ++b)
+                bands[(size_t) b]->skipIdleBlock(numS);
+            idleAlign.process(buffer);
+            if constexpr (TierTraits<Tier>::alwaysOversample)
+                oversamplingAndSafety.processIdle(buffer);
+            return;
+        }
+        idle = false;
+
+        // Hosts may exceed the prepared block size: process in prepared-size chunks (views, no allocation)
+        for (int start = 0; start < numS; start += maxBlock)
+        {
+            const int n = juce::jmin(maxBlock, numS - start);
+
+            Buffer chunk (buffer.getArrayOfWritePointers(), chs, start, n);
+            Buffer keyChunk;
+            const Buffer* key = nullptr;
+            if (sidechain != nullptr && sidechain->getNumSamples() == numS && sidechain->getNumChannels() > 0)
+            {
+                keyChunk.setDataToReferTo(const_cast<SampleType* const*> (sidechain->getArrayOfReadPointers()),
+                                          sidechain->getNumChannels(), start, n);
+                key = &keyChunk;
+            }
+
+            // Sum stages run per chunk too: the oversampler is prepared for maxBlock, and the smoothers
+            // advance with the chunk they filter
+            smoothers.beginBlock(n);
+            processChunk(chunk, key);
+            outputStage.process(chunk);
+            if constexpr (TierTraits<Tier>::alwaysOversample)
+                oversamplingAndSafety.process(chunk);
+        }
+
+        quietSamples = (quiet ? juce::jmin(quietSamples + numS, idleHoldSamples) : 0);
+        outputQuiet = quiet && Pipeline::isQuiet(&buffer);
+    }
+
+    bool isIdle() const { return idle; }
+
+    // Phase 6: meter readouts of the last processed block: deepest band GR, strongest band link, and the sum
+    // stage's oversampling engage (Mastering; 0 otherwise)
+    double getGainReductionDb() const
+    {
+        double gr = 0.0;
+        if (!idle)
+            for (int b = 0; b < crossover.getNumBands(); ++b)
+                if (bands[(size_t) b] != nullptr)
+                    gr = juce::jmax(gr, bands[(size_t) b]->getGainReductionDb());
+        return gr;
+    }
+
+    double getLinkAmount() const
+    {
+        double link = 0.0;
+        for (int b = 0; b < crossover.getNumBands(); ++b)
+            if (bands[(size_t) b] != nullptr)
+                link = juce::jmax(link, bands[(size_t) b]->getLinkAmount());
+        return link;
+    }
+
+    double getOversamplingEngage01() const
+    {
+        if constexpr (TierTraits<Tier>::alwaysOversample)
+            return oversamplingAndSafety.getEngage01();
+        return 0.0;
+    }
+
+    int getNumBands() const                      { return crossover.getNumBands(); }
+    Pipeline& getBand (int b)                    { return *bands[(size_t) b]; }
+    const Pipeline& getBand (int b) const        { return *bands[(size_t) b]; }
+    const CrossoverNetwork<SampleType>& getCrossover() const { return crossover; }
+    int getNumWorkers() const                    { return pool.getNumWorkers(); }
+
+    // Phase 6: bytes per stage for this wrapper and its band pipelines (the band pipelines' arena regions are
+    // reported by the arena's owner)
+    void addMemoryFootprint (MemoryFootprint& footprint) const
+    {
+        if (arena == &localArena)
+            localArena.addFootprint(footprint);
+        hotState.addFootprint(footprint);
+
+        size_t bandObjects = 0;
+        for (const auto& band : bands)
+        {
+            if (band != nullptr)
+            {
+                band->addMemoryFootprint(footprint);
+                bandObjects += sizeof(Pipeline);
+            }
+        }
+        footprint.add("multiband band pipelines", bandObjects);
+        footprint.add("multiband crossover", sizeof(crossover));
+        footprint.add("multiband wrapper", sizeof(*this) - sizeof(crossover));
+        footprint.add("oversampler (JUCE-owned, estimated)", oversamplingAndSafety.getOversamplerBytesEstimate());
+    }
+    // Band pipelines share the tier, so every band carries the same (lookahead) latency; plus the sum stage
+    int getLatencySamples() const
+    {
+        return (bands[0] != nullptr ? bands[0]->getLatencySamples() : 0) + oversamplingAndSafety.getLatencySamples();
+    }
+
+private:
+    struct Job
+    {
+        MultibandCompressor* owner = nullptr;
+        const Buffer* key = nullptr;
+        std::array<Buffer*, kMaxBands> views {};
+    };
+
+    bool allBandsIdle() const
+    {
+        for (int b = 0; b < crossover.getNumBands(); ++b)
+            if (!bands[(size_t) b]->isIdle())
+                return false;
+        return true;
+    }
+
+    void resetIdle()
+    {
+        idle = false;
+        outputQuiet = false;
+        quietSamples = 0;
+    }
+
+    static void runBand (void* context, int b)
+    {
+        auto& job = *static_cast<Job*> (context);
+        job.owner->bands[(size_t) b]->process(*job.views[(size_t) b], job.key);
+    }
+
+    void processChunk (Buffer& chunk, const Buffer* key)
+    {
+        const int chs = chunk.getNumChannels();
+        const int n = chunk.getNumSamples();
+        const int numBands = crossover.getNumBands();
+
+        // Band views sized to this chunk (refer to the band buffers in the arena: band-major, channel lines of
+        // maxBlock samples)
+        SampleType* const bandData = arena->get<SampleType> (bandBufferOffset);
+        std::array<Buffer, kMaxBands> views;
+        Job job;
+        job.owner = this;
+        job.key = key;
+        for (int b = 0; b < numBands; ++b)
+        {
+            SampleType* lines[ChannelGroups::kMaxChannels];
+            for (int ch = 0; ch < chs; ++ch)
+                lines[ch] = bandData + (b * numCh + ch) * maxBlock;
+            views[(size_t) b].setDataToReferTo(lines, chs, n);
+            job.views[(size_t) b] = &views[(size_t) b];
+        }
+
+        crossover.process(chunk, views.data());
+
+        if (n >= kMinParallelBlockSize)
+            pool.run(&runBand, &job, numBands);
+        else
+            for (int b = 0; b < numBands; ++b)
+                runBand(&job, b);
+
+        // Band sum
+        for (int ch = 0; ch < chs; ++ch)
+        {
+            SampleType* y = chunk.getWritePointer(ch);
+            const SampleType* b0 = views[0].getReadPointer(ch);
+            for (int i = 0; i < n; ++i)
+                y[i] = b0[i];
+            for (int b = 1; b < numBands; ++b)
+            {
+                const SampleType* xb = views[(size_t) b].getReadPointer(ch);
+                for (int i = 0; i < n; ++i)
+                    y[i] += xb[i];
+            }
+        }
+    }
+
+    int maxBlock = 512;
+    int numCh = 2;
+    int workerCount = -1;
+    bool prepared = false;
+
+    // Phase 6: idle fast path state
+    bool idle = false;
+    bool outputQuiet = false;
+    int quietSamples = 0;
+    int idleHoldSamples = ChannelGroups::kTileSize;
+
+    SmootherBank smoothers;
+    HotStateBlock hotState;
+    CrossoverNetwork<SampleType> crossover;
+    std::array<std::unique_ptr<Pipeline>, kMaxBands> bands;
+    DspArena localArena; // used until an owner attaches its arena
+    DspArena* arena = nullptr;
+    int bandBufferOffset = 0; // kMaxBands x numCh lines of maxBlock samples
+    OutputStage<SampleType> outputStage;
+    OversamplingAndSafety<SampleType> oversamplingAndSafety; // Mastering only (idle otherwise)
+    LookaheadDelay<SampleType> idleAlign;                    // idle fast path: band lookahead
+    BandWorkerPool pool;
+};
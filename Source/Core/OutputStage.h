@@ -1,76 +1,75 @@
 // Phase 4: OutputStage final numerical safety guard (invisible)
 // - DC block (1st-order HP, sealed <= 10 Hz)
-// - finite/denormal protection
+// - finite/denormal protection (Phase 6: DenormalGuard for the loop, DC state flushed at block end)
 // - final safety soft-limit to -0.3 dBFS
 
 #pragma once
 #include <JuceHeader.h>
 
+#include "ChannelGroups.h"
+#include "DspKernels.h"
+#include "HotStateBlock.h"
+#include "../Util/DenormalGuard.h"
+
+template <typename SampleType>
 struct OutputStage
 {
+    // Phase 6: owner's hot-state block (not owned). Attach before prepare(); the DC blocker memories are
+    // reserved there (x1 row, y1 row, packed at the block's channel count).
+    void setHotState (HotStateBlock& block) { hot = &block; }
+
     void prepare (double sampleRate, int)
     {
+        numChannelsPrepared = hot->getNumChannels();
+        stateOffset = hot->reserve<double> (2 * numChannelsPrepared);
+
         sr = (sampleRate > 0.0 ? sampleRate : 48000.0);
         // Sealed DC block coefficient (<= 10 Hz cutoff)
         constexpr double fc = 10.0;
         const double a = std::exp(-2.0 * juce::MathConstants<double>::pi * fc / sr);
         dcA = (std::isfinite(a) ? a : 0.0);
+        kernels = &DspKernels::getActive<SampleType>();
         reset();
     }
 
     void reset()
     {
-        x1[0] = x1[1] = 0.0;
-        y1[0] = y1[1] = 0.0;
+        std::fill_n(hot->get<double> (stateOffset), 2 * numChannelsPrepared, 0.0);
     }
 
-    void process (juce::AudioBuffer<float>& buffer)
+    void process (juce::AudioBuffer<SampleType>& buffer)
     {
-        juce::ScopedNoDenormals noDenormals;
+        const DenormalGuard denormalGuard;
 
         const int chs = buffer.getNumChannels();
         if (chs <= 0) return;
 
-        const int numCh = juce::jmin(chs, 2);
+        const int numCh = juce::jmin(chs, numChannelsPrepared);
         const int nSamp = buffer.getNumSamples();
-
-        constexpr float kClip = 0.9659363f; // 10^(-0.3/20)
+        double* x1 = hot->get<double> (stateOffset);
+        double* y1 = x1 + numChannelsPrepared;
 
         for (int ch = 0; ch < numCh; ++ch)
         {
-            float* p = buffer.getWritePointer(ch);
-            double px1 = x1[(size_t)ch];
-            double py1 = y1[(size_t)ch];
-            const double a = dcA;
-
-            for (int i = 0; i < nSamp; ++i)
-            {
-                float xf = p[i];
-                if (!std::isfinite(xf)) xf = 0.0f;
-
-                const double x = (double)xf;
-                const double y = (x - px1) + a * py1;
-                px1 = x;
-                py1 = y;
-
-                float out = (float)y;
-                if (!std::isfinite(out)) out = 0.0f;
-
-                // Sealed gentle safety soft-limit (-0.3 dBFS)
-                out = kClip * std::tanh(out / kClip);
-
-                p[i] = out;
-            }
-
-            x1[(size_t)ch] = px1;
-            y1[(size_t)ch] = py1;
+            // Phase 6: runs in SampleType (state is kept in double between blocks); DC block + sealed
+            // -0.3 dBFS soft-limit in the ISA-dispatched kernel
+            SampleType px1 = (SampleType) x1[(size_t)ch];
+            SampleType py1 = (SampleType) y1[(size_t)ch];
+            kernels->dcBlockLimit(buffer.getWritePointer(ch), nSamp, (SampleType) dcA, px1, py1);
+
+            x1[(size_t)ch] = (double) px1;
+            y1[(size_t)ch] = (double) py1;
         }
+        DenormalGuard::flush(x1, 2 * numChannelsPrepared);
     }
 
 private:
     double sr  = 48000.0;
     double dcA = 0.0;
-    double x1[2] = { 0.0, 0.0 };
-    double y1[2] = { 0.0, 0.0 };
+    const DspKernels::Table<SampleType>* kernels = &DspKernels::getActive<SampleType>(); // Phase 6: dispatched loops
+    // DC blocker state per channel (SoA rows x1 / y1 in the owner's HotStateBlock)
+    HotStateBlock* hot = nullptr;
+    int stateOffset = 0;
+    int numChannelsPrepared = 0;
 };
 
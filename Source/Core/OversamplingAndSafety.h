@@ -1,6 +1,6 @@
 // Phase 4 Step 3 — Oversampling Safety (sealed)
 // - Invisible safety system: conditional 2x oversampling ONLY when risk is detected
-// - Smooth engage/disengage (block-rate one-pole ramp)
+// - Smooth engage/disengage (block-rate one-pole ramp; Phase 6: a slot in the owner's SmootherBank)
 // - Oversampling is used ONLY to reduce aliasing of the safety soft-clip stage
 // - No parameters. No UI. No topology changes.
 //
@@ -11,27 +11,88 @@
 // - Uses JUCE dsp::Oversampling polyphase IIR mode (low/near-zero latency).
 // - This module runs at the end of the chain as a safety clipper + alias guard.
 // - It does not widen stereo; it processes channels independently.
+// - Phase 6 (QualityTier::mastering): setQuality() selects linear-phase half-band FIR filters with integer
+//   latency and keeps the stage always engaged (no dry crossfade, so no comb against the FIR delay).
+// - Phase 6: preallocate() builds the oversampler in prepare (every tier; its latency is reported in
+//   always-engaged mode) and reserves the dry path in the owner's DspArena. process() never allocates: an
+//   unprepared stage passes audio through, channels past the prepared count are not clipped, and blocks longer
+//   than the prepared size run in prepared-size chunks.
+// - Phase 6 (CpuGovernor): setShed() fades the stage out with the same ramp. In always-engaged mode the
+//   dry side is delayed by the oversampler latency, so the crossfade and the shed state keep the reported
+//   latency and stay phase-aligned.
 
 #pragma once
 #include <JuceHeader.h>
 
+#include "DspArena.h"
+#include "DspKernels.h"
+#include "LookaheadDelay.h"
+#include "SmootherBank.h"
+
+template <typename SampleType>
 struct OversamplingAndSafety
 {
     void prepare (double sampleRate, int maxBlockSize)
     {
         sr = (sampleRate > 1.0 ? sampleRate : 48000.0);
         maxBlock = (maxBlockSize > 0 ? maxBlockSize : 1024);
+        kernels = &DspKernels::getActive<SampleType>();
 
         // Reset ramp
         osRamp01 = 0.0;
         osTarget01 = 0.0;
 
-        // Lazy-create oversampler in process() because channel count can vary.
+        // Built by preallocate() once the owner knows the channel count
         currentChans = 0;
         os.reset();
-        osBuffer.setSize(0, 0, false, false, true);
+
+        if (alwaysEngaged && !shed)
+            osRamp01 = osTarget01 = 1.0;
+
+        // Phase 6: engage ramp (τ = 30 ms, sealed) in the owner's SmootherBank
+        rampSlot = smoothers->add(0.030, osRamp01);
+    }
+
+    // Phase 6: quality configuration (call before prepare). Default = sealed conditional IIR path.
+    void setQuality (bool useLinearPhase, bool engageAlways)
+    {
+        linearPhase = useLinearPhase;
+        alwaysEngaged = engageAlways;
+    }
+
+    // Phase 6: owner's arena (not owned). Attach before prepare(); preallocate() reserves the dry path there.
+    void setArena (DspArena& owner)
+    {
+        arena = &owner;
+        dryAlign.setArena(owner, "oversampling dry align");
+    }
+
+    // Phase 6: build the oversampler for a known channel count (off the audio thread, after prepare())
+    void preallocate (int numChannels)
+    {
+        if (numChannels > 0)
+            ensureOversampler(numChannels);
     }
 
+    // JUCE-owned oversampler buffers (not in the arena; estimated from its 2x stages: numChannels x block x
+    // rate per stage)
+    size_t getOversamplerBytesEstimate() const
+    {
+        return (os != nullptr ? (size_t) currentChans * (size_t) maxBlock * (2 + 4) * sizeof(SampleType) : 0);
+    }
+
+    // Latency added to the audio path (always-engaged mode only; the conditional path is not compensated)
+    int getLatencySamples() const
+    {
+        return (alwaysEngaged && os != nullptr) ? (int) std::lround(os->getLatencyInSamples()) : 0;
+    }
+
+    // Phase 6: CPU governor shed request (block-rate, audio thread); fades out / back in with the ramp
+    void setShed (bool shouldShed) { shed = shouldShed; }
+
+    // Phase 6: engage ramp after the last block (0 = bypassed, 1 = fully oversampled; 0 while unprepared)
+    double getEngage01() const { return os != nullptr ? osRamp01 : 0.0; }
+
     void reset()
     {
         ratio = 1.0;
@@ -41,11 +102,32 @@ struct OversamplingAndSafety
         osRamp01 = 0.0;
         osTarget01 = 0.0;
 
-        currentChans = 0;
-        os.reset();
-        osBuffer.setSize(0, 0, false, false, true);
+        // Keep the prepared oversampler (reported latency); only clear its filter state
+        if (alwaysEngaged && !shed)
+            osRamp01 = osTarget01 = 1.0;
+        smoothers->set(rampSlot, osRamp01);
+        if (os != nullptr)
+            os->reset();
+        dryAlign.reset();
+        osIdle = false;
     }
 
+    // Phase 6: idle fast path (audio thread): the oversampler is skipped, the audio passes through.
+    // Always-engaged mode keeps its reported latency with the dry delay (primed every block, so entering idle
+    // is seamless), as when shed. The filters restart on the next engaged process(); engage ramp and
+    // injections are held.
+    void processIdle (juce::AudioBuffer<SampleType>& buffer)
+    {
+        if (os == nullptr)
+            return;
+        if (alwaysEngaged)
+            dryAlign.process(buffer);
+        osIdle = true;
+    }
+
+    // Phase 6: owner's smoother bank (not owned). Attach before prepare(); the ramp slot is added there.
+    void setSmootherBank (SmootherBank& bank) { smoothers = &bank; }
+
     // Injection slots (NOT parameters)
     void setRatio (double r)
     {
@@ -67,38 +149,79 @@ struct OversamplingAndSafety
         peakAbs = p;
     }
 
-    void process (juce::AudioBuffer<float>& buffer)
+    void process (juce::AudioBuffer<SampleType>& buffer)
     {
-        const int chs = buffer.getNumChannels();
+        const int chs = juce::jmin(buffer.getNumChannels(), currentChans);
         const int n   = buffer.getNumSamples();
-        if (chs <= 0 || n <= 0)
+        if (os == nullptr || chs <= 0 || n <= 0)
             return;
 
         // Trigger (sealed)
         const bool condAggressive = (ratio > 8.0 && attackMs < 3.0);
         const bool condSatRisk    = (peakAbs > 0.98);
-        osTarget01 = (condAggressive || condSatRisk) ? 1.0 : 0.0;
+        osTarget01 = (!shed && (alwaysEngaged || condAggressive || condSatRisk)) ? 1.0 : 0.0;
 
-        // Smooth ramp (sealed tau)
-        const double tau = 0.030; // 30 ms
-        const double a = std::exp(-(double)n / (tau * (sr > 1.0 ? sr : 48000.0)));
-        osRamp01 = a * osRamp01 + (1.0 - a) * osTarget01;
-        if (!std::isfinite(osRamp01)) osRamp01 = osTarget01;
+        // Smooth ramp (sealed tau = 30 ms; SmootherBank slot)
+        osRamp01 = smoothers->process(rampSlot, osTarget01);
         if (osRamp01 < 0.0) osRamp01 = 0.0;
         if (osRamp01 > 1.0) osRamp01 = 1.0;
+        // Phase 6: land exactly on the target (the one-pole alone never reaches 1.0 in double)
+        if (std::abs(osRamp01 - osTarget01) < 1e-4)
+        {
+            osRamp01 = osTarget01;
+            smoothers->set(rampSlot, osRamp01);
+        }
 
-        // If not engaged, do nothing (hard bypass)
+        // If not engaged, do nothing (hard bypass); always-engaged mode keeps its latency with a plain delay
         if (osRamp01 <= 1e-6)
+        {
+            if (alwaysEngaged)
+            {
+                dryAlign.process(buffer);
+                osIdle = true;
+            }
             return;
+        }
+
+        if (osIdle)
+        {
+            os->reset(); // coming back from a shed: drop filter state from before it
+            osIdle = false;
+        }
+
+        // Prepared-size chunks (views into buffer, no allocation)
+        for (int start = 0; start < n; start += maxBlock)
+        {
+            Buffer chunk (buffer.getArrayOfWritePointers(), chs, start, juce::jmin(maxBlock, n - start));
+            processChunk(chunk);
+        }
+    }
 
-        // Ensure oversampler exists + matches channel count
-        ensureOversampler(chs);
+private:
+    using Buffer = juce::AudioBuffer<SampleType>;
 
-        // Copy dry for crossfade
-        dryBuffer.makeCopyOf(buffer, true);
+    void processChunk (Buffer& buffer)
+    {
+        const int chs = buffer.getNumChannels();
+        const int n   = buffer.getNumSamples();
+
+        // Copy dry for crossfade (not needed when fully engaged). Always-engaged mode keeps its dry delay
+        // line primed every block so a shed crossfade starts from aligned audio.
+        const bool crossfade = (osRamp01 < 1.0);
+        SampleType* dryChannels[ChannelGroups::kMaxChannels] {};
+        for (int ch = 0; ch < chs; ++ch)
+            dryChannels[ch] = arena->get<SampleType> (dryOffset) + ch * maxBlock;
+        Buffer dryBuffer (dryChannels, chs, n);
+        if (crossfade || alwaysEngaged)
+        {
+            for (int ch = 0; ch < chs; ++ch)
+                std::copy(buffer.getReadPointer(ch), buffer.getReadPointer(ch) + n, dryChannels[ch]);
+            if (alwaysEngaged)
+                dryAlign.process(dryBuffer);
+        }
 
         // Oversample
-        juce::dsp::AudioBlock<float> block (buffer);
+        juce::dsp::AudioBlock<SampleType> block (buffer);
         auto upBlock = os->processSamplesUp(block);
 
         // Apply sealed safety soft-clip on oversampled audio (per-sample, per-channel)
@@ -108,63 +231,54 @@ struct OversamplingAndSafety
         // Downsample back into 'buffer'
         os->processSamplesDown(block);
 
+        if (!crossfade)
+            return;
+
         // Crossfade dry vs processed
-        const float gWet = (float)osRamp01;
-        const float gDry = 1.0f - gWet;
+        const SampleType gWet = (SampleType)osRamp01;
+        const SampleType gDry = SampleType (1) - gWet;
 
         for (int ch = 0; ch < chs; ++ch)
         {
-            float* w = buffer.getWritePointer(ch);
-            const float* d = dryBuffer.getReadPointer(ch);
+            SampleType* w = buffer.getWritePointer(ch);
+            const SampleType* d = dryBuffer.getReadPointer(ch);
             for (int i = 0; i < n; ++i)
                 w[i] = gDry * d[i] + gWet * w[i];
         }
     }
 
-private:
     void ensureOversampler(int chs)
     {
         if (os && chs == currentChans)
             return;
 
-        currentChans = chs;
+        currentChans = juce::jmin(chs, (int) ChannelGroups::kMaxChannels);
 
         // 2x oversampling (sealed)
+        // Note: the factor argument counts 2x stages (2 = 4x); the Mastering tier relies on that.
         constexpr int kFactor = 2;
-        const auto type = juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR;
+        const auto type = linearPhase ? juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple
+                                      : juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR;
 
-        os.reset(new juce::dsp::Oversampling<float>((size_t)chs, (size_t)kFactor, type, true));
+        os.reset(new juce::dsp::Oversampling<SampleType>((size_t)currentChans, (size_t)kFactor, type, true, linearPhase));
         os->initProcessing((size_t)maxBlock);
 
-        dryBuffer.setSize(chs, maxBlock, false, false, true);
-    }
+        dryOffset = arena->reserve<SampleType> (currentChans * maxBlock, "oversampling dry path");
 
-    static inline float softClip(float x)
-    {
-        // Sealed gentle curve: tanh-based with conservative drive
-        // Ensures bounded output and avoids hard corners.
-        const float drive = 1.20f;
-        const float y = std::tanh(drive * x) / std::tanh(drive);
-        return y;
+        // Phase 6: dry-side delay matching the oversampler latency (always-engaged mode)
+        dryAlign.prepare(sr, maxBlock);
+        dryAlign.setDelaySamples(getLatencySamples());
     }
 
-    static void applySoftClip(juce::dsp::AudioBlock<float>& blk)
+    // Sealed safety soft-clip on the oversampled audio (per channel; curve in DspKernels::Body::softClip)
+    // Clip is gentle and only prevents overs; oversampling reduces aliasing.
+    void applySoftClip(juce::dsp::AudioBlock<SampleType>& blk)
     {
         const int chs = (int)blk.getNumChannels();
         const int n   = (int)blk.getNumSamples();
 
         for (int ch = 0; ch < chs; ++ch)
-        {
-            auto* p = blk.getChannelPointer((size_t)ch);
-            for (int i = 0; i < n; ++i)
-            {
-                float x = p[i];
-                if (!std::isfinite(x)) x = 0.0f;
-                // Only act near risky levels (sealed)
-                if (std::abs(x) > 0.90f)
-                    p[i] = softClip(x);
-            }
-        }
+            kernels->softClip(blk.getChannelPointer((size_t)ch), n);
     }
 
     double sr = 48000.0;
@@ -178,10 +292,23 @@ private:
     // Engage ramp
     double osTarget01 = 0.0;
     double osRamp01   = 0.0;
+    SmootherBank* smoothers = nullptr;
+    int rampSlot = SmootherBank::kScratchSlot;
 
     int currentChans = 0;
 
-    std::unique_ptr<juce::dsp::Oversampling<float>> os;
-    juce::AudioBuffer<float> dryBuffer;
-    juce::AudioBuffer<float> osBuffer; // reserved (unused but kept for future)
+    // Phase 6: quality configuration (QualityTier)
+    bool linearPhase   = false;
+    bool alwaysEngaged = false;
+
+    // Phase 6: CPU governor shed state
+    const DspKernels::Table<SampleType>* kernels = &DspKernels::getActive<SampleType>(); // Phase 6: dispatched loops
+
+    bool shed   = false;
+    bool osIdle = false; // always-engaged stage currently bypassed through dryAlign
+    LookaheadDelay<SampleType> dryAlign;
+
+    std::unique_ptr<juce::dsp::Oversampling<SampleType>> os;
+    DspArena* arena = nullptr;
+    int dryOffset = 0; // currentChans x maxBlock dry copy (crossfade / aligned dry)
 };
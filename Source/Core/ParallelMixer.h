@@ -7,9 +7,13 @@
 
 struct ParallelMixer
 {
+    // Phase 6: placeholder body; CompressorPipeline compiles the process() call away (StageList::runStage)
+    static constexpr bool kIsNoOp = true;
+
     void prepare (double, int) {}
     void reset() {}
 
     // Phase 1: no-op. Later: wet/dry mix w/ smoothing.
-    void process (juce::AudioBuffer<float>&) {}
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>&) {}
 };
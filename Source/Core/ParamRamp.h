@@ -0,0 +1,104 @@
+// Phase 6 — ParamRamp (per-sample automation ramp, control path)
+// Moves a control value towards its latest target one sample at a time, so the trajectory depends only on
+// when targets change, not on how the host block or the control tiles slice the samples:
+//   Shape::linear       constant slope, lands on the target rampSec after it was set (a new target restarts
+//                       the ramp from the current value)
+//   Shape::exponential  one-pole with time constant rampSec; snaps onto the target once within kSnap
+// prepare() derives the per-sample step / coefficient; next() / fill() / advance() never call exp().
+// No allocation.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+struct ParamRamp
+{
+    enum class Shape
+    {
+        linear,
+        exponential
+    };
+
+    static constexpr double kSnap = 1e-9; // relative to max(1, |target|)
+
+    void prepare (double sampleRate, double rampSec, Shape rampShape)
+    {
+        shape = rampShape;
+        const double fs  = (std::isfinite(sampleRate) && sampleRate > 0.0 ? sampleRate : 48000.0);
+        const double len = std::max(1.0, (std::isfinite(rampSec) ? rampSec : 0.0) * fs);
+        rampSamples = (int) std::lround(len);
+        invRampSamples = 1.0 / (double) rampSamples;
+        keep = std::exp(-1.0 / len);
+        reset(target);
+    }
+
+    // Jump to value (no ramp)
+    void reset (double value)
+    {
+        if (!std::isfinite(value))
+            value = 0.0;
+        current = start = target = value;
+        pos = rampSamples;
+    }
+
+    void setTarget (double newTarget)
+    {
+        if (!std::isfinite(newTarget) || newTarget == target)
+            return;
+        target = newTarget;
+        start = current;
+        pos = 0;
+    }
+
+    double getCurrent() const { return current; }
+    double getTarget() const  { return target; }
+    bool isSmoothing() const  { return current != target; }
+
+    double next()
+    {
+        if (shape == Shape::linear)
+        {
+            pos = (pos < rampSamples ? pos + 1 : rampSamples);
+            current = (pos < rampSamples ? start + (target - start) * ((double) pos * invRampSamples) : target);
+        }
+        else
+        {
+            current = target + keep * (current - target);
+            if (std::abs(current - target) <= kSnap * std::max(1.0, std::abs(target)))
+                current = target;
+        }
+        return current;
+    }
+
+    // The next n values (sample-accurate); out[n - 1] is the new current value
+    void fill (double* out, int n)
+    {
+        if (!isSmoothing())
+        {
+            std::fill(out, out + n, current);
+            return;
+        }
+        for (int i = 0; i < n; ++i)
+            out[i] = next();
+    }
+
+    // Advance n samples without output; returns the new current value
+    double advance (int n)
+    {
+        for (int i = 0; i < n && isSmoothing(); ++i)
+            next();
+        return current;
+    }
+
+private:
+    Shape shape = Shape::exponential;
+    int rampSamples = 1;
+    double invRampSamples = 1.0;
+    double keep = 0.0;
+
+    double current = 0.0;
+    double start = 0.0;
+    double target = 0.0;
+    int pos = 1;
+};
@@ -0,0 +1,68 @@
+// Phase 6 — QualityTier (compile-time pipeline specializations)
+// One CompressorPipeline instantiation per tier; the host-facing tier is chosen in prepareToPlay (a "quality"
+// change re-prepares on the message thread and reports the new tier latency).
+//
+//   Eco       — control path at tile rate (one envelope / GR step per 64-sample tile, GR ramped across it),
+//               Coarse FastMath kernels, no oversampling stage (OutputStage soft-limit still applies).
+//   Standard  — per-sample control path, Fine kernels, conditional oversampled safety clip (the sealed path).
+//   Mastering — Standard + true-peak detection, lookahead, and an always-engaged linear-phase (FIR)
+//               4x oversampled safety clip with integer latency.
+//
+// Eco and Standard also default to multirate control: above ~88 kHz detection, envelopes and the gain law run
+// at sampleRate / 2 or / 4 (CompressorPipeline::setMultirateControl). Mastering keeps full-rate control.
+//
+// Traits are read with `if constexpr`, so a tier pays nothing for the features it does not use.
+// No DSP. No allocation.
+
+#pragma once
+
+#include "FastMath.h"
+
+enum class QualityTier
+{
+    eco,
+    standard,
+    mastering
+};
+
+template <QualityTier Tier>
+struct TierTraits;
+
+template <>
+struct TierTraits<QualityTier::eco>
+{
+    static constexpr FastMath::Accuracy accuracy = FastMath::Accuracy::Coarse;
+    static constexpr bool   perSampleControl   = false;
+    static constexpr bool   oversampling       = false;
+    static constexpr bool   linearPhaseOs      = false;
+    static constexpr bool   alwaysOversample   = false;
+    static constexpr bool   multirateControl   = true;
+    static constexpr bool   truePeak           = false;
+    static constexpr double lookaheadMs        = 0.0;
+};
+
+template <>
+struct TierTraits<QualityTier::standard>
+{
+    static constexpr FastMath::Accuracy accuracy = FastMath::kDefaultAccuracy;
+    static constexpr bool   perSampleControl   = true;
+    static constexpr bool   oversampling       = true;
+    static constexpr bool   linearPhaseOs      = false;
+    static constexpr bool   alwaysOversample   = false;
+    static constexpr bool   multirateControl   = true;
+    static constexpr bool   truePeak           = false;
+    static constexpr double lookaheadMs        = 0.0;
+};
+
+template <>
+struct TierTraits<QualityTier::mastering>
+{
+    static constexpr FastMath::Accuracy accuracy = FastMath::kDefaultAccuracy;
+    static constexpr bool   perSampleControl   = true;
+    static constexpr bool   oversampling       = true;
+    static constexpr bool   linearPhaseOs      = true;
+    static constexpr bool   alwaysOversample   = true;
+    static constexpr bool   multirateControl   = false;
+    static constexpr bool   truePeak           = true;
+    static constexpr double lookaheadMs        = 2.0; // sealed
+};
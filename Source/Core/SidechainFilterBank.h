@@ -0,0 +1,334 @@
+// Phase 6 — SidechainFilterBank (measurement path only)
+// Cascaded biquads (TDF-II) shaping the detector signal. Never touches the audio path.
+//
+// Cascade (per channel):
+//   [0] HPF          — dynamic cutoff (LowEndGuard recommendation, 60–150 Hz), 0 Hz = bypass
+//   [1] Low-shelf    — tilt, neutral (0 dB) by default
+//   [2] Band peak    — emphasis, neutral (0 dB) by default
+//   tap: LPF 120 Hz  — low-band proxy for low-end dominance, fed by the cascade output
+// Optional M/S input encode of channels 0/1 (mid/side detection).
+// Optional decimation by 2 / 4 (multirate control at high sample rates): the gathered tile passes a
+// Butterworth anti-alias LPF at the input rate, every D-th sample is kept, and the cascade + tap run at the
+// reduced rate (designs use fs / D).
+//
+// Layout:
+// - State is structure-of-arrays in the owner's HotStateBlock: one row per filter memory (anti-alias, cascade
+//   stages, low tap; z1 then z2), channel-packed at the prepared channel count. The inner loop runs across
+//   channels with shared coefficients, so it vectorizes over channels.
+// - Coefficients are designed once per tile (RBJ cookbook) and linearly interpolated sample-by-sample
+//   from the previous tile's set, so a moving cutoff is tracked without per-sample redesign.
+// - Identity stages (bypassed HPF, 0 dB shelf/peak) are skipped entirely.
+// - Templated on the sample type: designs are computed in double, filtering runs in SampleType.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "HotStateBlock.h"
+#include "../Util/DenormalGuard.h"
+
+// RBJ biquad design (double precision; stages convert to their sample type once per design)
+struct BiquadCoeffs
+{
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+
+    bool isIdentity() const { return b0 == 1.0 && b1 == 0.0 && b2 == 0.0 && a1 == 0.0 && a2 == 0.0; }
+
+    static BiquadCoeffs identity() { return {}; }
+
+    // RBJ cookbook designs (normalized by a0)
+    static BiquadCoeffs highPass (double fc, double q, double fs)
+    {
+        const Prewarp p (fc, q, fs);
+        const double inv = 1.0 / (1.0 + p.alpha);
+        return { 0.5 * (1.0 + p.cosW) * inv, -(1.0 + p.cosW) * inv, 0.5 * (1.0 + p.cosW) * inv,
+                 -2.0 * p.cosW * inv, (1.0 - p.alpha) * inv };
+    }
+
+    static BiquadCoeffs lowPass (double fc, double q, double fs)
+    {
+        const Prewarp p (fc, q, fs);
+        const double inv = 1.0 / (1.0 + p.alpha);
+        return { 0.5 * (1.0 - p.cosW) * inv, (1.0 - p.cosW) * inv, 0.5 * (1.0 - p.cosW) * inv,
+                 -2.0 * p.cosW * inv, (1.0 - p.alpha) * inv };
+    }
+
+    // 2nd-order allpass (phase match for a Linkwitz-Riley 4 crossover at the same fc, Q = 1/sqrt(2))
+    static BiquadCoeffs allPass (double fc, double q, double fs)
+    {
+        const Prewarp p (fc, q, fs);
+        const double inv = 1.0 / (1.0 + p.alpha);
+        return { (1.0 - p.alpha) * inv, -2.0 * p.cosW * inv, 1.0, -2.0 * p.cosW * inv, (1.0 - p.alpha) * inv };
+    }
+
+    static BiquadCoeffs lowShelf (double fc, double gainDb, double fs)
+    {
+        const double A = std::pow(10.0, gainDb / 40.0);
+        const Prewarp p (fc, 0.70710678118654752, fs);
+        const double k = 2.0 * std::sqrt(A) * p.alpha;
+        const double inv = 1.0 / ((A + 1.0) + (A - 1.0) * p.cosW + k);
+        return { A * ((A + 1.0) - (A - 1.0) * p.cosW + k) * inv,
+                 2.0 * A * ((A - 1.0) - (A + 1.0) * p.cosW) * inv,
+                 A * ((A + 1.0) - (A - 1.0) * p.cosW - k) * inv,
+                 -2.0 * ((A - 1.0) + (A + 1.0) * p.cosW) * inv,
+                 ((A + 1.0) + (A - 1.0) * p.cosW - k) * inv };
+    }
+
+    static BiquadCoeffs peak (double fc, double q, double gainDb, double fs)
+    {
+        const double A = std::pow(10.0, gainDb / 40.0);
+        const Prewarp p (fc, q, fs);
+        const double inv = 1.0 / (1.0 + p.alpha / A);
+        return { (1.0 + p.alpha * A) * inv, -2.0 * p.cosW * inv, (1.0 - p.alpha * A) * inv,
+                 -2.0 * p.cosW * inv, (1.0 - p.alpha / A) * inv };
+    }
+
+private:
+    struct Prewarp
+    {
+        Prewarp (double fc, double q, double fs)
+        {
+            const double nyq = 0.49 * fs;
+            fc = (fc < 1.0 ? 1.0 : (fc > nyq ? nyq : fc));
+            const double w = 2.0 * 3.14159265358979323846 * fc / fs;
+            cosW  = std::cos(w);
+            alpha = std::sin(w) / (2.0 * (q > 0.05 ? q : 0.05));
+        }
+        double cosW = 1.0, alpha = 0.0;
+    };
+};
+
+template <typename SampleType>
+struct SidechainFilterBank
+{
+    static constexpr int kMaxChannels = 16;
+    static constexpr int kNumStages   = 3;
+    static constexpr int kMaxTileSize = 64;
+
+    enum Stage { hpf = 0, lowShelf = 1, bandPeak = 2 };
+
+    using Coeffs = BiquadCoeffs;
+
+    // Owner's hot-state block (not owned). Attach before prepare(); the filter memories are reserved there.
+    void setHotState (HotStateBlock& block) { hot = &block; }
+
+    // decimation: 1, 2 or 4 (output samples per processTile() = input samples / decimation, phase kept across tiles)
+    void prepare (double sampleRate, int decimation = 1)
+    {
+        stride = hot->getNumChannels();
+        stateOffset = hot->reserve<SampleType> (kNumRows * stride);
+
+        const double inputFs = (sampleRate > 0.0 ? sampleRate : 48000.0);
+        factor = (decimation >= 4 ? 4 : (decimation >= 2 ? 2 : 1));
+        fs = inputFs / (double) factor;
+
+        // Anti-alias LPF (sealed): 2nd-order Butterworth at 0.45 of the reduced rate
+        antiAlias = Kernel(factor > 1 ? Coeffs::lowPass(kAntiAliasFraction * fs, kButterworthQ, inputFs)
+                                      : Coeffs::identity());
+
+        // Low-band proxy (sealed): LPF @ 120 Hz, Butterworth Q
+        lowBand = Kernel(Coeffs::lowPass(kLowBandHz, kButterworthQ, fs));
+
+        for (int st = 0; st < kNumStages; ++st)
+        {
+            current[st] = Kernel();
+            target[st]  = Kernel();
+        }
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill_n(hot->get<SampleType> (stateOffset), kNumRows * stride, (SampleType) 0);
+        phase = 0;
+
+        // Jump straight to the latest design (no ramp out of silence)
+        for (int st = 0; st < kNumStages; ++st)
+            current[st] = target[st];
+    }
+
+    // ----------------------------
+    // Per-tile design targets (control feeds)
+    // ----------------------------
+    void setHighPassHz (double hz)
+    {
+        target[hpf] = Kernel((std::isfinite(hz) && hz > 0.0) ? Coeffs::highPass(hz, kButterworthQ, fs) : Coeffs::identity());
+    }
+
+    void setLowShelf (double hz, double gainDb)
+    {
+        target[lowShelf] = Kernel((std::isfinite(gainDb) && std::abs(gainDb) > 1e-3) ? Coeffs::lowShelf(hz, gainDb, fs) : Coeffs::identity());
+    }
+
+    void setBandPeak (double hz, double q, double gainDb)
+    {
+        target[bandPeak] = Kernel((std::isfinite(gainDb) && std::abs(gainDb) > 1e-3) ? Coeffs::peak(hz, q, gainDb, fs) : Coeffs::identity());
+    }
+
+    // Channels 0/1 are measured as mid = (L+R)/2, side = (L-R)/2 (state is per slot, so reset() on a mode change
+    // is optional: the filters simply settle onto the new signal).
+    void setMidSide (bool shouldEncode) { midSide = shouldEncode; }
+
+    int getDecimation() const { return factor; }
+
+    // Filters one tile (n <= kMaxTileSize) of numCh planar channels starting at startSample (channels past the
+    // prepared count are not measured).
+    // out/lowOut are sample-major (interleaved) tiles: out[i * kMaxChannels + ch], so the
+    // per-sample channel loop reads and writes contiguous memory.
+    // Coefficients ramp linearly from the previous tile's set to the current targets across the tile.
+    // All per-sample math runs in SampleType (no widening in the float instantiation).
+    // Returns the number of (decimated) samples written to out/lowOut: n when not decimating, else 0 .. n / D + 1.
+    int processTile (const SampleType* const* in, int numCh, int startSample, int n, SampleType* out, SampleType* lowOut)
+    {
+        numCh = (numCh < stride ? numCh : stride);
+        SampleType* const state = hot->get<SampleType> (stateOffset);
+        const SampleType half = (SampleType) 0.5;
+
+        // Gather planar input into the interleaved work tile (channels 0/1 encoded to M/S when requested)
+        int firstPlain = 0;
+        if (midSide && numCh >= 2)
+        {
+            const SampleType* l = in[0] + startSample;
+            const SampleType* r = in[1] + startSample;
+            for (int i = 0; i < n; ++i)
+            {
+                out[i * kMaxChannels + 0] = half * (l[i] + r[i]);
+                out[i * kMaxChannels + 1] = half * (l[i] - r[i]);
+            }
+            firstPlain = 2;
+        }
+        for (int ch = firstPlain; ch < numCh; ++ch)
+        {
+            const SampleType* x = in[ch] + startSample;
+            for (int i = 0; i < n; ++i)
+                out[i * kMaxChannels + ch] = x[i];
+        }
+
+        if (factor > 1)
+        {
+            n = decimate(out, numCh, n, state + kAntiAliasRow * stride);
+            if (n <= 0)
+                return 0; // no output sample in this tile: designs keep ramping from the current set next tile
+        }
+        const SampleType invN = (SampleType) 1 / (SampleType) n;
+
+        for (int st = 0; st < kNumStages; ++st)
+        {
+            Kernel c = current[st];
+            const Kernel& t = target[st];
+            if (c.isIdentity() && t.isIdentity())
+                continue;
+
+            const Kernel d { (t.b0 - c.b0) * invN, (t.b1 - c.b1) * invN, (t.b2 - c.b2) * invN,
+                             (t.a1 - c.a1) * invN, (t.a2 - c.a2) * invN };
+
+            SampleType* z1 = state + (kFirstStageRow + 2 * st) * stride;
+            SampleType* z2 = z1 + stride;
+
+            for (int i = 0; i < n; ++i)
+            {
+                c.b0 += d.b0; c.b1 += d.b1; c.b2 += d.b2; c.a1 += d.a1; c.a2 += d.a2;
+
+                SampleType* v0 = out + i * kMaxChannels;
+                for (int ch = 0; ch < numCh; ++ch)
+                {
+                    SampleType& v = v0[ch];
+                    const SampleType x = v;
+                    const SampleType y = c.b0 * x + z1[ch];
+                    z1[ch] = c.b1 * x - c.a1 * y + z2[ch];
+                    z2[ch] = c.b2 * x - c.a2 * y;
+                    v = y;
+                }
+            }
+
+            current[st] = t; // land exactly on target (no accumulated ramp drift)
+        }
+
+        // Low-band proxy tap (fixed coefficients)
+        const Kernel& c = lowBand;
+        SampleType* lowS1 = state + kLowBandRow * stride;
+        SampleType* lowS2 = lowS1 + stride;
+        for (int i = 0; i < n; ++i)
+        {
+            for (int ch = 0; ch < numCh; ++ch)
+            {
+                const SampleType x = out[i * kMaxChannels + ch];
+                const SampleType y = c.b0 * x + lowS1[ch];
+                lowS1[ch] = c.b1 * x - c.a1 * y + lowS2[ch];
+                lowS2[ch] = c.b2 * x - c.a2 * y;
+                lowOut[i * kMaxChannels + ch] = y;
+            }
+        }
+
+        // Phase 6: filter memories stop at exact zero on a fade-out (no subnormal recursion next tile)
+        DenormalGuard::flush(state, kNumRows * stride);
+        return n;
+    }
+
+private:
+    static constexpr double kButterworthQ      = 0.70710678118654752;
+    static constexpr double kLowBandHz         = 120.0;
+    static constexpr double kAntiAliasFraction = 0.45; // of the reduced rate (21.6 kHz at 48 kHz)
+
+    // Hot-state rows (z1, z2 per filter), in processing order
+    static constexpr int kAntiAliasRow   = 0;
+    static constexpr int kFirstStageRow  = 2;
+    static constexpr int kLowBandRow     = kFirstStageRow + 2 * kNumStages;
+    static constexpr int kNumRows        = kLowBandRow + 2;
+
+    // Anti-alias LPF over the interleaved input-rate tile, keeping every factor-th sample (compacted in place)
+    int decimate (SampleType* tile, int numCh, int n, SampleType* aaS1)
+    {
+        const Kernel& c = antiAlias;
+        SampleType* aaS2 = aaS1 + stride;
+        int m = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            const SampleType* x0 = tile + i * kMaxChannels;
+            SampleType* y0 = tile + m * kMaxChannels; // m <= i: never overwrites unread input
+            const bool keep = (phase == 0);
+            for (int ch = 0; ch < numCh; ++ch)
+            {
+                const SampleType x = x0[ch];
+                const SampleType y = c.b0 * x + aaS1[ch];
+                aaS1[ch] = c.b1 * x - c.a1 * y + aaS2[ch];
+                aaS2[ch] = c.b2 * x - c.a2 * y;
+                if (keep)
+                    y0[ch] = y;
+            }
+            m += (keep ? 1 : 0);
+            phase = (phase + 1 < factor ? phase + 1 : 0);
+        }
+        return m;
+    }
+
+    double fs = 48000.0;   // processing rate of the cascade (input rate / factor)
+    bool midSide = false;
+    int factor = 1;
+    int phase = 0;         // input samples since the last kept one
+
+    HotStateBlock* hot = nullptr;
+    int stateOffset = 0;
+    int stride = 0;        // channels per hot-state row (0 until prepared)
+
+    // Designed coefficients in the processing sample type
+    struct Kernel
+    {
+        SampleType b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+
+        Kernel() = default;
+        Kernel (SampleType b0_, SampleType b1_, SampleType b2_, SampleType a1_, SampleType a2_)
+            : b0 (b0_), b1 (b1_), b2 (b2_), a1 (a1_), a2 (a2_) {}
+        Kernel (const Coeffs& c)
+            : b0 ((SampleType) c.b0), b1 ((SampleType) c.b1), b2 ((SampleType) c.b2),
+              a1 ((SampleType) c.a1), a2 ((SampleType) c.a2) {}
+
+        bool isIdentity() const { return b0 == 1 && b1 == 0 && b2 == 0 && a1 == 0 && a2 == 0; }
+    };
+
+    Kernel current[kNumStages];
+    Kernel target[kNumStages];
+    Kernel lowBand;
+    Kernel antiAlias;
+};
@@ -0,0 +1,151 @@
+// Phase 6 — SmootherBank (block-rate control smoothers, SoA)
+// Every block-rate one-pole control smoother of an owner (a pipeline, or the multiband wrapper) lives in one
+// structure-of-arrays block:   value <- target + keep * (value - target)
+// - Time advances in whole control tiles: beginBlock(n) counts the tile boundaries the block crosses, so a
+//   trajectory depends only on elapsed samples, not on the host block size (a block shorter than a tile leaves
+//   the smoothers where they are until a boundary is crossed).
+// - prepare() tabulates per slot the per-tile coefficient exp(-kTileSize / (τ fs)) and its binary powers;
+//   beginBlock() builds keep^tiles for all slots in one pass and caches it while the tile count repeats.
+//   No exp() at block rate.
+// - Targets are mid-block measurements, so each stage steps its own contiguous slot range (one vectorizable
+//   loop) at the point where it reads the smoothed values.
+// Slots are added off the audio thread (stage prepare), before the bank's own prepare(). No allocation.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "ChannelGroups.h"
+#include "../Util/DenormalGuard.h"
+
+struct SmootherBank
+{
+    static constexpr int kMaxSlots   = 64;
+    static constexpr int kTileSize   = ChannelGroups::kTileSize;
+    static constexpr int kMaxPowers  = 16;                      // up to 65535 tiles per block (longer blocks clamp)
+    static constexpr int kScratchSlot = kMaxSlots;              // valid index for unregistered / overflow slots
+
+    // Drops every slot (owner prepare, before the stages re-add theirs)
+    void clear()
+    {
+        numSlots = 0;
+        cachedTiles = -1;
+    }
+
+    // Registers count consecutive smoothers sharing τ (seconds; <= 0 = follow the target every tile), all
+    // starting at initial. Returns the first slot (kScratchSlot, shared and never stepped, when the bank is full).
+    int add (double tauSec, double initial = 0.0, int count = 1)
+    {
+        if (count <= 0 || numSlots + count > kMaxSlots)
+            return kScratchSlot;
+
+        const int first = numSlots;
+        for (int i = first; i < first + count; ++i)
+        {
+            tau[i] = (std::isfinite(tauSec) && tauSec > 0.0 ? tauSec : 0.0);
+            value[i] = target[i] = (std::isfinite(initial) ? initial : 0.0);
+        }
+        numSlots += count;
+        return first;
+    }
+
+    int getNumSlots() const { return numSlots; }
+
+    // Tabulates the coefficients of every registered slot (the only exp() calls)
+    void prepare (double sampleRate)
+    {
+        const double fs = (std::isfinite(sampleRate) && sampleRate > 0.0 ? sampleRate : 48000.0);
+        for (int i = 0; i < numSlots; ++i)
+        {
+            double keep = (tau[i] > 0.0 ? std::exp(-(double) kTileSize / (tau[i] * fs)) : 0.0);
+            if (!std::isfinite(keep) || keep < 0.0)
+                keep = 0.0;
+            for (int k = 0; k < kMaxPowers; ++k)
+            {
+                keepPow[k][i] = (keep < DenormalGuard::kFlushFloor ? 0.0 : keep); // high powers underflow
+                keep *= keep;
+            }
+        }
+        resetClock();
+    }
+
+    // Restarts the tile clock (owner reset); values are reset by their stages
+    void resetClock()
+    {
+        tilePhase = 0;
+        tiles = 0;
+        cachedTiles = -1;
+    }
+
+    // Once per block, before any stage steps: tile boundaries crossed by these numSamples, and keep^tiles
+    // for every slot (skipped while the count repeats)
+    void beginBlock (int numSamples)
+    {
+        const int total = tilePhase + std::max(0, numSamples);
+        tilePhase = total % kTileSize;
+        tiles = std::min(total / kTileSize, (1 << kMaxPowers) - 1);
+        if (tiles == 0 || tiles == cachedTiles)
+            return;
+
+        cachedTiles = tiles;
+        std::fill(keepBlock, keepBlock + numSlots, 1.0);
+        for (int k = 0; k < kMaxPowers; ++k)
+            if ((tiles >> k) & 1)
+                for (int i = 0; i < numSlots; ++i)
+                    keepBlock[i] *= keepPow[k][i];
+    }
+
+    // Tiles elapsed in the current block (0 = smoothers hold)
+    int getTilesThisBlock() const { return tiles; }
+
+    // Non-finite targets are ignored, so values stay finite
+    void setTarget (int slot, double t)
+    {
+        if (std::isfinite(t))
+            target[slot] = t;
+    }
+
+    // Jump (no smoothing)
+    void set (int slot, double v)
+    {
+        if (!std::isfinite(v))
+            v = 0.0;
+        value[slot] = target[slot] = v;
+    }
+
+    double get (int slot) const       { return value[slot]; }
+    double getTarget (int slot) const { return target[slot]; }
+
+    // Advances slots [first, first + count) by this block's tiles (slots past the registered ones are skipped)
+    void step (int first, int count)
+    {
+        if (tiles == 0)
+            return; // target + 1 * (value - target) does not round-trip exactly
+        const int last = std::min(first + count, numSlots);
+        for (int i = first; i < last; ++i)
+            value[i] = target[i] + keepBlock[i] * (value[i] - target[i]);
+        if (last > first)
+            DenormalGuard::flush(value + first, last - first); // values decaying to a zero target stop there
+    }
+
+    // Single slot: set the target, advance, read back
+    double process (int slot, double t)
+    {
+        setTarget(slot, t);
+        step(slot, 1);
+        return value[slot];
+    }
+
+private:
+    int numSlots = 0;
+    int tilePhase = 0;   // samples since the last tile boundary
+    int tiles = 0;       // tile boundaries crossed by the current block
+    int cachedTiles = -1;
+
+    alignas(64) double value[kMaxSlots + 1] {};
+    alignas(64) double target[kMaxSlots + 1] {};
+    alignas(64) double keepBlock[kMaxSlots + 1] {};
+    double tau[kMaxSlots + 1] {};
+    alignas(64) double keepPow[kMaxPowers][kMaxSlots + 1] {};
+};
@@ -0,0 +1,43 @@
+// Phase 6 — StageList (compile-time stage composition)
+// - A pipeline lists its stages once, in topology order, as a tuple of references (std::tie): no storage,
+//   no virtual calls. forEachStage() folds a call over every stage: prepare, reset, and process, where the
+//   pipeline supplies one step(stage, block) overload per stage (its wiring + process call) and the list
+//   order is the run order. Values a stage hands to a later stage travel in the block argument; values handed
+//   back to an earlier stage are latched by the pipeline and read on the next block.
+// - A stage whose process() is a structural placeholder declares `static constexpr bool kIsNoOp = true`;
+//   runStage() compiles such calls away (no call, no argument setup), so placeholders cost nothing until
+//   they gain a body and drop the flag.
+// No DSP. No allocation.
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace StageList
+{
+    template <typename Stage, typename = void>
+    struct IsNoOp : std::false_type {};
+
+    template <typename Stage>
+    struct IsNoOp<Stage, std::void_t<decltype(Stage::kIsNoOp)>> : std::bool_constant<Stage::kIsNoOp> {};
+
+    template <typename Stage>
+    constexpr bool isNoOp = IsNoOp<std::decay_t<Stage>>::value;
+
+    // fn(stage) for every stage, in list order
+    template <typename Tuple, typename Fn>
+    void forEachStage (Tuple&& stages, Fn&& fn)
+    {
+        std::apply([&fn] (auto&... stage) { (fn(stage), ...); }, stages);
+    }
+
+    // stage.process(args...) unless the stage is flagged as a no-op
+    template <typename Stage, typename... Args>
+    inline void runStage (Stage& stage, Args&&... args)
+    {
+        if constexpr (!isNoOp<Stage>)
+            stage.process(std::forward<Args>(args)...);
+    }
+}
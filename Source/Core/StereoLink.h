@@ -1,51 +1,68 @@
-// Phase 1 Skeleton (NO-OP): structural placeholder only.
-// No DSP math. No parameters. No UI logic.
-// Must remain transparent pass-through.
+// Phase 4 StereoLink (Stereo Integrity Guard)
+// Phase 6: per link group dynamic linking (control-only, block-rate; audio untouched).
+// - process(): per group, measures the correlation of its pair (first two members, or key channels 0/1)
+//   and its side dominance, then maps smoothstep(correlation) to a link amount in [0.50 .. 0.90], relaxed by
+//   up to 0.15 on side-heavy content (no widening); correlation ~50 ms + 30 ms, link 30 ms (SmootherBank)
+// - blendDetectors(): det[ch] = link * groupDet[group] + (1 - link) * channelDet[ch]; mid/side channels 0/1
+//   stay independent. Single-channel groups (mono, LFE) hold their correlation.
+// No parameters. No UI.
 
 #pragma once
 #include <JuceHeader.h>
 
+#include "ChannelGroups.h"
+#include "SmootherBank.h"
+
+template <typename SampleType>
 struct StereoLink
 {
     void prepare (double sampleRate, int)
     {
         sr = (sampleRate > 1.0 ? sampleRate : 48000.0);
 
-        // Correlation smoothing (~50 ms)
-        const double tauSec = 0.050;
-        const double a = std::exp(-1.0 / (sr * tauSec));
-        corrAlpha = (std::isfinite(a) ? a : 0.99);
-        if (corrAlpha < 0.0)    corrAlpha = 0.0;
-        if (corrAlpha > 0.9999) corrAlpha = 0.9999;
+        // Phase 6: per-group smoothers in the owner's SmootherBank (one slot per possible group and family):
+        // correlation measurement (~50 ms), its 30 ms stability smoother, link amount (30 ms)
+        corrSlot       = smoothers->add(0.050, 1.0, ChannelGroups::kMaxGroups);
+        corrSmoothSlot = smoothers->add(0.030, 1.0, ChannelGroups::kMaxGroups);
+        linkSlot       = smoothers->add(0.030, 0.5, ChannelGroups::kMaxGroups);
     }
 
     void reset()
     {
         // Injected inputs (Phase 3 plumbing)
         linkAmountNorm = 0.5;     // default mid until UI/params wire it
-        correlation01  = 1.0;     // assume fully correlated until measured
         grDbIn         = 0.0;
         grLinIn        = 1.0;
 
-        // Smoothing state
-        corrSmoothed = correlation01;
+        // Smoothing state: assume fully correlated until measured
+        for (int g = 0; g < ChannelGroups::kMaxGroups; ++g)
+        {
+            correlation01[g] = 1.0;
+            corrSmoothed[g]  = 1.0;
+            linkSmoothed[g]  = 0.5;
+            smoothers->set(corrSlot + g, 1.0);
+            smoothers->set(corrSmoothSlot + g, 1.0);
+            smoothers->set(linkSlot + g, 0.5);
+        }
+
+        linkMaxOut = 0.5;
 
-                linkSmoothed = 0.5;
-// Outputs (Phase 3 plumbing placeholders)
+        // Outputs (Phase 3 plumbing placeholders)
         grDbOut  = 0.0;
         grLinOut = 1.0;
     }
 
     // Phase 3: plumbing only (NO DSP math yet, NO audio modification).
     // Later: dynamic linking + correlation-dependent mapping (50–90% range per constitution).
-    void process (juce::AudioBuffer<float>& buffer)
+    // Phase 6: runs once per link group. A group's first two channels form its measurement pair
+    // (front L/R, surround pair, height pair); single-channel groups (mono, LFE) keep their correlation history.
+    void process (juce::AudioBuffer<SampleType>& buffer)
     {
         // --- Correlation measurement (Phase 3 plumbing) ---
         // Computes a smoothed 0..1 correlation metric from current buffer.
         // This does NOT modify audio; it only updates correlation01 for future link law.
-        correlation01 = measureCorrelation01(buffer);
-
-        // Placeholder: pass-through until link law is implemented.
+        // Phase 6: measure the detector source (sidechain key when keyed, else the main input).
+        const juce::AudioBuffer<SampleType>& meas = (detectorSource != nullptr ? *detectorSource : buffer);
 
         // Phase 4 Step 2 — Stereo Integrity Guard (sealed control law)
         // - Correlation-aware linking in [0.50 .. 0.90] (floor 50%)
@@ -53,80 +70,132 @@ struct StereoLink
         // - Subtle bounded side protection (relax linking up to -0.15 on side-heavy content; no widening)
         //
         // Note: StereoLink remains control-only; it does not modify audio samples.
+        const int n = buffer.getNumSamples();
+        const int numGroups = linkGroups.getNumGroups();
+
+        // Phase 6: measurements first, then each smoother family steps across all groups in one bank pass
+        double sideDom01[ChannelGroups::kMaxGroups] {};
+        for (int g = 0; g < numGroups; ++g)
         {
-            const double fs = (sr > 0.0 ? sr : 48000.0);
-            const int n = buffer.getNumSamples();
+            // Measurement pair: the group's first two channels, or key channels 0/1 for an external key
+            int chA = 0, chB = 1;
+            if (groupedMeasurement)
+            {
+                chA = linkGroups.getMember(g, 0);
+                chB = (linkGroups.getGroupSize(g) >= 2 ? linkGroups.getMember(g, 1) : -1);
+            }
+            const bool hasPair = (chB >= 0 && chB < meas.getNumChannels() && meas.getNumSamples() == n);
 
-            // Smooth correlation for stability
-            const double corrNow = clamp01(correlation01);
-            const double tauCorr = 0.030; // 30 ms
-            const double aCorr = std::exp(-(double)n / (tauCorr * fs));
-            corrSmoothed = aCorr * corrSmoothed + (1.0 - aCorr) * corrNow;
+            // Correlation target (τ = 50 ms); no pair -> hold the current estimate
+            smoothers->setTarget(corrSlot + g, measureCorrelation01(meas, chA, chB, g));
 
             // Side dominance estimate (bounded)
-            double sideDom01 = 0.0;
-            if (buffer.getNumChannels() >= 2)
+            if (hasPair)
             {
-                const float* L = buffer.getReadPointer(0);
-                const float* R = buffer.getReadPointer(1);
+                const SampleType* L = meas.getReadPointer(chA);
+                const SampleType* R = meas.getReadPointer(chB);
                 double midE = 0.0, sideE = 0.0;
-                for (int i = 0; i < n; ++i)
+                // Phase 6: accumulate in SampleType per tile, widen once per tile
+                for (int start = 0; start < n; start += kTileSize)
                 {
-                    const double l = (double)L[i];
-                    const double r = (double)R[i];
-                    const double m = 0.5 * (l + r);
-                    const double s = 0.5 * (l - r);
-                    midE  += m * m;
-                    sideE += s * s;
+                    const int len = std::min(kTileSize, n - start);
+                    SampleType tileMid = 0, tileSide = 0;
+                    for (int i = start; i < start + len; ++i)
+                    {
+                        const SampleType m = SampleType (0.5) * (L[i] + R[i]);
+                        const SampleType s = SampleType (0.5) * (L[i] - R[i]);
+                        tileMid  += m * m;
+                        tileSide += s * s;
+                    }
+                    midE  += (double) tileMid;
+                    sideE += (double) tileSide;
                 }
                 const double eps = 1e-18;
                 const double midRms  = std::sqrt(midE  / std::max(1, n));
                 const double sideRms = std::sqrt(sideE / std::max(1, n));
-                sideDom01 = clamp01(sideRms / (midRms + sideRms + eps));
+                sideDom01[g] = clamp01(sideRms / (midRms + sideRms + eps));
             }
+        }
+        smoothers->step(corrSlot, numGroups);
 
-            auto smooth01 = [](double x)
-            {
-                x = clamp01(x);
-                return x * x * (3.0 - 2.0 * x); // smoothstep
-            };
+        // Smooth correlation for stability (τ = 30 ms on top of the measurement smoother)
+        for (int g = 0; g < numGroups; ++g)
+        {
+            correlation01[g] = clamp01(smoothers->get(corrSlot + g));
+            smoothers->setTarget(corrSmoothSlot + g, correlation01[g]);
+        }
+        smoothers->step(corrSmoothSlot, numGroups);
+
+        auto smooth01 = [](double x)
+        {
+            x = clamp01(x);
+            return x * x * (3.0 - 2.0 * x); // smoothstep
+        };
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            corrSmoothed[g] = smoothers->get(corrSmoothSlot + g);
 
             // Map corr -> link in [0.50..0.90] (higher corr => stronger linking)
-            const double corrCurve = smooth01(corrSmoothed);
+            const double corrCurve = smooth01(corrSmoothed[g]);
             double linkTarget = 0.50 + 0.40 * corrCurve;
 
             // Bounded side protection: relax linking when side dominates (no widening)
-            linkTarget -= 0.15 * smooth01(sideDom01);
+            linkTarget -= 0.15 * smooth01(sideDom01[g]);
 
             if (!std::isfinite(linkTarget)) linkTarget = 0.50;
             if (linkTarget < 0.50) linkTarget = 0.50;
             if (linkTarget > 0.90) linkTarget = 0.90;
 
-            // Smooth link amount
-            const double tauLink = 0.030; // 30 ms
-            const double aLink = std::exp(-(double)n / (tauLink * fs));
-            linkSmoothed = aLink * linkSmoothed + (1.0 - aLink) * linkTarget;
+            smoothers->setTarget(linkSlot + g, linkTarget);
+        }
 
-            // Apply as stereo-safety influence on GR (control-only)
-            const double inLin = clamp01(grLinIn);
-            double outLin = std::pow(inLin, linkSmoothed); // less GR when link is relaxed
-            if (!std::isfinite(outLin) || outLin <= 0.0 || outLin > 1.0) outLin = 1.0;
+        // Smooth link amount
+        smoothers->step(linkSlot, numGroups);
+        double linkMax = 0.0;
+        for (int g = 0; g < numGroups; ++g)
+        {
+            linkSmoothed[g] = smoothers->get(linkSlot + g);
+            linkMax = (linkSmoothed[g] > linkMax ? linkSmoothed[g] : linkMax);
+        }
+
+        linkMaxOut = linkMax;
 
-            grLinOut = outLin;
+        // Phase 6: the link amount blends detections (blendDetectors); GR itself is no longer reshaped.
+        grDbOut  = (std::isfinite(grDbIn) && grDbIn > 0.0) ? grDbIn : 0.0;
+        grLinOut = (std::isfinite(grLinIn) && grLinIn > 0.0 && grLinIn <= 1.0) ? grLinIn : 1.0;
+    }
 
-            const double epsDb = 1e-12;
-            const double outDb = -20.0 * std::log10(std::max(outLin, epsDb));
-            grDbOut = (std::isfinite(outDb) && outDb >= 0.0) ? outDb : 0.0;
+    // Phase 6: per-channel detection blended by the link amount (control-only, block-rate):
+    //   det[ch] = link * groupDet[group] + (1 - link) * channelDet[ch]
+    // link = 1 -> fully linked (group detection), link = 0 -> independent. In mid/side mode channels 0/1
+    // (M and S) are always independent. out has one value per channel (the per-sample envelope lanes).
+    void blendDetectors (const double* groupDet, const double* channelDet, double* out, int numCh) const
+    {
+        for (int ch = 0; ch < numCh; ++ch)
+        {
+            const int g = linkGroups.getGroup(ch);
+            const double link = (midSide && ch < 2) ? 0.0 : linkSmoothed[g];
+            const double d = link * groupDet[g] + (1.0 - link) * channelDet[ch];
+            out[ch] = (std::isfinite(d) && d > 0.0) ? d : 0.0;
         }
-        if (!std::isfinite(grDbOut))  grDbOut = 0.0;
-        if (!std::isfinite(grLinOut) || grLinOut <= 0.0) grLinOut = 1.0;
     }
 
     // ----------------------------
     // Injection slots (NOT parameters)
     // ----------------------------
     void setLinkAmountNormalized (double x)   { linkAmountNorm = clamp01(x); }   // eventually maps to 50–90%
-    void setCorrelation01 (double c)          { correlation01  = clamp01(c); }   // 0..1 (external override/testing)
+    void setCorrelation01 (double c)          { for (auto& v : correlation01) v = clamp01(c); } // 0..1 (external override/testing)
+    // Phase 6: owner's smoother bank (not owned). Attach before prepare(); slots are added there.
+    void setSmootherBank (SmootherBank& bank) { smoothers = &bank; }
+    // Measurement source for correlation / side dominance (nullptr = the processed buffer)
+    void setDetectorSource (const juce::AudioBuffer<SampleType>* src) { detectorSource = src; }
+    // Phase 6: link groups (call from prepare/suspended context). false = detector source is an external key:
+    // its channels 0/1 are the measurement pair for every group.
+    void setLinkGroups (const LinkGroupMap& map)              { linkGroups = map; }
+    void setGroupedMeasurement (bool shouldGroup)             { groupedMeasurement = shouldGroup; }
+    // Channels 0/1 carry M/S (StereoMode::midSide): never linked to each other
+    void setMidSide (bool isMidSide)                          { midSide = isMidSide; }
     void setGainReductionDbIn (double db)     { grDbIn  = (std::isfinite(db) ? db : 0.0); }
     void setGainReductionLinearIn (double g)  { grLinIn = (std::isfinite(g) && g > 0.0) ? g : 1.0; }
 
@@ -135,9 +204,13 @@ struct StereoLink
     // ----------------------------
     double getGainReductionDbOut() const      { return grDbOut; }
     double getGainReductionLinearOut() const  { return grLinOut; }
-    double getCorrelation01() const           { return correlation01; }
+    double getCorrelation01 (int g = 0) const { return correlation01[g]; }
+    double getLinkAmount (int g = 0) const    { return linkSmoothed[g]; }
+    double getStrongestLinkAmount() const     { return linkMaxOut; }
 
 private:
+    static constexpr int kTileSize = ChannelGroups::kTileSize;
+
     static double clamp01(double x)
     {
         if (x < 0.0) return 0.0;
@@ -145,24 +218,30 @@ private:
         return x;
     }
 
-    double measureCorrelation01 (const juce::AudioBuffer<float>& buffer)
+    double measureCorrelation01 (const juce::AudioBuffer<SampleType>& buffer, int chA, int chB, int g)
     {
         const int chs = buffer.getNumChannels();
         const int n   = buffer.getNumSamples();
-        if (chs < 2 || n <= 0)
-            return clamp01(corrSmoothed);
+        if (chB < 0 || chA >= chs || chB >= chs || n <= 0)
+            return smoothers->get(corrSlot + g);
 
-        const float* l = buffer.getReadPointer(0);
-        const float* r = buffer.getReadPointer(1);
+        const SampleType* l = buffer.getReadPointer(chA);
+        const SampleType* r = buffer.getReadPointer(chB);
 
         double sumL2 = 0.0, sumR2 = 0.0, sumLR = 0.0;
-        for (int i = 0; i < n; ++i)
+        for (int start = 0; start < n; start += kTileSize)
         {
-            const double ld = (double) l[i];
-            const double rd = (double) r[i];
-            sumL2 += ld * ld;
-            sumR2 += rd * rd;
-            sumLR += ld * rd;
+            const int len = std::min(kTileSize, n - start);
+            SampleType tileL2 = 0, tileR2 = 0, tileLR = 0;
+            for (int i = start; i < start + len; ++i)
+            {
+                tileL2 += l[i] * l[i];
+                tileR2 += r[i] * r[i];
+                tileLR += l[i] * r[i];
+            }
+            sumL2 += (double) tileL2;
+            sumR2 += (double) tileR2;
+            sumLR += (double) tileLR;
         }
 
         const double eps = 1e-18;
@@ -177,27 +256,36 @@ private:
         if (c01 < 0.0) c01 = 0.0;
         c01 = clamp01(c01);
 
-        // Smooth
-        corrSmoothed = corrAlpha * corrSmoothed + (1.0 - corrAlpha) * c01;
-        if (!std::isfinite(corrSmoothed)) corrSmoothed = c01;
-
-        return clamp01(corrSmoothed);
+        return c01;
     }
 
     // Runtime
     double sr           = 48000.0;
-    double corrAlpha    = 0.99;
-    double corrSmoothed = 1.0;
 
-    
-    double linkSmoothed = 0.5;  // smoothed link amount (0.50..0.90)
-// Injected (plumbing)
+    // Phase 6: SmootherBank slots (kMaxGroups consecutive slots per family)
+    SmootherBank* smoothers = nullptr;
+    int corrSlot       = SmootherBank::kScratchSlot;
+    int corrSmoothSlot = SmootherBank::kScratchSlot;
+    int linkSlot       = SmootherBank::kScratchSlot;
+
+    // Phase 6: per link group state (SoA)
+    LinkGroupMap linkGroups = LinkGroupMap::allLinked(2);
+    bool groupedMeasurement = true;
+    bool midSide = false;
+    double linkMaxOut = 0.5;
+    double corrSmoothed[ChannelGroups::kMaxGroups] {};
+    double linkSmoothed[ChannelGroups::kMaxGroups] {}; // smoothed link amount (0.50..0.90)
+    double correlation01[ChannelGroups::kMaxGroups] {}; // 0..1
+
+    // Injected (plumbing)
     double linkAmountNorm = 0.5;  // 0..1 (later maps to 50–90%)
-    double correlation01  = 1.0;  // 0..1
     double grDbIn         = 0.0;
     double grLinIn        = 1.0;
 
     // Outputs (plumbing)
     double grDbOut  = 0.0;
     double grLinOut = 1.0;
+
+    // Phase 6: detector source (not owned; valid for the current block only)
+    const juce::AudioBuffer<SampleType>* detectorSource = nullptr;
 };
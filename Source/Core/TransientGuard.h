@@ -5,9 +5,17 @@
 #pragma once
 #include <JuceHeader.h>
 
+#include "SmootherBank.h"
+
 struct TransientGuard
 {
-    void prepare (double, int) {}
+    void prepare (double, int)
+    {
+        // Phase 6: attack bias + FET soften smoothers (τ = 10 ms, sealed) in the owner's SmootherBank
+        smootherSlot = smoothers->add(0.010, 0.0, kNumSmoothers);
+        reset();
+    }
+
     void reset()
     {
         transientLin = 0.0;
@@ -15,16 +23,16 @@ struct TransientGuard
 
         attackBias01 = 0.0;
         fetSoften01  = 0.0;
+        smoothers->set(smootherSlot + kAttackBias, 0.0);
+        smoothers->set(smootherSlot + kFetSoften, 0.0);
     }
 
     // Phase 4 stub: no-op (no audio modification).
-    void process (juce::AudioBuffer<float>& buffer)
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>&)
 {
     // Phase 4D.1 — Sealed TransientGuard law (control-only).
     // No audio-path modification. Outputs are bounded [0..1] and smoothed.
-    const int n = buffer.getNumSamples();
-    const double sr = (sampleRateHz > 0.0 ? sampleRateHz : 48000.0);
-
     // Sanitize inputs
     double tLin = transientLin;
     if (!std::isfinite(tLin) || tLin < 0.0) tLin = 0.0;
@@ -57,22 +65,13 @@ struct TransientGuard
     const double attackTarget = clamp01(raw);
     const double fetTarget    = clamp01(raw * 0.8);
 
-    // 5) One-pole smoothing (block-rate), τ = 10 ms (sealed)
-    constexpr double tau = 0.010;
-    double a = 0.0;
-    if (n > 0 && sr > 0.0 && tau > 0.0)
-        a = std::exp(-(double)n / (tau * sr));
-    if (!std::isfinite(a) || a < 0.0) a = 0.0;
-    if (a > 1.0) a = 1.0;
+    // 5) One-pole smoothing (block-rate), τ = 10 ms (sealed; SmootherBank slots)
+    smoothers->setTarget(smootherSlot + kAttackBias, attackTarget);
+    smoothers->setTarget(smootherSlot + kFetSoften, fetTarget);
+    smoothers->step(smootherSlot, kNumSmoothers);
 
-    attackBias01 = a * attackBias01 + (1.0 - a) * attackTarget;
-    fetSoften01  = a * fetSoften01  + (1.0 - a) * fetTarget;
-
-    if (!std::isfinite(attackBias01)) attackBias01 = 0.0;
-    if (!std::isfinite(fetSoften01))  fetSoften01  = 0.0;
-
-    attackBias01 = clamp01(attackBias01);
-    fetSoften01  = clamp01(fetSoften01);
+    attackBias01 = clamp01(smoothers->get(smootherSlot + kAttackBias));
+    fetSoften01  = clamp01(smoothers->get(smootherSlot + kFetSoften));
 }
 
 
@@ -99,6 +98,9 @@ struct TransientGuard
     double getTransientLinear() const { return transientLin; }
     double getGainReductionDb() const { return grDb; }
 
+    // Phase 6: owner's smoother bank (not owned). Attach before prepare(); slots are added there.
+    void setSmootherBank (SmootherBank& bank) { smoothers = &bank; }
+
 private:
     static double clamp01(double x)
     {
@@ -106,12 +108,14 @@ private:
         if (x > 1.0) return 1.0;
         return x;
     }
-    double sampleRateHz = 48000.0;
-
     double transientLin = 0.0;
     double grDb = 0.0;
 
     // Neutral until sealed TransientGuard law is authored.
     double attackBias01 = 0.0;
     double fetSoften01  = 0.0;
+
+    enum { kAttackBias, kFetSoften, kNumSmoothers };
+    SmootherBank* smoothers = nullptr;
+    int smootherSlot = SmootherBank::kScratchSlot;
 };
@@ -0,0 +1,106 @@
+// Phase 6 — TruePeakDetector (inter-sample peak estimate, detector path only)
+// 4x polyphase interpolation in the spirit of ITU-R BS.1770: the three fractional phases (1/4, 2/4, 3/4)
+// are evaluated with kTapsPerPhase-tap windowed-sinc kernels; the integer phase is the sample itself.
+// Only the absolute maximum is kept, so the interpolator's group delay does not matter.
+// Designs are computed in double at prepare(); filtering runs in SampleType. No allocation in processTile().
+//
+// Layout: history is sample-major (row t, channel-packed in the owner's HotStateBlock) and written twice
+// (t and t + kTapsPerPhase), so every window is contiguous and each tap's inner loop runs across channels with
+// a shared coefficient.
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "ChannelGroups.h"
+#include "HotStateBlock.h"
+
+template <typename SampleType>
+struct TruePeakDetector
+{
+    static constexpr int kOversampling = 4;
+    static constexpr int kTapsPerPhase = 12;
+    static constexpr int kMaxChannels  = ChannelGroups::kMaxChannels;
+
+    // Owner's hot-state block (not owned). Attach before prepare(); the history is reserved there.
+    void setHotState (HotStateBlock& block) { hot = &block; }
+
+    void prepare()
+    {
+        stride = hot->getNumChannels();
+        histOffset = hot->reserve<SampleType> (kHistRows * stride);
+
+        constexpr double pi = juce::MathConstants<double>::pi;
+        constexpr double half = 0.5 * kTapsPerPhase;
+
+        // Interpolate between window taps kTapsPerPhase/2 - 1 and kTapsPerPhase/2 (oldest tap = 0)
+        for (int p = 1; p < kOversampling; ++p)
+        {
+            const double t = (half - 1.0) + (double) p / (double) kOversampling;
+            double sum = 0.0;
+            double h[kTapsPerPhase];
+            for (int k = 0; k < kTapsPerPhase; ++k)
+            {
+                const double d = t - (double) k;
+                const double sinc = (std::abs(d) < 1e-12 ? 1.0 : std::sin(pi * d) / (pi * d));
+                const double w = 0.5 * (1.0 + std::cos(pi * d / half)); // Hann over the kernel span
+                h[k] = sinc * w;
+                sum += h[k];
+            }
+            for (int k = 0; k < kTapsPerPhase; ++k)
+                kernels[p - 1][k] = (SampleType) (h[k] / sum); // unity DC gain per phase
+        }
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill_n(hot->get<SampleType> (histOffset), kHistRows * stride, (SampleType) 0);
+        pos = 0;
+    }
+
+    // tile is sample-major (tile[i * tileStride + ch]); peaks[ch] is raised to the inter-sample maximum.
+    void processTile (const SampleType* tile, int tileStride, int numCh, int n, SampleType* peaks)
+    {
+        numCh = juce::jmin(numCh, stride);
+        SampleType* const hist = hot->get<SampleType> (histOffset);
+        for (int i = 0; i < n; ++i)
+        {
+            const SampleType* x = tile + i * tileStride;
+            SampleType* h0 = hist + pos * stride;
+            SampleType* h1 = h0 + kTapsPerPhase * stride;
+            for (int ch = 0; ch < numCh; ++ch)
+                h0[ch] = h1[ch] = x[ch];
+            pos = (pos + 1 < kTapsPerPhase ? pos + 1 : 0);
+
+            // Window (oldest -> newest) is hist[pos .. pos + kTapsPerPhase - 1]
+            for (int p = 0; p < kOversampling - 1; ++p)
+            {
+                SampleType acc[kMaxChannels] {};
+                for (int k = 0; k < kTapsPerPhase; ++k)
+                {
+                    const SampleType c = kernels[p][k];
+                    const SampleType* w = hist + (pos + k) * stride;
+                    for (int ch = 0; ch < numCh; ++ch)
+                        acc[ch] += c * w[ch];
+                }
+                for (int ch = 0; ch < numCh; ++ch)
+                {
+                    const SampleType a = std::abs(acc[ch]);
+                    peaks[ch] = (a > peaks[ch] ? a : peaks[ch]);
+                }
+            }
+        }
+    }
+
+private:
+    SampleType kernels[kOversampling - 1][kTapsPerPhase] {};
+    static constexpr int kHistRows = 2 * kTapsPerPhase;
+
+    HotStateBlock* hot = nullptr;
+    int histOffset = 0;
+    int stride = 0; // channels per history row (0 until prepared)
+    int pos = 0;
+};
@@ -1,10 +1,134 @@
 #include "PluginEditor.h"
-#include "PluginProcessor.h"
 
 CompassCompressorAudioProcessorEditor::CompassCompressorAudioProcessorEditor (CompassCompressorAudioProcessor& p)
-: juce::AudioProcessorEditor (&p), processorRef (p)
+: juce::AudioProcessorEditor (&p), processorRef (p),
+  thresholdKnob  (p.getValueTreeState(), "threshold",   "Threshold"),
+  ratioKnob      (p.getValueTreeState(), "ratio",       "Ratio"),
+  attackKnob     (p.getValueTreeState(), "attack",      "Attack"),
+  releaseKnob    (p.getValueTreeState(), "release",     "Release"),
+  mixKnob        (p.getValueTreeState(), "mix",         "Mix"),
+  outputGainKnob (p.getValueTreeState(), "output_gain", "Output"),
+  autoMakeupToggle (p.getValueTreeState())
 {
-    setSize (480, 240); // minimal UI for Phase 0
+    for (auto* knob : { &thresholdKnob, &ratioKnob, &attackKnob, &releaseKnob, &mixKnob, &outputGainKnob })
+        addAndMakeVisible (knob);
+    addAndMakeVisible (autoMakeupToggle);
+    addAndMakeVisible (grMeter);
+
+    // Phase 6: key bus routing (combo ids are KeyBusRole + 1)
+    keyBusRoleBox.addItemList ({ "Key bus off", "Publish key", "Subscribe" }, 1);
+    keyBusRoleBox.onChange = [this] { applyKeyBusRouting(); };
+    keyBusNameEditor.setTextToShowWhenEmpty ("bus name", juce::Colours::grey);
+    keyBusNameEditor.setInputRestrictions (KeyBus::kMaxNameLength - 1);
+    keyBusNameEditor.onReturnKey = [this] { applyKeyBusRouting(); };
+    keyBusNameEditor.onFocusLost = [this] { applyKeyBusRouting(); };
+    for (auto* c : std::initializer_list<juce::Component*> { &keyBusRoleBox, &keyBusNameEditor, &keyBusStatus })
+        addAndMakeVisible (c);
+    showKeyBusRouting();
+
+    readoutLines = formatReadouts ({});
+    setSize (520, 476); // controls + key bus row + readouts + GR history
+
+    // Phase 6: start from the newest audio (records queued while the editor was closed are stale)
+    processorRef.getMeterBridge().discardPending();
+    scheduler->addClient (*this);
+}
+
+CompassCompressorAudioProcessorEditor::~CompassCompressorAudioProcessorEditor()
+{
+    scheduler->removeClient (*this);
+}
+
+bool CompassCompressorAudioProcessorEditor::isRefreshVisible() const
+{
+    if (! isShowing())
+        return false;
+    const auto* peer = getPeer();
+    return peer == nullptr || ! peer->isMinimised();
+}
+
+void CompassCompressorAudioProcessorEditor::applyKeyBusRouting()
+{
+    const auto role = (KeyBusRole) juce::jmax (0, keyBusRoleBox.getSelectedId() - 1);
+    const auto name = keyBusNameEditor.getText().trim();
+    if (role == shownKeyBusRole && name == shownKeyBusName)
+        return;
+
+    processorRef.setKeyBusRouting (role, name);
+    showKeyBusRouting();
+}
+
+void CompassCompressorAudioProcessorEditor::showKeyBusRouting()
+{
+    shownKeyBusRole = processorRef.getKeyBusRole();
+    shownKeyBusName = processorRef.getKeyBusName();
+    keyBusRoleBox.setSelectedId ((int) shownKeyBusRole + 1, juce::dontSendNotification);
+    keyBusNameEditor.setText (shownKeyBusName, false);
+
+    juce::String status;
+    if (shownKeyBusRole != KeyBusRole::off)
+        status = processorRef.isKeyBusConnected() ? "connected"
+                                                  : (shownKeyBusName.isEmpty() ? "needs a name" : "unavailable");
+    keyBusStatus.setText (status, juce::dontSendNotification);
+}
+
+void CompassCompressorAudioProcessorEditor::refreshFrame (bool visible)
+{
+    if (processorRef.getKeyBusRole() != shownKeyBusRole || processorRef.getKeyBusName() != shownKeyBusName)
+        showKeyBusRouting(); // restored by the host
+
+    const int n = processorRef.getMeterBridge().drain (meterRecords.data(), (int) meterRecords.size());
+    if (n <= 0)
+        return;
+
+    // The history keeps its time base while hidden (only the new columns are drawn, off screen)
+    grMeter.setSampleRate (processorRef.getSampleRate());
+    grMeter.pushRecords (meterRecords.data(), n);
+    if (! visible)
+        return;
+
+    MeterRecord frame = meterRecords[(size_t) (n - 1)];
+    double inEnergy = 0.0, outEnergy = 0.0;
+    int numSamples = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        const auto& r = meterRecords[(size_t) i];
+        frame.grDb       = juce::jmax (frame.grDb, r.grDb);
+        frame.inputPeak  = juce::jmax (frame.inputPeak, r.inputPeak);
+        frame.outputPeak = juce::jmax (frame.outputPeak, r.outputPeak);
+        inEnergy  += (double) r.inputRms * (double) r.inputRms * (double) r.numSamples;
+        outEnergy += (double) r.outputRms * (double) r.outputRms * (double) r.numSamples;
+        numSamples += r.numSamples;
+    }
+    if (numSamples > 0)
+    {
+        frame.inputRms  = (float) std::sqrt (inEnergy / (double) numSamples);
+        frame.outputRms = (float) std::sqrt (outEnergy / (double) numSamples);
+    }
+    frame.numSamples = numSamples;
+
+    auto lines = formatReadouts (frame);
+    if (lines != readoutLines)
+    {
+        readoutLines = std::move (lines);
+        repaint (textArea);
+    }
+}
+
+juce::StringArray CompassCompressorAudioProcessorEditor::formatReadouts (const MeterRecord& frame)
+{
+    const auto dbText = [] (float linear)
+    {
+        return linear > 0.0f ? juce::String (juce::Decibels::gainToDecibels (linear), 1) + " dB" : juce::String ("-inf dB");
+    };
+    juce::StringArray lines;
+    lines.add ("GR  " + juce::String (-frame.grDb, 1) + " dB");
+    lines.add ("In  peak " + dbText (frame.inputPeak) + "   rms " + dbText (frame.inputRms));
+    lines.add ("Out peak " + dbText (frame.outputPeak) + "   rms " + dbText (frame.outputRms));
+    lines.add ("Correlation " + juce::String (frame.correlation, 2)
+               + "   Link " + juce::String (juce::roundToInt (frame.linkAmount * 100.0f)) + "%"
+               + "   OS " + juce::String (juce::roundToInt (frame.osEngage01 * 100.0f)) + "%");
+    return lines;
 }
 
 void CompassCompressorAudioProcessorEditor::paint (juce::Graphics& g)
@@ -12,9 +136,35 @@ void CompassCompressorAudioProcessorEditor::paint (juce::Graphics& g)
     g.fillAll (juce::Colours::black);
     g.setColour (juce::Colours::white);
     g.setFont (16.0f);
-    g.drawFittedText ("Compass Compressor (Phase 0 Skeleton)", getLocalBounds(), juce::Justification::centred, 1);
+    g.drawFittedText ("Compass Compressor", getLocalBounds().reduced (12).removeFromTop (28),
+                      juce::Justification::centred, 1);
+
+    // Phase 6: live readouts from the meter bridge
+    auto area = textArea;
+    g.setFont (14.0f);
+    const int lineHeight = area.getHeight() / juce::jmax (1, readoutLines.size());
+    for (const auto& line : readoutLines)
+        g.drawFittedText (line, area.removeFromTop (lineHeight), juce::Justification::centredLeft, 1);
 }
 
 void CompassCompressorAudioProcessorEditor::resized()
 {
+    auto area = getLocalBounds().reduced (12);
+    area.removeFromTop (28); // title
+
+    auto controls = area.removeFromTop (96);
+    autoMakeupToggle.setBounds (controls.removeFromRight (88).withSizeKeepingCentre (88, 28));
+    const int knobWidth = controls.getWidth() / 6;
+    for (auto* knob : { &thresholdKnob, &ratioKnob, &attackKnob, &releaseKnob, &mixKnob, &outputGainKnob })
+        knob->setBounds (controls.removeFromLeft (knobWidth));
+
+    auto keyBusRow = area.removeFromTop (36).withSizeKeepingCentre (area.getWidth(), 24);
+    keyBusRoleBox.setBounds (keyBusRow.removeFromLeft (130));
+    keyBusRow.removeFromLeft (8);
+    keyBusNameEditor.setBounds (keyBusRow.removeFromLeft (180));
+    keyBusRow.removeFromLeft (8);
+    keyBusStatus.setBounds (keyBusRow);
+
+    textArea = area.removeFromTop (80);
+    grMeter.setBounds (area.withTrimmedTop (8));
 }
@@ -1,19 +1,55 @@
 #pragma once
 #include <JuceHeader.h>
 
-class CompassCompressorAudioProcessor;
+#include <array>
 
-class CompassCompressorAudioProcessorEditor final : public juce::AudioProcessorEditor
+#include "UI/AutoMakeupToggle.h"
+#include "UI/GrMeterComponent.h"
+#include "UI/KnobComponent.h"
+#include "UI/RepaintScheduler.h"
+#include "Util/FifoMeterBridge.h"
+#include "PluginProcessor.h"
+
+class CompassCompressorAudioProcessorEditor final : public juce::AudioProcessorEditor,
+                                                    private RepaintScheduler::Client
 {
 public:
     explicit CompassCompressorAudioProcessorEditor (CompassCompressorAudioProcessor&);
-    ~CompassCompressorAudioProcessorEditor() override = default;
+    ~CompassCompressorAudioProcessorEditor() override;
 
     void paint (juce::Graphics&) override;
     void resized() override;
 
 private:
+    // Phase 6: meter readouts (message thread), refreshed by the process-wide RepaintScheduler. Drains the
+    // processor's FifoMeterBridge and folds the records of one frame: peaks / GR = max, RMS = energy mean,
+    // the rest = newest. Readouts repaint only when their text changes.
+    void refreshFrame (bool visible) override;
+    bool isRefreshVisible() const override;
+    static juce::StringArray formatReadouts (const MeterRecord& frame);
+
+    // Phase 6: key bus routing row. Edits apply through the processor (saved with the state); a routing
+    // restored by the host while the editor is open is picked up on the next frame.
+    void applyKeyBusRouting();
+    void showKeyBusRouting();
+
+    using KeyBusRole = CompassCompressorAudioProcessor::KeyBusRole;
+
     CompassCompressorAudioProcessor& processorRef;
+    juce::SharedResourcePointer<RepaintScheduler> scheduler;
+    std::array<MeterRecord, FifoMeterBridge::kCapacity> meterRecords; // drain scratch (no per-frame allocation)
+    juce::StringArray readoutLines;
+
+    KnobComponent thresholdKnob, ratioKnob, attackKnob, releaseKnob, mixKnob, outputGainKnob;
+    AutoMakeupToggle autoMakeupToggle;
+    GrMeterComponent grMeter;      // Phase 6: GR / output level history (fed every frame)
+    juce::Rectangle<int> textArea; // readouts (repainted alone; the meter repaints itself)
+
+    juce::ComboBox keyBusRoleBox;
+    juce::TextEditor keyBusNameEditor;
+    juce::Label keyBusStatus;
+    KeyBusRole shownKeyBusRole = KeyBusRole::off; // routing the row last showed
+    juce::String shownKeyBusName;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompassCompressorAudioProcessorEditor)
 };
@@ -1,6 +1,13 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    // Phase 6: non-parameter state (properties of the APVTS state tree)
+    const juce::Identifier keyBusRoleId { "keyBusRole" };
+    const juce::Identifier keyBusNameId { "keyBusName" };
+}
+
 
 juce::AudioProcessorValueTreeState::ParameterLayout CompassCompressorAudioProcessor::createParameterLayout()
 {
@@ -23,6 +30,9 @@ juce::AudioProcessorValueTreeState::ParameterLayout CompassCompressorAudioProces
 
     auto outGainRange = juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f);
 
+    auto xoverRange = juce::NormalisableRange<float> (20.0f, 20000.0f, 0.1f);
+    xoverRange.setSkewForCentre (1000.0f);
+
     layout.add (std::make_unique<juce::AudioParameterFloat> ("threshold",    "Threshold",   thresholdRange, -18.0f));
     layout.add (std::make_unique<juce::AudioParameterFloat> ("ratio",        "Ratio",       ratioRange,      4.0f));
     layout.add (std::make_unique<juce::AudioParameterFloat> ("attack",       "Attack",      attackRange,    10.0f));
@@ -30,6 +40,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout CompassCompressorAudioProces
     layout.add (std::make_unique<juce::AudioParameterFloat> ("mix",          "Mix",         mixRange,     100.0f));
     layout.add (std::make_unique<juce::AudioParameterFloat> ("output_gain",  "Output Gain", outGainRange,   0.0f));
     layout.add (std::make_unique<juce::AudioParameterBool>  ("auto_makeup",  "Auto-Makeup", false));
+    layout.add (std::make_unique<juce::AudioParameterBool>  ("mid_side",     "Mid/Side",    false));
+    layout.add (std::make_unique<juce::AudioParameterChoice>("bands",        "Bands",       juce::StringArray { "Off", "2", "3", "4" }, 0));
+    layout.add (std::make_unique<juce::AudioParameterFloat> ("xover_low",    "Crossover Low",  xoverRange,  120.0f));
+    layout.add (std::make_unique<juce::AudioParameterFloat> ("xover_mid",    "Crossover Mid",  xoverRange, 1000.0f));
+    layout.add (std::make_unique<juce::AudioParameterFloat> ("xover_high",   "Crossover High", xoverRange, 6000.0f));
+    // Phase 6: a tier change re-prepares off the audio thread (timerCallback) and reports the new latency
+    layout.add (std::make_unique<juce::AudioParameterChoice>("quality",      "Quality",     juce::StringArray { "Eco", "Standard", "Mastering" }, 1));
 
     return layout;
 }
@@ -38,7 +55,68 @@ CompassCompressorAudioProcessor::CompassCompressorAudioProcessor()
 : juce::AudioProcessor (
       BusesProperties()
       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-      .withOutput ("Output", juce::AudioChannelSet::stereo(), true)), apvts(*this, nullptr, "Parameters", createParameterLayout()) {
+      .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+      .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)), apvts(*this, nullptr, "Parameters", createParameterLayout()) {
+    // Phase 6: resolve the parameter atomics once (the layout is fixed, so the pointers stay valid)
+    params.threshold  = apvts.getRawParameterValue ("threshold");
+    params.ratio      = apvts.getRawParameterValue ("ratio");
+    params.attack     = apvts.getRawParameterValue ("attack");
+    params.release    = apvts.getRawParameterValue ("release");
+    params.mix        = apvts.getRawParameterValue ("mix");
+    params.outputGain = apvts.getRawParameterValue ("output_gain");
+    params.autoMakeup = apvts.getRawParameterValue ("auto_makeup");
+    params.midSide    = apvts.getRawParameterValue ("mid_side");
+    params.bands      = apvts.getRawParameterValue ("bands");
+    params.xoverLow   = apvts.getRawParameterValue ("xover_low");
+    params.xoverMid   = apvts.getRawParameterValue ("xover_mid");
+    params.xoverHigh  = apvts.getRawParameterValue ("xover_high");
+    params.quality    = apvts.getRawParameterValue ("quality");
+    jassert (params.threshold != nullptr && params.ratio != nullptr && params.attack != nullptr
+             && params.release != nullptr && params.mix != nullptr && params.outputGain != nullptr
+             && params.autoMakeup != nullptr && params.midSide != nullptr && params.bands != nullptr
+             && params.xoverLow != nullptr && params.xoverMid != nullptr && params.xoverHigh != nullptr
+             && params.quality != nullptr);
+
+    startTimerHz (kReconfigureHz);
+}
+
+// Phase 6: relaxed loads of the cached atomics (each parameter is independent; no ordering needed)
+CompassCompressorAudioProcessor::ParameterSnapshot CompassCompressorAudioProcessor::loadParameters() const noexcept
+{
+    ParameterSnapshot p;
+    p.thresholdDb  = params.threshold->load (std::memory_order_relaxed);
+    p.ratio        = params.ratio->load (std::memory_order_relaxed);
+    p.attackMs     = params.attack->load (std::memory_order_relaxed);
+    p.releaseMs    = params.release->load (std::memory_order_relaxed);
+    p.mixPct       = params.mix->load (std::memory_order_relaxed);
+    p.outputGainDb = params.outputGain->load (std::memory_order_relaxed);
+    p.autoMakeup   = (params.autoMakeup->load (std::memory_order_relaxed) >= 0.5f);
+    p.midSide      = (params.midSide->load (std::memory_order_relaxed) >= 0.5f);
+    p.bandsIndex   = (int) params.bands->load (std::memory_order_relaxed);
+    p.xoverLowHz   = params.xoverLow->load (std::memory_order_relaxed);
+    p.xoverMidHz   = params.xoverMid->load (std::memory_order_relaxed);
+    p.xoverHighHz  = params.xoverHigh->load (std::memory_order_relaxed);
+    return p;
+}
+
+// Output gain (dB) + optional conservative auto-makeup (sealed)
+float CompassCompressorAudioProcessor::getTotalOutputGainDb (const ParameterSnapshot& p) noexcept
+{
+    float makeupDb = 0.0f;
+    if (p.autoMakeup)
+    {
+        // Conservative sealed heuristic: more makeup as threshold lowers and ratio rises (bounded)
+        const float thrPos = juce::jlimit(0.0f, 60.0f, -p.thresholdDb);                 // 0..60
+        const float rNorm  = juce::jlimit(0.0f, 1.0f, (p.ratio - 1.5f) / (20.0f - 1.5f)); // 0..1
+        makeupDb = juce::jlimit(0.0f, 12.0f, 0.12f * thrPos * (0.35f + 0.65f * rNorm));
+    }
+    return p.outputGainDb + makeupDb;
+}
+
+CompassCompressorAudioProcessor::~CompassCompressorAudioProcessor()
+{
+    stopTimer();
+    leaveKeyBus();
 }
 
 const juce::String CompassCompressorAudioProcessor::getName() const
@@ -86,78 +164,358 @@ void CompassCompressorAudioProcessor::changeProgramName (int, const juce::String
 
 void CompassCompressorAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    pipeline.prepare(sampleRate, samplesPerBlock);
+    const juce::ScopedLock sl (prepareLock);
+
+    // Phase 6: quality tier is fixed per prepare (a change re-prepares, see timerCallback)
+    activeTier = getRequestedTier();
+
+    // Phase 6: multiband (band pipelines, band buffers, worker threads) only while "bands" is not Off
+    const bool withMultiband = ((int) params.bands->load() > 0);
+
+    // Phase 6: the host fixes the precision before prepareToPlay; idle engines keep no workers
+    releaseResources();
+    if (isUsingDoublePrecision())
+        withActiveEngine<double> ([&] (auto& engine) { prepareEngine (engine, sampleRate, samplesPerBlock, withMultiband); });
+    else
+        withActiveEngine<float> ([&] (auto& engine) { prepareEngine (engine, sampleRate, samplesPerBlock, withMultiband); });
+
+    // Phase 6: the governor only acts in real time; offline renders keep every feature
+    cpuGovernor.prepare (sampleRate);
+    cpuGovernor.setEnabled (! isNonRealtime());
+
+    // Phase 6: output ramps start at the current settings (no fade-in)
+    const auto snapshot = loadParameters();
+    mixRamp.prepare (sampleRate, kOutputRampSec, ParamRamp::Shape::linear);
+    outGainRamp.prepare (sampleRate, kOutputRampSec, ParamRamp::Shape::linear);
+    mixRamp.reset (juce::jlimit (0.0, 1.0, (double) snapshot.mixPct * 0.01));
+    outGainRamp.reset (juce::Decibels::decibelsToGain ((double) getTotalOutputGainDb (snapshot)));
+
+    keyBusCapacity = samplesPerBlock;
+    localSampleClock = 0;
+
+    preparedSampleRate = sampleRate;
+    preparedBlockSize = samplesPerBlock;
+    multibandPrepared = withMultiband;
+}
+
+// Phase 6: "quality" as a tier; offline renders always run the Mastering tier
+QualityTier CompassCompressorAudioProcessor::getRequestedTier() const
+{
+    if (isNonRealtime())
+        return QualityTier::mastering;
+
+    const int qualityIndex = (int) params.quality->load();
+    return (qualityIndex <= 0 ? QualityTier::eco
+                              : qualityIndex >= 2 ? QualityTier::mastering : QualityTier::standard);
+}
+
+// Phase 6: "bands" switched between Off and on, or the tier changed, since the last prepare
+bool CompassCompressorAudioProcessor::needsReprepare() const
+{
+    const bool wantMultiband = ((int) params.bands->load() > 0);
+    return wantMultiband != multibandPrepared || getRequestedTier() != activeTier;
+}
+
+// Message thread. The host's own prepareToPlay / releaseResources take the same lock; a released processor
+// is left alone (the host prepares it again before the next block).
+void CompassCompressorAudioProcessor::timerCallback()
+{
+    const juce::ScopedLock sl (prepareLock);
+    if (preparedSampleRate <= 0.0 || ! needsReprepare())
+        return;
+
+    // Suspended: the wrapper outputs silence instead of calling processBlock while the engine is rebuilt
+    suspendProcessing (true);
+    prepareToPlay (preparedSampleRate, preparedBlockSize);
+    suspendProcessing (false);
+}
+
+MemoryFootprint CompassCompressorAudioProcessor::getMemoryFootprint() const
+{
+    MemoryFootprint footprint;
+    arena.addFootprint (footprint);
+
+    size_t engineBytes = 0;
+    const auto addEngine = [&] (const auto& engine)
+    {
+        engine.pipeline.addMemoryFootprint (footprint);
+        engine.multiband.addMemoryFootprint (footprint);
+        engineBytes = sizeof (engine.pipeline) + sizeof (engine.multiband);
+    };
+    const auto addActiveEngine = [&] (const auto& engines)
+    {
+        switch (activeTier)
+        {
+            case QualityTier::eco:       addEngine (engines.eco);       break;
+            case QualityTier::mastering: addEngine (engines.mastering); break;
+            case QualityTier::standard:
+            default:                     addEngine (engines.standard);  break;
+        }
+    };
+    if (isUsingDoublePrecision())
+        addActiveEngine (doubleEngines);
+    else
+        addActiveEngine (floatEngines);
+
+    // The processor object holds every tier's engine; the active pipeline and wrapper are counted above
+    footprint.add ("processor", sizeof (*this) - engineBytes);
+    return footprint;
+}
+
+template <typename EngineType>
+void CompassCompressorAudioProcessor::prepareEngine (EngineType& engine, double sampleRate, int samplesPerBlock,
+                                                     bool withMultiband)
+{
+    // Phase 6: default link groups from the negotiated main layout (front / LFE / surround pairs / heights)
+    const auto mainLayout = getChannelLayoutOfBus (false, 0);
+    maxBlockSize = juce::jmax (1, samplesPerBlock);
+
+    // Phase 6: lay out the instance arena (every stage reserves its buffers; one allocation at finish())
+    arena.clear (mainLayout.size());
+    engine.pipeline.setArena (arena);
+    engine.dryDelay.setArena (arena, "dry delay");
+
+    engine.pipeline.setLinkGroups (LinkGroupMap::fromChannelSet (mainLayout));
+    engine.pipeline.prepare(sampleRate, maxBlockSize);
+
+    // Phase 6: multiband mode (band pipelines, band buffers and worker threads are allocated here, and only
+    // when "bands" is on; see timerCallback)
+    if (withMultiband)
+    {
+        engine.multiband.setArena (arena);
+        engine.multiband.setLinkGroups (LinkGroupMap::fromChannelSet (mainLayout));
+        engine.multiband.prepare (sampleRate, maxBlockSize, mainLayout.size());
+    }
+
+    using SampleType = typename EngineType::Sample;
     // Phase 5: preallocate dry buffer for Mix (no allocations on audio thread)
-    dryBuffer.setSize (getTotalNumOutputChannels(), samplesPerBlock, false, false, true);
+    engine.dryOffset = arena.reserve<SampleType> (arena.getNumChannels() * maxBlockSize, "dry (mix)");
+
+    // Phase 6: key bus subscriber buffer (no allocations on audio thread)
+    engine.keyBusOffset = arena.reserve<SampleType> (KeyBus::kMaxChannels * maxBlockSize, "key bus");
+
+    // Phase 6: tier latency (lookahead + always-engaged oversampling); both modes report the same amount
+    const int latency = engine.pipeline.getLatencySamples();
+    jassert (! withMultiband || latency == engine.multiband.getLatencySamples());
+    engine.dryDelay.prepare (sampleRate, maxBlockSize);
+    engine.dryDelay.setDelaySamples (latency);
+    setLatencySamples (latency);
+
+    arena.finish();
 }
 
-void CompassCompressorAudioProcessor::releaseResources() {}
+void CompassCompressorAudioProcessor::releaseResources()
+{
+    const juce::ScopedLock sl (prepareLock);
+    preparedSampleRate = 0.0;
+    multibandPrepared = false;
+
+    floatEngines.eco.multiband.releaseResources();
+    floatEngines.standard.multiband.releaseResources();
+    floatEngines.mastering.multiband.releaseResources();
+    doubleEngines.eco.multiband.releaseResources();
+    doubleEngines.standard.multiband.releaseResources();
+    doubleEngines.mastering.multiband.releaseResources();
+}
 
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool CompassCompressorAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
-    // Minimal Phase 0: allow mono/stereo in==out only
+    // in==out only: mono, stereo, or the immersive layouts (5.1 / 7.1 / 7.1.4)
     const auto mainIn  = layouts.getMainInputChannelSet();
     const auto mainOut = layouts.getMainOutputChannelSet();
     if (mainIn != mainOut) return false;
-    return (mainOut == juce::AudioChannelSet::mono() || mainOut == juce::AudioChannelSet::stereo());
+    if (! (mainOut == juce::AudioChannelSet::mono()
+           || mainOut == juce::AudioChannelSet::stereo()
+           || mainOut == juce::AudioChannelSet::create5point1()
+           || mainOut == juce::AudioChannelSet::create7point1()
+           || mainOut == juce::AudioChannelSet::create7point1point4()))
+        return false;
+    if (mainOut.size() > ChannelGroups::kMaxChannels)
+        return false;
+
+    // Phase 6: optional sidechain key bus — disabled, mono or stereo (independent of main)
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto sc = layouts.getChannelSet (true, 1);
+        if (! (sc.isDisabled() || sc == juce::AudioChannelSet::mono() || sc == juce::AudioChannelSet::stereo()))
+            return false;
+    }
+    return true;
 }
 #endif
 
 void CompassCompressorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
-    // Phase 5: capture dry for    // Phase 5: post-pipeline controls (no topology change inside pipeline)
-    // Mix: dry/wet crossfade in [0..1]
-    const float mix01 = juce::jlimit(0.0f, 1.0f, mixPct * 0.01f);
+    processBlockT (buffer);
+}
 
-    // Output gain (dB) + optional conservative auto-makeup (sealed)
-    float makeupDb = 0.0f;
-    if (autoMakeup)
+void CompassCompressorAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    processBlockT (buffer);
+}
+
+// Phase 6: shared body of both processBlock overloads (the whole chain runs natively in SampleType)
+template <typename SampleType>
+void CompassCompressorAudioProcessor::processBlockT (juce::AudioBuffer<SampleType>& buffer)
+{
+    // Phase 6: FTZ / DAZ for the whole callback (restored on return)
+    const DenormalGuard denormalGuard;
+    const auto blockStart = CpuGovernor::now();
+    const int numSamples = buffer.getNumSamples();
+    withActiveEngine<SampleType> ([&] (auto& engine)
     {
-        // Conservative sealed heuristic: more makeup as threshold lowers and ratio rises (bounded)
-        const float thrPos = juce::jlimit(0.0f, 60.0f, -thrDb);                 // 0..60
-        const float rNorm  = juce::jlimit(0.0f, 1.0f, (ratio - 1.5f) / (20.0f - 1.5f)); // 0..1
-        makeupDb = juce::jlimit(0.0f, 12.0f, 0.12f * thrPos * (0.35f + 0.65f * rNorm));
-    }
+        // Arena buffers hold the prepared block size: larger host blocks run in chunks (views, no allocation)
+        for (int start = 0; start < numSamples; start += maxBlockSize)
+        {
+            juce::AudioBuffer<SampleType> chunk (buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                                 start, juce::jmin (maxBlockSize, numSamples - start));
+            processEngine (engine, chunk, start);
+        }
+    });
+    cpuGovernor.endBlock (blockStart, numSamples);
+}
 
-    const float totalOutDb = outGainDb + makeupDb;
-    const float outLin = juce::Decibels::decibelsToGain(totalOutDb);
+template <typename EngineType, typename SampleType>
+void CompassCompressorAudioProcessor::processEngine (EngineType& engine, juce::AudioBuffer<SampleType>& buffer,
+                                                     int offset)
+{
+    auto& pipeline = engine.pipeline;
+    auto& multiband = engine.multiband;
 
-    // Apply Mix + Output gain sample-accurate (no allocations)
-    const int chs = buffer.getNumChannels();
-    const int nSamp = buffer.getNumSamples();
-    for (int ch = 0; ch < chs; ++ch)
+    // Phase 6: main bus and optional sidechain key are views into the host buffer (no copy)
+    auto mainBuffer = getBusBuffer (buffer, false, 0);
+
+    const auto* scBus = (getBusCount (true) > 1 ? getBus (true, 1) : nullptr);
+    const bool hasKey = (scBus != nullptr && scBus->isEnabled() && scBus->getNumberOfChannels() > 0);
+    auto keyBuffer = hasKey ? getBusBuffer (buffer, true, 1) : juce::AudioBuffer<SampleType>();
+
+    // Phase 6: key bus — publish our pre-compression detector signal / subscribe to another instance's
+    const juce::AudioBuffer<SampleType>* key = hasKey ? &keyBuffer : nullptr;
+    juce::AudioBuffer<SampleType> keyBusBuffer; // view into the arena
+    if (keyBusPublisher != nullptr || keyBusSubscriber != nullptr)
     {
-        float* w = buffer.getWritePointer(ch);
-        const float* d = dryBuffer.getReadPointer(ch);
-        for (int i = 0; i < nSamp; ++i)
+        std::int64_t timestamp = -1;
+        if (auto* playHead = getPlayHead())
+            if (const auto pos = playHead->getPosition())
+                if (const auto t = pos->getTimeInSamples())
+                    timestamp = *t + offset;
+
+        if (keyBusPublisher != nullptr)
+            keyBusPublisher->publish (hasKey ? keyBuffer : mainBuffer,
+                                      timestamp >= 0 ? timestamp : localSampleClock);
+
+        const int nSamp = mainBuffer.getNumSamples();
+        if (key == nullptr && keyBusSubscriber != nullptr && nSamp <= keyBusCapacity)
         {
-            const float wet = w[i];
-            const float dry = d[i];
-            const float x = dry + mix01 * (wet - dry);
-            w[i] = x * outLin;
+            SampleType* keyLines[KeyBus::kMaxChannels];
+            for (int ch = 0; ch < KeyBus::kMaxChannels; ++ch)
+                keyLines[ch] = arena.get<SampleType> (engine.keyBusOffset) + ch * maxBlockSize;
+            keyBusBuffer.setDataToReferTo (keyLines, KeyBus::kMaxChannels, nSamp);
+            if (keyBusSubscriber->read (timestamp, keyBusBuffer, keyBusCapacity))
+                key = &keyBusBuffer; // underrun / gap -> fall back to the main input
         }
     }
- 
-    dryBuffer.makeCopyOf (buffer, true);
+    localSampleClock += buffer.getNumSamples();
 
     // Phase 5: read APVTS params (raw) and feed pipeline targets (pipeline handles smoothing)
-    
-    const float thrDb      = apvts.getRawParameterValue("threshold")->load();
-    const float ratioVal   = apvts.getRawParameterValue("ratio")->load();
-    const float attackMs   = apvts.getRawParameterValue("attack")->load();
-    const float releaseMs  = apvts.getRawParameterValue("release")->load();
-    const float mixPct     = apvts.getRawParameterValue("mix")->load();
-    const float outGainDb  = apvts.getRawParameterValue("output_gain")->load();
-    const bool  autoMakeup = (apvts.getRawParameterValue("auto_makeup")->load() >= 0.5f);
+    // Phase 6: one snapshot of the cached atomics per block
+    const auto p = loadParameters();
+    const float thrDb      = p.thresholdDb;
+    const float ratioVal   = p.ratio;
+    const float attackMs   = p.attackMs;
+    const float releaseMs  = p.releaseMs;
+    const bool  midSide    = p.midSide;
+    const int   bandsIndex = p.bandsIndex;
+
+    // Phase 5: capture dry for Mix (Phase 6: delayed by the tier latency so dry and wet stay aligned)
+    const int chs = juce::jmin (mainBuffer.getNumChannels(), arena.getNumChannels());
+    const int nSamp = mainBuffer.getNumSamples();
+    SampleType* dryLines[ChannelGroups::kMaxChannels];
+    juce::AudioBuffer<SampleType> dryBuffer; // view into the arena
+    for (int ch = 0; ch < chs; ++ch)
+    {
+        dryLines[ch] = arena.get<SampleType> (engine.dryOffset) + ch * maxBlockSize;
+        std::copy (mainBuffer.getReadPointer (ch), mainBuffer.getReadPointer (ch) + nSamp, dryLines[ch]);
+    }
+    dryBuffer.setDataToReferTo (dryLines, chs, nSamp);
+    engine.dryDelay.process (dryBuffer);
+
+    // Phase 6: meter record (input levels before the chain; the rest after Mix / output gain)
+    MeterRecord meter;
+    meter.numSamples = nSamp;
+    MeterRecord::measureLevels (mainBuffer, chs, meter.inputPeak, meter.inputRms);
+
+    // Phase 6: "bands" switched on but not prepared yet (timerCallback re-prepares): single band meanwhile
+    const auto stereoMode = (midSide ? StereoMode::midSide : StereoMode::leftRight);
+    if (bandsIndex > 0 && multiband.isPrepared())
+    {
+        // Phase 6: multiband (bands = index + 1; all bands share the user controls)
+        multiband.setNumBands (bandsIndex + 1);
+        multiband.setCrossoverHz (0, (double) p.xoverLowHz);
+        multiband.setCrossoverHz (1, (double) p.xoverMidHz);
+        multiband.setCrossoverHz (2, (double) p.xoverHighHz);
+        multiband.setControlTargets ((double)thrDb, (double)ratioVal, (double)attackMs, (double)releaseMs);
+        multiband.setStereoMode (stereoMode);
+        multiband.setDegradationLevel (cpuGovernor.getLevel());
+        multiband.process (mainBuffer, key);
+        meter.grDb       = (float) multiband.getGainReductionDb();
+        meter.linkAmount = (float) multiband.getLinkAmount();
+        meter.osEngage01 = (float) multiband.getOversamplingEngage01();
+    }
+    else
+    {
+        pipeline.setControlTargets((double)thrDb, (double)ratioVal, (double)attackMs, (double)releaseMs);
+        pipeline.setStereoMode (stereoMode);
+        pipeline.setDegradationLevel (cpuGovernor.getLevel());
+        pipeline.process(mainBuffer, key);
+        meter.grDb       = (float) pipeline.getGainReductionDb();
+        meter.linkAmount = (float) pipeline.getLinkAmount();
+        meter.osEngage01 = (float) pipeline.getOversamplingEngage01();
+    }
+
+    // Phase 5: post-pipeline controls (no topology change inside pipeline)
+    // Mix: dry/wet crossfade in [0..1]
+    const float mix01 = juce::jlimit(0.0f, 1.0f, p.mixPct * 0.01f);
+
+    // Output gain (dB) + optional conservative auto-makeup (sealed; see getTotalOutputGainDb)
+    mixRamp.setTarget ((double) mix01);
+    outGainRamp.setTarget (juce::Decibels::decibelsToGain ((double) getTotalOutputGainDb (p)));
+
+    // Apply Mix + Output gain sample-accurate (no allocations)
+    // Phase 6: unity fast path — fully wet at unity gain with both ramps settled leaves the wet signal as is
+    const bool neutral = (! mixRamp.isSmoothing() && mixRamp.getCurrent() == 1.0
+                          && ! outGainRamp.isSmoothing() && outGainRamp.getCurrent() == 1.0);
 
-    pipeline.setControlTargets((double)thrDb, (double)ratioVal, (double)attackMs, (double)releaseMs);
+    // Phase 6: per-sample ramps, one tile at a time (every channel reads the same ramp values)
+    if (! neutral)
+    {
+        for (int start = 0; start < nSamp; start += ChannelGroups::kTileSize)
+        {
+            const int len = juce::jmin (ChannelGroups::kTileSize, nSamp - start);
+            double mixLane[ChannelGroups::kTileSize];
+            double gainLane[ChannelGroups::kTileSize];
+            mixRamp.fill (mixLane, len);
+            outGainRamp.fill (gainLane, len);
 
-    pipeline.process(buffer);
+            for (int ch = 0; ch < chs; ++ch)
+            {
+                SampleType* w = mainBuffer.getWritePointer(ch, start);
+                const SampleType* d = dryBuffer.getReadPointer(ch, start);
+                for (int i = 0; i < len; ++i)
+                {
+                    const SampleType wet = w[i];
+                    const SampleType dry = d[i];
+                    const SampleType x = dry + (SampleType) mixLane[i] * (wet - dry);
+                    w[i] = x * (SampleType) gainLane[i];
+                }
+            }
+        }
+    }
 
-    juce::ScopedNoDenormals noDenormals;
-    // Phase 0 pass-through: do nothing
-    (void) buffer;
+    MeterRecord::measureLevels (mainBuffer, chs, meter.outputPeak, meter.outputRms);
+    meter.correlation = MeterRecord::measureCorrelation (mainBuffer, chs);
+    meterBridge.push (meter);
 }
 
 bool CompassCompressorAudioProcessor::hasEditor() const { return true; }
@@ -166,8 +524,79 @@ juce::AudioProcessorEditor* CompassCompressorAudioProcessor::createEditor()
     return new CompassCompressorAudioProcessorEditor (*this);
 }
 
-void CompassCompressorAudioProcessor::getStateInformation (juce::MemoryBlock&) {}
-void CompassCompressorAudioProcessor::setStateInformation (const void*, int) {}
+bool CompassCompressorAudioProcessor::publishToKeyBus (const juce::String& busName)
+{
+    leaveKeyBus();
+    auto* bus = KeyBusRegistry::getInstance().acquire (busName.toRawUTF8(), KeyBusRegistry::Role::publisher);
+
+    const juce::ScopedLock sl (getCallbackLock());
+    keyBusPublisher = bus;
+    return bus != nullptr;
+}
+
+bool CompassCompressorAudioProcessor::subscribeToKeyBus (const juce::String& busName)
+{
+    leaveKeyBus();
+    auto* bus = KeyBusRegistry::getInstance().acquire (busName.toRawUTF8(), KeyBusRegistry::Role::subscriber);
+
+    const juce::ScopedLock sl (getCallbackLock());
+    keyBusSubscriber = bus;
+    return bus != nullptr;
+}
+
+void CompassCompressorAudioProcessor::leaveKeyBus()
+{
+    KeyBus* pub = nullptr;
+    KeyBus* sub = nullptr;
+    {
+        // Detach under the callback lock so processBlock never sees a released bus
+        const juce::ScopedLock sl (getCallbackLock());
+        std::swap (pub, keyBusPublisher);
+        std::swap (sub, keyBusSubscriber);
+    }
+
+    KeyBusRegistry::getInstance().release (pub, KeyBusRegistry::Role::publisher);
+    KeyBusRegistry::getInstance().release (sub, KeyBusRegistry::Role::subscriber);
+}
+
+bool CompassCompressorAudioProcessor::setKeyBusRouting (KeyBusRole role, const juce::String& busName)
+{
+    apvts.state.setProperty (keyBusRoleId, (int) role, nullptr);
+    apvts.state.setProperty (keyBusNameId, busName.trim().substring (0, KeyBus::kMaxNameLength - 1), nullptr);
+    return applyKeyBusRouting();
+}
+
+bool CompassCompressorAudioProcessor::applyKeyBusRouting()
+{
+    keyBusRole = (KeyBusRole) juce::jlimit (0, 2, (int) apvts.state.getProperty (keyBusRoleId, 0));
+    keyBusName = apvts.state.getProperty (keyBusNameId).toString();
+
+    switch (keyBusRole)
+    {
+        case KeyBusRole::publish:   return publishToKeyBus (keyBusName);
+        case KeyBusRole::subscribe: return subscribeToKeyBus (keyBusName);
+        case KeyBusRole::off:
+        default:                    leaveKeyBus(); return true;
+    }
+}
+
+// Phase 6: parameters plus the key bus routing (properties of the same tree)
+void CompassCompressorAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    const auto state = apvts.copyState();
+    if (const auto xml = state.createXml())
+        copyXmlToBinary (*xml, destData);
+}
+
+void CompassCompressorAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    const auto xml = getXmlFromBinary (data, sizeInBytes);
+    if (xml == nullptr || ! xml->hasTagName (apvts.state.getType()))
+        return;
+
+    apvts.replaceState (juce::ValueTree::fromXml (*xml));
+    applyKeyBusRouting();
+}
 
 // This factory must exist for AU/VST3 builds
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
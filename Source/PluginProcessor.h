@@ -1,12 +1,25 @@
 #pragma once
 #include <JuceHeader.h>
+
+#include <type_traits>
+
 #include "Core/CompressorPipeline.h"
+#include "Core/CpuGovernor.h"
+#include "Core/DspArena.h"
+#include "Core/KeyBus.h"
+#include "Core/LookaheadDelay.h"
+#include "Core/MultibandCompressor.h"
+#include "Core/ParamRamp.h"
+#include "Core/QualityTier.h"
+#include "Util/DenormalGuard.h"
+#include "Util/FifoMeterBridge.h"
 
-class CompassCompressorAudioProcessor final : public juce::AudioProcessor
+class CompassCompressorAudioProcessor final : public juce::AudioProcessor,
+                                              private juce::Timer
 {
 public:
     CompassCompressorAudioProcessor();
-    ~CompassCompressorAudioProcessor() override = default;
+    ~CompassCompressorAudioProcessor() override;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
@@ -16,6 +29,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -36,12 +51,170 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    // Phase 6: in-process key bus routing (message thread). One publisher per bus name; any number of
+    // subscribers. A subscriber keys its detector from the bus unless the host sidechain bus is active.
+    // Saved with the plugin state (not a parameter: it names another instance, nothing to automate) and
+    // re-joined on restore. Returns false when the bus cannot be joined (empty name, every bus slot in use,
+    // or the bus already has a publisher); the routing is kept and shown as disconnected.
+    enum class KeyBusRole { off, publish, subscribe };
+    bool setKeyBusRouting (KeyBusRole role, const juce::String& busName);
+    KeyBusRole getKeyBusRole() const noexcept     { return keyBusRole; }
+    const juce::String& getKeyBusName() const     { return keyBusName; }
+    bool isKeyBusConnected() const noexcept       { return keyBusPublisher != nullptr || keyBusSubscriber != nullptr; }
+
+    // Phase 6: CPU governor telemetry (any thread). Level = CpuGovernor::Level; load = fraction of the
+    // real-time budget used by processBlock (smoothed).
+    int getDegradationLevel() const noexcept { return cpuGovernor.getLevel(); }
+    float getCpuLoad() const noexcept        { return cpuGovernor.getLoad(); }
+
+    // Phase 6: this instance's memory by stage (message thread; valid after prepareToPlay): the arena's
+    // regions, the active engine's stages and hot state, and the processor object itself
+    MemoryFootprint getMemoryFootprint() const;
+
+    // Phase 6: per-block meter telemetry (this instance's own ring). The audio thread pushes one record per
+    // processed block; the editor is the single consumer and drains it at display rate.
+    FifoMeterBridge& getMeterBridge() noexcept { return meterBridge; }
+
+    // Parameter state for the editor's attachments (message thread)
+    juce::AudioProcessorValueTreeState& getValueTreeState() noexcept { return apvts; }
+
 private:
-    CompressorPipeline pipeline;
+    // Phase 6: parameter atomics resolved once in the constructor (no string lookups on the audio thread)
+    struct ParameterHandles
+    {
+        std::atomic<float>* threshold   = nullptr;
+        std::atomic<float>* ratio       = nullptr;
+        std::atomic<float>* attack      = nullptr;
+        std::atomic<float>* release     = nullptr;
+        std::atomic<float>* mix         = nullptr;
+        std::atomic<float>* outputGain  = nullptr;
+        std::atomic<float>* autoMakeup  = nullptr;
+        std::atomic<float>* midSide     = nullptr;
+        std::atomic<float>* bands       = nullptr;
+        std::atomic<float>* xoverLow    = nullptr;
+        std::atomic<float>* xoverMid    = nullptr;
+        std::atomic<float>* xoverHigh   = nullptr;
+        std::atomic<float>* quality     = nullptr;
+    };
+
+    // Phase 6: one block's view of the user controls (plain values, read once per block)
+    struct ParameterSnapshot
+    {
+        float thresholdDb  = -18.0f;
+        float ratio        = 4.0f;
+        float attackMs     = 10.0f;
+        float releaseMs    = 100.0f;
+        float mixPct       = 100.0f;
+        float outputGainDb = 0.0f;
+        bool  autoMakeup   = false;
+        bool  midSide      = false;
+        int   bandsIndex   = 0;
+        float xoverLowHz   = 120.0f;
+        float xoverMidHz   = 1000.0f;
+        float xoverHighHz  = 6000.0f;
+    };
+
+    ParameterSnapshot loadParameters() const noexcept;
+    static float getTotalOutputGainDb (const ParameterSnapshot& p) noexcept;
+
+    // Phase 6: one engine per host precision and quality tier; only the active one is prepared
+    template <typename SampleType, QualityTier Tier>
+    struct Engine
+    {
+        using Sample = SampleType;
+
+        CompressorPipeline<SampleType, Tier> pipeline;
+        MultibandCompressor<SampleType, Tier> multiband; // prepared only while "bands" != Off
+
+        // Phase 5: parameter smoothing + wiring support (no UI)
+        // Phase 6: buffers are arena regions laid out in prepareToPlay (channel lines of the prepared block size)
+        int dryOffset = 0;    // Mix blend dry copy (arena channels)
+        int keyBusOffset = 0; // key bus subscriber buffer (KeyBus::kMaxChannels)
+        LookaheadDelay<SampleType> dryDelay; // Phase 6: aligns dry with the tier's reported latency
+    };
+
+    template <typename SampleType>
+    struct TierEngines
+    {
+        Engine<SampleType, QualityTier::eco>       eco;
+        Engine<SampleType, QualityTier::standard>  standard;
+        Engine<SampleType, QualityTier::mastering> mastering;
+    };
+
+    TierEngines<float>  floatEngines;
+    TierEngines<double> doubleEngines;
+    QualityTier activeTier = QualityTier::standard; // chosen in prepareToPlay (getRequestedTier)
+    DspArena arena;      // Phase 6: every audio-thread buffer of the active engine (one allocation)
+    int maxBlockSize = 0; // Phase 6: prepared block size; larger host blocks are processed in chunks
+    CpuGovernor cpuGovernor; // Phase 6: sheds optional work of the active tier under sustained load
+    FifoMeterBridge meterBridge; // Phase 6: audio thread -> editor meter records
+
+    // Phase 6: per-sample Mix / output gain ramps (sample-accurate, independent of the host block size)
+    static constexpr double kOutputRampSec = 0.010;
+    ParamRamp mixRamp;      // mix 0..1, linear
+    ParamRamp outGainRamp;  // linear gain (output gain + auto-makeup), linear
+
+    template <typename SampleType>
+    TierEngines<SampleType>& getEngines()
+    {
+        if constexpr (std::is_same<SampleType, double>::value)
+            return doubleEngines;
+        else
+            return floatEngines;
+    }
+
+    // fn(engine) with the engine of the active tier (the switch resolves to one concrete instantiation)
+    template <typename SampleType, typename Fn>
+    void withActiveEngine (Fn&& fn)
+    {
+        auto& engines = getEngines<SampleType>();
+        switch (activeTier)
+        {
+            case QualityTier::eco:       fn (engines.eco);       break;
+            case QualityTier::mastering: fn (engines.mastering); break;
+            case QualityTier::standard:
+            default:                     fn (engines.standard);  break;
+        }
+    }
+
+    template <typename EngineType>
+    void prepareEngine (EngineType& engine, double sampleRate, int samplesPerBlock, bool withMultiband);
+
+    // Phase 6: configuration that needs a re-prepare (multiband on / off, quality tier) is applied on the
+    // message thread: the timer compares the parameters with the prepared configuration and re-prepares with
+    // processing suspended (a tier change also reports its latency to the host there). Until then the audio
+    // thread keeps running the prepared configuration.
+    static constexpr int kReconfigureHz = 10;
+    void timerCallback() override;
+    bool needsReprepare() const;
+    QualityTier getRequestedTier() const;
+
+    juce::CriticalSection prepareLock; // prepareToPlay / releaseResources / timerCallback
+    double preparedSampleRate = 0.0;   // 0 = not prepared (released)
+    int preparedBlockSize = 0;
+    bool multibandPrepared = false;
+
+    template <typename SampleType>
+    void processBlockT (juce::AudioBuffer<SampleType>& buffer);
+
+    // buffer: at most maxBlockSize samples; offset = its position in the host block (key bus timeline)
+    template <typename EngineType, typename SampleType>
+    void processEngine (EngineType& engine, juce::AudioBuffer<SampleType>& buffer, int offset);
+
+    // Phase 6: key bus membership (message thread; handles swapped under the callback lock)
+    bool publishToKeyBus (const juce::String& busName);
+    bool subscribeToKeyBus (const juce::String& busName);
+    void leaveKeyBus();
+    bool applyKeyBusRouting(); // joins the bus named in the state
 
-    // Phase 5: parameter smoothing + wiring support (no UI)
-    juce::AudioBuffer<float> dryBuffer; // preallocated in prepareToPlay for Mix blend
+    KeyBusRole keyBusRole = KeyBusRole::off; // as last applied from the state
+    juce::String keyBusName;
+    KeyBus* keyBusPublisher  = nullptr;
+    KeyBus* keyBusSubscriber = nullptr;
+    int keyBusCapacity = 0;
+    std::int64_t localSampleClock = 0; // fallback timeline when the host provides none
     juce::AudioProcessorValueTreeState apvts;
+    ParameterHandles params;
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompassCompressorAudioProcessor)
 };
@@ -0,0 +1,91 @@
+#include "AutoMakeupToggle.h"
+
+AutoMakeupToggle::AutoMakeupToggle (juce::AudioProcessorValueTreeState& state)
+    : juce::ToggleButton ("Auto Makeup")
+{
+    attachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment> (state, "auto_makeup", *this);
+}
+
+AutoMakeupToggle::~AutoMakeupToggle()
+{
+    attachment.reset(); // detach before the button goes away
+}
+
+void AutoMakeupToggle::resized()
+{
+    juce::ToggleButton::resized();
+    updateStateImages();
+}
+
+// One strip per physical button size, shared by every instance through juce::ImageCache
+void AutoMakeupToggle::updateStateImages()
+{
+    const float scale = juce::Component::getApproximateScaleFactorForComponent (this);
+    const int w = juce::roundToInt ((float) getWidth() * scale);
+    const int h = juce::roundToInt ((float) getHeight() * scale);
+    if (w <= 0 || h <= 0)
+    {
+        stateImages = {};
+        physicalWidth = physicalHeight = 0;
+        return;
+    }
+    if (w == physicalWidth && h == physicalHeight && stateImages.isValid())
+        return;
+
+    const auto key = ("compass.automakeup.v1." + juce::String (w) + "x" + juce::String (h)).hashCode64();
+    stateImages = juce::ImageCache::getFromHashCode (key);
+    if (! stateImages.isValid())
+    {
+        stateImages = renderStateImages (w, h, scale);
+        juce::ImageCache::addImageToCache (stateImages, key);
+    }
+    physicalWidth = w;
+    physicalHeight = h;
+}
+
+juce::Image AutoMakeupToggle::renderStateImages (int physicalWidth, int physicalHeight, float scale)
+{
+    juce::Image strip (juce::Image::ARGB, physicalWidth, physicalHeight * kNumStates, true);
+    juce::Graphics g (strip);
+
+    const auto bounds = juce::Rectangle<float> ((float) physicalWidth, (float) physicalHeight).reduced (1.0f * scale);
+    const float corner = bounds.getHeight() * 0.5f;
+
+    for (int s = 0; s < kNumStates; ++s)
+    {
+        const juce::Graphics::ScopedSaveState save (g);
+        g.setOrigin (0, s * physicalHeight);
+
+        const bool on = (s == kOn || s == kOnHighlighted);
+        const bool highlighted = (s == kOffHighlighted || s == kOnHighlighted);
+
+        g.setColour (juce::Colour (on ? 0xff3a2418 : 0xff1c2024).brighter (highlighted ? 0.25f : 0.0f));
+        g.fillRoundedRectangle (bounds, corner);
+        g.setColour (juce::Colour (on ? 0xffff8a3a : 0xff4a5058));
+        g.drawRoundedRectangle (bounds, corner, 1.0f * scale);
+
+        // LED + caption
+        auto content = bounds.reduced (corner * 0.6f, 0.0f);
+        const float led = bounds.getHeight() * 0.36f;
+        const auto ledArea = content.removeFromLeft (led).withSizeKeepingCentre (led, led);
+        g.setColour (on ? juce::Colour (0xffff8a3a) : juce::Colour (0xff2e3640));
+        g.fillEllipse (ledArea);
+
+        g.setColour (on ? juce::Colours::white : juce::Colours::grey);
+        g.setFont (12.0f * scale);
+        g.drawFittedText ("AUTO MAKEUP", content.toNearestInt(), juce::Justification::centred, 1);
+    }
+    return strip;
+}
+
+void AutoMakeupToggle::paintButton (juce::Graphics& g, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown)
+{
+    updateStateImages(); // the display scale may have changed (window moved to another screen)
+    if (! stateImages.isValid())
+        return;
+
+    const bool highlighted = shouldDrawButtonAsHighlighted || shouldDrawButtonAsDown;
+    const int state = getToggleState() ? (highlighted ? kOnHighlighted : kOn)
+                                       : (highlighted ? kOffHighlighted : kOff);
+    g.drawImage (stateImages, 0, 0, getWidth(), getHeight(), 0, state * physicalHeight, physicalWidth, physicalHeight);
+}
@@ -0,0 +1,31 @@
+// Phase 6 — AutoMakeupToggle ("auto_makeup" on / off)
+// A juce::ToggleButton drawn from pre-rendered state images: off / on x normal / highlighted, stacked in one
+// strip at the button's physical pixel size, rendered once per size and shared process-wide through
+// juce::ImageCache. paintButton() is one image blit.
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <memory>
+
+class AutoMakeupToggle final : public juce::ToggleButton
+{
+public:
+    explicit AutoMakeupToggle (juce::AudioProcessorValueTreeState& state);
+    ~AutoMakeupToggle() override;
+
+    void paintButton (juce::Graphics&, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown) override;
+    void resized() override;
+
+private:
+    enum State { kOff, kOffHighlighted, kOn, kOnHighlighted, kNumStates };
+
+    void updateStateImages();
+    static juce::Image renderStateImages (int physicalWidth, int physicalHeight, float scale);
+
+    juce::Image stateImages; // kNumStates images stacked vertically (physical pixels)
+    int physicalWidth = 0, physicalHeight = 0;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> attachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutoMakeupToggle)
+};
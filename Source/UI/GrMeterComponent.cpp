@@ -0,0 +1,209 @@
+#include "GrMeterComponent.h"
+
+//==============================================================================
+MinMaxPyramid::Column MinMaxPyramid::Column::merge (const Column& a, const Column& b) noexcept
+{
+    Column c;
+    c.grMin    = juce::jmin (a.grMin, b.grMin);
+    c.grMax    = juce::jmax (a.grMax, b.grMax);
+    c.levelMin = juce::jmin (a.levelMin, b.levelMin);
+    c.levelMax = juce::jmax (a.levelMax, b.levelMax);
+    return c;
+}
+
+MinMaxPyramid::MinMaxPyramid()
+    : storage ((size_t) (kNumLevels * kCapacity))
+{
+}
+
+void MinMaxPyramid::clear() noexcept
+{
+    counts.fill (0);
+}
+
+void MinMaxPyramid::push (const Column& column) noexcept
+{
+    Column carry = column;
+    for (int level = 0; level < kNumLevels; ++level)
+    {
+        const std::int64_t index = counts[(size_t) level]++;
+        storage[(size_t) (level * kCapacity) + (size_t) (index & kMask)] = carry;
+
+        // An odd index completes a pair: its parent column goes one level up
+        if ((index & 1) == 0)
+            break;
+        carry = Column::merge (getColumn (level, index - 1), carry);
+    }
+}
+
+//==============================================================================
+GrMeterComponent::GrMeterComponent()
+{
+    setOpaque (true);
+}
+
+void GrMeterComponent::setSampleRate (double sampleRate)
+{
+    if (! (sampleRate > 0.0) || sampleRate == currentSampleRate)
+        return;
+
+    currentSampleRate = sampleRate;
+    samplesPerColumn = juce::jmax (1.0, sampleRate * kBaseColumnMs * 0.001);
+    openSamples = 0.0;
+    openColumnEmpty = true;
+}
+
+void GrMeterComponent::pushRecords (const MeterRecord* records, int numRecords)
+{
+    const std::int64_t before = pyramid.getNumColumns (zoomLevel);
+
+    for (int i = 0; i < numRecords; ++i)
+    {
+        const auto& r = records[i];
+        const float gr = juce::jlimit (0.0f, kGrRangeDb, r.grDb);
+        const float level = juce::jmax (MinMaxPyramid::kFloorDb,
+                                        juce::Decibels::gainToDecibels (r.outputPeak, MinMaxPyramid::kFloorDb));
+        if (openColumnEmpty)
+        {
+            openColumn.grMin = openColumn.grMax = gr;
+            openColumn.levelMin = openColumn.levelMax = level;
+            openColumnEmpty = false;
+        }
+        else
+        {
+            openColumn.grMin    = juce::jmin (openColumn.grMin, gr);
+            openColumn.grMax    = juce::jmax (openColumn.grMax, gr);
+            openColumn.levelMin = juce::jmin (openColumn.levelMin, level);
+            openColumn.levelMax = juce::jmax (openColumn.levelMax, level);
+        }
+
+        // A record longer than a column closes several (the same values: the record is the finest detail)
+        openSamples += (double) juce::jmax (1, r.numSamples);
+        while (openSamples >= samplesPerColumn)
+        {
+            pyramid.push (openColumn);
+            openSamples -= samplesPerColumn;
+            openColumnEmpty = (openSamples <= 0.0);
+        }
+    }
+
+    if (pyramid.getNumColumns (zoomLevel) != before)
+    {
+        renderNewColumns();
+        repaint();
+    }
+}
+
+void GrMeterComponent::setZoomLevel (int level)
+{
+    level = juce::jlimit (0, MinMaxPyramid::kNumLevels - 1, level);
+    if (level == zoomLevel)
+        return;
+
+    zoomLevel = level;
+    invalidateStrip();
+    renderNewColumns();
+    repaint();
+}
+
+void GrMeterComponent::clearHistory()
+{
+    pyramid.clear();
+    openSamples = 0.0;
+    openColumnEmpty = true;
+    invalidateStrip();
+    repaint();
+}
+
+void GrMeterComponent::mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails& wheel)
+{
+    if (wheel.deltaY != 0.0f)
+        setZoomLevel (zoomLevel + (wheel.deltaY < 0.0f ? 1 : -1));
+}
+
+void GrMeterComponent::resized()
+{
+    invalidateStrip();
+    renderNewColumns();
+}
+
+// The strip starts empty (background); the next render redraws at most one width of columns from the pyramid
+void GrMeterComponent::invalidateStrip()
+{
+    const int w = getWidth(), h = getHeight();
+    if (w <= 0 || h <= 0)
+    {
+        strip = {};
+        return;
+    }
+
+    if (! strip.isValid() || strip.getWidth() != w || strip.getHeight() != h)
+        strip = juce::Image (juce::Image::RGB, w, h, false);
+
+    juce::Graphics g (strip);
+    g.fillAll (juce::Colours::black);
+    renderedUpTo = 0;
+}
+
+// Only the columns closed since the last render (at most one width: older ones scrolled out)
+void GrMeterComponent::renderNewColumns()
+{
+    if (! strip.isValid())
+        return;
+
+    const int w = strip.getWidth();
+    const std::int64_t total = pyramid.getNumColumns (zoomLevel);
+    const std::int64_t oldestKept = juce::jmax ((std::int64_t) 0, total - (std::int64_t) MinMaxPyramid::kCapacity);
+    const std::int64_t first = juce::jmax (renderedUpTo, juce::jmax (total - (std::int64_t) w, oldestKept));
+    if (first >= total)
+        return;
+
+    juce::Graphics g (strip);
+    for (std::int64_t i = first; i < total; ++i)
+        renderColumn (g, pyramid.getColumn (zoomLevel, i), (int) (i % w));
+    renderedUpTo = total;
+}
+
+// One pixel column: output level band from the bottom (dim), GR from the top (range to the deepest value,
+// min..max band bright)
+void GrMeterComponent::renderColumn (juce::Graphics& g, const MinMaxPyramid::Column& column, int x) const
+{
+    const float h = (float) strip.getHeight();
+    const auto levelY = [h] (float db) { return h * (db / MinMaxPyramid::kFloorDb); };
+    const auto grY = [h] (float db) { return h * (db / kGrRangeDb); };
+
+    g.setColour (juce::Colours::black);
+    g.fillRect ((float) x, 0.0f, 1.0f, h);
+
+    g.setColour (juce::Colour (0xff2a3a4a));
+    g.fillRect ((float) x, levelY (column.levelMax), 1.0f, h - levelY (column.levelMax));
+    g.setColour (juce::Colour (0xff4a6a8a));
+    g.fillRect ((float) x, levelY (column.levelMax), 1.0f, juce::jmax (1.0f, levelY (column.levelMin) - levelY (column.levelMax)));
+
+    if (column.grMax > 0.0f)
+    {
+        g.setColour (juce::Colour (0xff7a3a1a));
+        g.fillRect ((float) x, 0.0f, 1.0f, grY (column.grMin));
+        g.setColour (juce::Colour (0xffff8a3a));
+        g.fillRect ((float) x, grY (column.grMin), 1.0f, juce::jmax (1.0f, grY (column.grMax) - grY (column.grMin)));
+    }
+}
+
+// Newest column at the right edge: image [split, w) then [0, split), where split = total % w
+void GrMeterComponent::paint (juce::Graphics& g)
+{
+    if (! strip.isValid())
+    {
+        g.fillAll (juce::Colours::black);
+        return;
+    }
+
+    const int w = strip.getWidth(), h = strip.getHeight();
+    const int split = (int) (renderedUpTo % w);
+    g.drawImage (strip, 0, 0, w - split, h, split, 0, w - split, h);
+    if (split > 0)
+        g.drawImage (strip, w - split, 0, split, h, 0, 0, split, h);
+
+    g.setColour (juce::Colours::grey);
+    g.drawText ("x" + juce::String (1 << zoomLevel), getLocalBounds().reduced (4), juce::Justification::topRight, false);
+}
@@ -0,0 +1,111 @@
+// Phase 6 — GrMeterComponent (scrolling gain-reduction / output-level history)
+//
+// MinMaxPyramid: the history as min/max pairs at kNumLevels zoom levels, one ring of kCapacity columns per
+// level. A level-L column covers 2^L base columns. Base columns close every kBaseColumnMs of audio; each
+// closed column folds into the level above once its sibling exists, so an update costs O(1) amortized and
+// every level stays current without rescanning history.
+//
+// GrMeterComponent renders one level into a circular backing image, one column per pixel. A frame draws only
+// the columns that closed since the last frame into their strip of the image, and paint() blits the image in
+// at most two slices (oldest | newest). Per-frame cost is bounded by the component width, never by the
+// history length; a zoom change or resize re-renders one width of columns from the pyramid.
+//
+// Message thread only. The editor feeds it the records it drains from FifoMeterBridge.
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../Util/FifoMeterBridge.h"
+
+class MinMaxPyramid
+{
+public:
+    static constexpr int kNumLevels = 6;    // level L column = 2^L base columns
+    static constexpr int kCapacity  = 2048; // columns per level (power of two)
+
+    struct Column
+    {
+        float grMin    = 0.0f; // GR (dB of reduction)
+        float grMax    = 0.0f;
+        float levelMin = kFloorDb; // output peak (dBFS)
+        float levelMax = kFloorDb;
+
+        static Column merge (const Column& a, const Column& b) noexcept;
+    };
+
+    static constexpr float kFloorDb = -60.0f;
+
+    MinMaxPyramid();
+
+    void clear() noexcept;
+
+    // Appends a closed base column and folds completed pairs up the pyramid
+    void push (const Column& column) noexcept;
+
+    // Columns ever written at a level; the ring keeps the newest kCapacity of them
+    std::int64_t getNumColumns (int level) const noexcept { return counts[(size_t) level]; }
+
+    // index in [max(0, getNumColumns(level) - kCapacity), getNumColumns(level))
+    const Column& getColumn (int level, std::int64_t index) const noexcept
+    {
+        return storage[(size_t) (level * kCapacity) + (size_t) (index & kMask)];
+    }
+
+private:
+    static constexpr std::int64_t kMask = kCapacity - 1;
+    static_assert ((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+    std::vector<Column> storage; // kNumLevels x kCapacity (allocated once)
+    std::array<std::int64_t, kNumLevels> counts {};
+};
+
+class GrMeterComponent final : public juce::Component
+{
+public:
+    static constexpr double kBaseColumnMs = 5.0; // base column length (level 0: 2048 columns = ~10 s)
+    static constexpr float  kGrRangeDb = 24.0f;  // matches the GR safety clamp
+
+    GrMeterComponent();
+
+    // Audio sample rate of the feed (base column length in samples); resets the open column on change
+    void setSampleRate (double sampleRate);
+
+    // Meter feed (message thread): records in arrival order. Closes base columns by record length, renders the
+    // columns that closed at the displayed level and repaints if any did.
+    void pushRecords (const MeterRecord* records, int numRecords);
+
+    // Displayed pyramid level (0 = finest); also changed with the mouse wheel
+    void setZoomLevel (int level);
+    int getZoomLevel() const noexcept { return zoomLevel; }
+
+    void clearHistory();
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    void mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails&) override;
+
+private:
+    void renderNewColumns();
+    void renderColumn (juce::Graphics& g, const MinMaxPyramid::Column& column, int x) const;
+    void invalidateStrip();
+
+    MinMaxPyramid pyramid;
+
+    // Open base column (folded from records until kBaseColumnMs of audio has arrived)
+    MinMaxPyramid::Column openColumn;
+    bool openColumnEmpty = true;
+    double samplesPerColumn = 240.0;
+    double openSamples = 0.0;
+    double currentSampleRate = 48000.0;
+
+    // Backing strip: column index i of the displayed level lives at x = i % width
+    juce::Image strip;
+    std::int64_t renderedUpTo = 0; // next displayed-level column to render
+    int zoomLevel = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrMeterComponent)
+};
@@ -0,0 +1,129 @@
+#include "KnobComponent.h"
+
+namespace
+{
+    constexpr int kLabelHeight = 16;
+
+    const juce::Colour kBodyColour   { 0xff1c2024 };
+    const juce::Colour kTrackColour  { 0xff2e3640 };
+    const juce::Colour kValueColour  { 0xffff8a3a };
+    const juce::Colour kPointerColour{ 0xffe8e8e8 };
+}
+
+KnobComponent::KnobComponent (juce::AudioProcessorValueTreeState& state, const juce::String& parameterID,
+                              const juce::String& labelText)
+    : juce::Slider (juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::NoTextBox),
+      label (labelText)
+{
+    setPaintingIsUnclipped (true);
+    attachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment> (state, parameterID, *this);
+}
+
+KnobComponent::~KnobComponent()
+{
+    attachment.reset(); // detach before the slider goes away
+}
+
+juce::Rectangle<int> KnobComponent::getKnobArea() const
+{
+    auto area = getLocalBounds().withTrimmedBottom (kLabelHeight * 2);
+    const int size = juce::jmin (area.getWidth(), area.getHeight());
+    return area.withSizeKeepingCentre (size, size);
+}
+
+void KnobComponent::resized()
+{
+    juce::Slider::resized();
+    updateFilmstrip();
+}
+
+// One strip per physical knob size, shared by every instance through juce::ImageCache (released by the
+// cache once no knob of that size is left)
+void KnobComponent::updateFilmstrip()
+{
+    const float scale = juce::Component::getApproximateScaleFactorForComponent (this);
+    const int physical = juce::roundToInt ((float) getKnobArea().getWidth() * scale);
+    if (physical <= 0)
+    {
+        filmstrip = {};
+        framePixels = 0;
+        return;
+    }
+    if (physical == framePixels && filmstrip.isValid())
+        return;
+
+    const auto key = ("compass.knob.v2." + juce::String (physical)).hashCode64();
+    filmstrip = juce::ImageCache::getFromHashCode (key);
+    if (! filmstrip.isValid())
+    {
+        filmstrip = renderFilmstrip (physical, getRotaryParameters());
+        juce::ImageCache::addImageToCache (filmstrip, key);
+    }
+    framePixels = physical;
+}
+
+juce::Image KnobComponent::renderFilmstrip (int physicalSize, const juce::Slider::RotaryParameters& rotary)
+{
+    const float s = (float) physicalSize;
+    juce::Image strip (juce::Image::ARGB, physicalSize * kAtlasColumns, physicalSize * kAtlasRows, true);
+    juce::Graphics g (strip);
+
+    const float centre = s * 0.5f;
+    const float radius = s * 0.5f - s * 0.06f;
+    const float trackWidth = juce::jmax (1.5f, s * 0.07f);
+    const float arcRadius = radius - trackWidth * 0.5f;
+
+    for (int f = 0; f < kNumFrames; ++f)
+    {
+        const juce::Graphics::ScopedSaveState save (g);
+        g.setOrigin ((f % kAtlasColumns) * physicalSize, (f / kAtlasColumns) * physicalSize);
+
+        const float proportion = (float) f / (float) (kNumFrames - 1);
+        const float angle = rotary.startAngleRadians + proportion * (rotary.endAngleRadians - rotary.startAngleRadians);
+
+        g.setColour (kBodyColour);
+        g.fillEllipse (centre - radius * 0.78f, centre - radius * 0.78f, radius * 1.56f, radius * 1.56f);
+
+        juce::Path track;
+        track.addCentredArc (centre, centre, arcRadius, arcRadius, 0.0f,
+                             rotary.startAngleRadians, rotary.endAngleRadians, true);
+        g.setColour (kTrackColour);
+        g.strokePath (track, juce::PathStrokeType (trackWidth, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+
+        if (f > 0)
+        {
+            juce::Path value;
+            value.addCentredArc (centre, centre, arcRadius, arcRadius, 0.0f, rotary.startAngleRadians, angle, true);
+            g.setColour (kValueColour);
+            g.strokePath (value, juce::PathStrokeType (trackWidth, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+        }
+
+        const juce::Point<float> tip (centre + radius * 0.7f * std::sin (angle), centre - radius * 0.7f * std::cos (angle));
+        const juce::Point<float> base (centre + radius * 0.2f * std::sin (angle), centre - radius * 0.2f * std::cos (angle));
+        g.setColour (kPointerColour);
+        g.drawLine ({ base, tip }, juce::jmax (1.0f, s * 0.035f));
+    }
+    return strip;
+}
+
+void KnobComponent::paint (juce::Graphics& g)
+{
+    updateFilmstrip(); // the display scale may have changed (window moved to another screen)
+
+    const auto knob = getKnobArea();
+    if (filmstrip.isValid())
+    {
+        const int frame = juce::jlimit (0, kNumFrames - 1,
+                                        juce::roundToInt (valueToProportionOfLength (getValue()) * (kNumFrames - 1)));
+        g.drawImage (filmstrip, knob.getX(), knob.getY(), knob.getWidth(), knob.getHeight(),
+                     (frame % kAtlasColumns) * framePixels, (frame / kAtlasColumns) * framePixels,
+                     framePixels, framePixels);
+    }
+
+    auto text = getLocalBounds().removeFromBottom (kLabelHeight * 2);
+    g.setColour (juce::Colours::white);
+    g.setFont (13.0f);
+    g.drawFittedText (getTextFromValue (getValue()), text.removeFromTop (kLabelHeight), juce::Justification::centred, 1);
+    g.setColour (juce::Colours::grey);
+    g.drawFittedText (label, text, juce::Justification::centred, 1);
+}
@@ -0,0 +1,41 @@
+// Phase 6 — KnobComponent (rotary control for one APVTS parameter)
+// A juce::Slider drawn from a pre-rendered filmstrip: kNumFrames knob images (one per value step) at the
+// component's physical pixel size, rendered once per size and shared process-wide through juce::ImageCache,
+// so every open editor reuses the same strip. paint() is one image blit plus the label / value text; the
+// value snaps to the nearest frame for drawing only (the parameter keeps full resolution).
+// The frames are laid out as a kAtlasColumns x kAtlasRows atlas, not one vertical strip: a 128 px knob
+// (64 pt at 2x) is a 2048 x 1024 image (8 MB) instead of 128 x 16384, which is past the texture size limit
+// of many GPU-backed image types.
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <memory>
+
+class KnobComponent final : public juce::Slider
+{
+public:
+    static constexpr int kNumFrames    = 128;
+    static constexpr int kAtlasColumns = 16;
+    static constexpr int kAtlasRows    = kNumFrames / kAtlasColumns;
+    static_assert (kAtlasColumns * kAtlasRows == kNumFrames, "the atlas must hold every frame");
+
+    KnobComponent (juce::AudioProcessorValueTreeState& state, const juce::String& parameterID, const juce::String& labelText);
+    ~KnobComponent() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    // Knob square (logical coordinates) and the strip for its current physical size
+    juce::Rectangle<int> getKnobArea() const;
+    void updateFilmstrip();
+    static juce::Image renderFilmstrip (int physicalSize, const juce::Slider::RotaryParameters& rotary);
+
+    juce::String label;
+    juce::Image filmstrip; // kNumFrames squares, row-major in the atlas (physical pixels)
+    int framePixels = 0;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnobComponent)
+};
@@ -0,0 +1,40 @@
+#include "RepaintScheduler.h"
+
+#include <algorithm>
+
+RepaintScheduler::~RepaintScheduler()
+{
+    stopTimer();
+}
+
+void RepaintScheduler::addClient (Client& client)
+{
+    if (std::find (clients.begin(), clients.end(), &client) == clients.end())
+        clients.push_back (&client);
+
+    if (! isTimerRunning())
+        startTimerHz (kFrameRateHz);
+}
+
+void RepaintScheduler::removeClient (Client& client)
+{
+    clients.erase (std::remove (clients.begin(), clients.end(), &client), clients.end());
+
+    if (clients.empty())
+        stopTimer();
+}
+
+void RepaintScheduler::timerCallback()
+{
+    ++frame;
+
+    // Index loop: a client may remove itself (or another) from its refresh
+    for (size_t i = 0; i < clients.size(); ++i)
+    {
+        auto* client = clients[i];
+        if (client->isRefreshVisible())
+            client->refreshFrame (true);
+        else if ((frame + i) % (std::uint64_t) kHiddenFrameDivider == 0)
+            client->refreshFrame (false);
+    }
+}
@@ -0,0 +1,54 @@
+// Phase 6 — RepaintScheduler (one frame clock for every open editor in the process)
+// Editors register as clients instead of running their own juce::Timer. One timer wakes the message thread
+// once per frame and refreshes every client in the same callback: meter feeds are drained and each client
+// marks its dirty rectangles with repaint(rect), which JUCE coalesces per window into the next paint.
+// With N editors open that is one wake-up per frame instead of N unaligned ones.
+//
+// Hidden clients (not showing, or their window minimised) are refreshed every kHiddenFrameDivider frames
+// only, with visible = false: they drain their feeds so nothing overruns, but skip the drawing work. Hidden
+// clients are staggered across frames so they do not all land on the same one.
+//
+// Shared through juce::SharedResourcePointer: the scheduler (and its timer) exists while at least one
+// editor holds it. Message thread only.
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <cstdint>
+#include <vector>
+
+class RepaintScheduler final : private juce::Timer
+{
+public:
+    static constexpr int kFrameRateHz = 30;
+    static constexpr int kHiddenFrameDivider = 8; // hidden editors: ~4 Hz, feeds drained, no drawing
+
+    struct Client
+    {
+        virtual ~Client() = default;
+
+        // One frame of work. visible = false: drain feeds only (the client is hidden; nothing would be drawn)
+        virtual void refreshFrame (bool visible) = 0;
+
+        // Showing on screen and not minimised
+        virtual bool isRefreshVisible() const = 0;
+    };
+
+    RepaintScheduler() = default;
+    ~RepaintScheduler() override;
+
+    // The timer runs while there is at least one client
+    void addClient (Client& client);
+    void removeClient (Client& client);
+
+    int getNumClients() const noexcept          { return (int) clients.size(); }
+    std::uint64_t getFrameCount() const noexcept { return frame; }
+
+private:
+    void timerCallback() override;
+
+    std::vector<Client*> clients;
+    std::uint64_t frame = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RepaintScheduler)
+};
@@ -0,0 +1,83 @@
+#include "FifoMeterBridge.h"
+
+#include <iterator>
+
+namespace
+{
+    constexpr float MeterRecord::* kRecordFields[] = { &MeterRecord::grDb,       &MeterRecord::inputPeak,
+                                                       &MeterRecord::inputRms,   &MeterRecord::outputPeak,
+                                                       &MeterRecord::outputRms,  &MeterRecord::correlation,
+                                                       &MeterRecord::osEngage01, &MeterRecord::linkAmount };
+}
+
+// Producer: the slot's stamp is cleared before the record is written and set (release) after it, the same
+// sequence-lock pattern as KeyBus. The write index never waits for the consumer.
+void FifoMeterBridge::push (const MeterRecord& record) noexcept
+{
+    const std::uint64_t index = writeIndex.load(std::memory_order_relaxed);
+    Slot& slot = slots[(size_t) (index & kMask)];
+    static_assert (std::size(kRecordFields) == kNumFields, "one slot field per MeterRecord float");
+
+    slot.stamp.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int f = 0; f < kNumFields; ++f)
+        slot.fields[(size_t) f].store(record.*kRecordFields[f], std::memory_order_relaxed);
+    slot.numSamples.store(record.numSamples, std::memory_order_relaxed);
+    slot.stamp.store(index + 1, std::memory_order_release);
+
+    writeIndex.store(index + 1, std::memory_order_release);
+}
+
+bool FifoMeterBridge::pop (MeterRecord& dest) noexcept
+{
+    return drain(&dest, 1) == 1;
+}
+
+// Consumer: at most kCapacity slot visits per call (wait-free). A slot whose stamp is not the expected
+// index + 1 (overwritten, or being written) or changes while copying is dropped.
+int FifoMeterBridge::drain (MeterRecord* dest, int maxRecords) noexcept
+{
+    int copied = 0;
+    for (int visits = 0; visits < kCapacity && copied < maxRecords; ++visits)
+    {
+        const std::uint64_t written = writeIndex.load(std::memory_order_acquire);
+        if (readIndex == written)
+            break;
+
+        // Overrun: the oldest pending records were overwritten
+        if (written - readIndex > (std::uint64_t) kCapacity)
+        {
+            dropped += written - (std::uint64_t) kCapacity - readIndex;
+            readIndex = written - (std::uint64_t) kCapacity;
+        }
+
+        const Slot& slot = slots[(size_t) (readIndex & kMask)];
+        const std::uint64_t expected = readIndex + 1;
+        ++readIndex;
+
+        if (slot.stamp.load(std::memory_order_acquire) != expected)
+        {
+            ++dropped;
+            continue;
+        }
+
+        MeterRecord record;
+        for (int f = 0; f < kNumFields; ++f)
+            record.*kRecordFields[f] = slot.fields[(size_t) f].load(std::memory_order_relaxed);
+        record.numSamples = slot.numSamples.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.stamp.load(std::memory_order_relaxed) != expected)
+        {
+            ++dropped;
+            continue;
+        }
+
+        dest[copied++] = record;
+    }
+    return copied;
+}
+
+void FifoMeterBridge::discardPending() noexcept
+{
+    readIndex = writeIndex.load(std::memory_order_acquire);
+}
@@ -0,0 +1,146 @@
+// Phase 6 — FifoMeterBridge (audio thread -> UI telemetry)
+// Single-producer / single-consumer ring of compact per-block meter records. One bridge per processor
+// instance (no shared state, so instances never interfere).
+//
+// Threading:
+// - push(): the audio thread (one producer). Wait-free and allocation-free; never waits for the reader.
+//   A full ring overwrites its oldest record.
+// - pop() / drain(): the UI (one consumer, e.g. the editor's timer at display rate). Wait-free: each slot
+//   carries a sequence stamp, and a record the producer overwrote mid-copy is dropped instead of retried.
+//   Skipped or overwritten records are counted (getNumDropped()).
+//
+// Levels are linear (peak = max |x|, RMS over the block, every main channel); GR in dB of reduction (>= 0).
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+struct MeterRecord
+{
+    float grDb        = 0.0f; // deepest gain reduction at the block end (dB, >= 0)
+    float inputPeak   = 0.0f;
+    float inputRms    = 0.0f;
+    float outputPeak  = 0.0f;
+    float outputRms   = 0.0f;
+    float correlation = 0.0f; // output channels 0/1, -1..+1 (0 = silence; 1 = single channel)
+    float osEngage01  = 0.0f; // oversampling safety engage ramp
+    float linkAmount  = 0.0f; // strongest stereo link amount (0..1)
+    int   numSamples  = 0;
+
+    // Peak and RMS over the first numChannels channels (audio thread; no allocation). Four independent
+    // accumulators per reduction keep the loops off one serial dependency chain.
+    template <typename SampleType>
+    static void measureLevels (const juce::AudioBuffer<SampleType>& buffer, int numChannels, float& peak, float& rms)
+    {
+        const int chs = juce::jmin(buffer.getNumChannels(), numChannels);
+        const int n = buffer.getNumSamples();
+        double sumSq = 0.0;
+        SampleType maxAbs = 0;
+        for (int ch = 0; ch < chs; ++ch)
+        {
+            const SampleType* x = buffer.getReadPointer(ch);
+            SampleType m[4] {}, e[4] {};
+            int i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                for (int k = 0; k < 4; ++k)
+                {
+                    const SampleType v = std::abs(x[i + k]);
+                    m[k] = (v > m[k] ? v : m[k]);
+                    e[k] += v * v;
+                }
+            }
+            for (; i < n; ++i)
+            {
+                const SampleType v = std::abs(x[i]);
+                m[0] = (v > m[0] ? v : m[0]);
+                e[0] += v * v;
+            }
+            maxAbs = juce::jmax(maxAbs, juce::jmax(juce::jmax(m[0], m[1]), juce::jmax(m[2], m[3])));
+            sumSq += (double) ((e[0] + e[1]) + (e[2] + e[3]));
+        }
+        peak = sanitize((float) maxAbs);
+        rms  = (chs > 0 && n > 0 ? sanitize((float) std::sqrt(sumSq / (double) (chs * n))) : 0.0f);
+    }
+
+    // Normalized cross-correlation of channels 0/1 over the block
+    template <typename SampleType>
+    static float measureCorrelation (const juce::AudioBuffer<SampleType>& buffer, int numChannels)
+    {
+        const int n = buffer.getNumSamples();
+        if (juce::jmin(buffer.getNumChannels(), numChannels) < 2)
+            return (n > 0 && numChannels > 0 ? 1.0f : 0.0f);
+
+        const SampleType* l = buffer.getReadPointer(0);
+        const SampleType* r = buffer.getReadPointer(1);
+        SampleType lr[4] {}, ll[4] {}, rr[4] {};
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                lr[k] += l[i + k] * r[i + k];
+                ll[k] += l[i + k] * l[i + k];
+                rr[k] += r[i + k] * r[i + k];
+            }
+        }
+        for (; i < n; ++i)
+        {
+            lr[0] += l[i] * r[i];
+            ll[0] += l[i] * l[i];
+            rr[0] += r[i] * r[i];
+        }
+        const auto sum4 = [] (const SampleType* a) { return (double) ((a[0] + a[1]) + (a[2] + a[3])); };
+        const double energy = std::sqrt(sum4(ll) * sum4(rr));
+        if (!(energy > 1.0e-20))
+            return 0.0f;
+        return juce::jlimit(-1.0f, 1.0f, sanitize((float) (sum4(lr) / energy)));
+    }
+
+    static float sanitize (float v) { return std::isfinite(v) ? v : 0.0f; }
+};
+
+struct FifoMeterBridge
+{
+    static constexpr int kCapacity = 256; // records (power of two); > 5 UI frames of 32-sample blocks @ 48 kHz
+
+    // Producer (audio thread)
+    void push (const MeterRecord& record) noexcept;
+
+    // Consumer (UI thread): oldest record first. false = nothing new.
+    bool pop (MeterRecord& dest) noexcept;
+
+    // Consumer: up to maxRecords records (at most kCapacity per call), oldest first; returns the number copied
+    int drain (MeterRecord* dest, int maxRecords) noexcept;
+
+    // Consumer: skip everything pending (e.g. an editor that was hidden)
+    void discardPending() noexcept;
+
+    // Records the consumer never saw (overrun or overwritten while copying); consumer thread
+    std::uint64_t getNumDropped() const noexcept { return dropped; }
+
+private:
+    static constexpr std::uint64_t kMask = kCapacity - 1;
+    static_assert ((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+    static constexpr int kNumFields = 8; // MeterRecord's float fields
+
+    // Record fields are relaxed atomics (plain loads / stores on x86 and arm64), so a copy that races the
+    // producer is merely discarded, never undefined
+    struct Slot
+    {
+        std::atomic<std::uint64_t> stamp { 0 }; // index + 1 once written; 0 while the producer writes it
+        std::array<std::atomic<float>, kNumFields> fields {};
+        std::atomic<int> numSamples { 0 };
+    };
+
+    std::array<Slot, kCapacity> slots;
+
+    alignas(64) std::atomic<std::uint64_t> writeIndex { 0 }; // producer
+    alignas(64) std::uint64_t readIndex = 0;                  // consumer only
+    std::uint64_t dropped = 0;                                // consumer only
+};
@@ -0,0 +1,31 @@
+// Minimal check helpers for the Core tests: each test is a plain executable that returns the failure count
+// (CTest treats non-zero as a failure).
+
+#pragma once
+
+#include <cstdio>
+
+namespace TestUtil
+{
+    inline int& failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline void expect (bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            ++failures();
+            std::printf("FAIL: %s\n", what);
+        }
+    }
+
+    inline int finish (const char* testName)
+    {
+        std::printf("%s: %s (%d failure%s)\n", testName, failures() == 0 ? "passed" : "FAILED", failures(),
+                    failures() == 1 ? "" : "s");
+        return failures();
+    }
+}
@@ -0,0 +1,123 @@
+// Band pool crossover benchmark: serial band loop vs BandWorkerPool::run() for 2..4 band pipelines
+// (Standard tier, stereo, 48 kHz) across block sizes. Prints us per block for both and the smallest block size
+// from which the pool wins by more than kMargin at every larger size, to check
+// MultibandCompressor::kMinParallelBlockSize on a given machine.
+// On a machine without a spare hardware thread the pool starts no workers and both columns are serial.
+//
+//   bench_band_pool [blocks per measurement]
+
+#include "BandWorkerPool.h"
+#include "CompressorPipeline.h"
+#include "MultibandCompressor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Sample   = float;
+    using Pipeline = CompressorPipeline<Sample, QualityTier::standard>;
+
+    constexpr int kChannels = 2;
+    constexpr double kMargin = 1.05; // speedup below this is measurement noise
+    constexpr double kSampleRate = 48000.0;
+
+    struct Bands
+    {
+        std::vector<std::unique_ptr<Pipeline>> pipelines;
+        std::vector<juce::AudioBuffer<Sample>> buffers;
+    };
+
+    void runBand (void* context, int b)
+    {
+        auto& bands = *static_cast<Bands*> (context);
+        bands.pipelines[(size_t) b]->process(bands.buffers[(size_t) b]);
+    }
+
+    void fill (Bands& bands, std::mt19937& rng)
+    {
+        std::normal_distribution<Sample> noise (0.0f, 0.3f);
+        for (auto& buffer : bands.buffers)
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.getWritePointer(ch)[i] = noise(rng);
+    }
+
+    // Best of 5 runs, us per block
+    template <typename Fn>
+    double measure (Bands& bands, int numBlocks, Fn&& process)
+    {
+        std::mt19937 rng (1);
+        double best = 1.0e30;
+        for (int rep = 0; rep < 5; ++rep)
+        {
+            double total = 0.0;
+            for (int blk = 0; blk < numBlocks; ++blk)
+            {
+                fill(bands, rng);
+                const auto t0 = std::chrono::steady_clock::now();
+                process();
+                const auto t1 = std::chrono::steady_clock::now();
+                total += std::chrono::duration<double, std::micro> (t1 - t0).count();
+            }
+            best = std::min(best, total / numBlocks);
+        }
+        return best;
+    }
+}
+
+int main (int argc, char** argv)
+{
+    const int numBlocks = (argc > 1 ? std::max(1, std::atoi(argv[1])) : 400);
+
+    BandWorkerPool pool;
+    pool.start(BandWorkerPool::kMaxWorkers, 2048, kSampleRate);
+    std::printf("workers: %d (hardware threads: %u)  kMinParallelBlockSize: %d\n\n", pool.getNumWorkers(),
+                std::thread::hardware_concurrency(),
+                MultibandCompressor<Sample, QualityTier::standard>::kMinParallelBlockSize);
+    std::printf("bands  block   serial us   pool us   speedup\n");
+
+    for (int numBands = 2; numBands <= MultibandCompressor<Sample>::kMaxBands; ++numBands)
+    {
+        int crossover = -1;
+        for (int block : { 32, 64, 128, 256, 512, 1024, 2048 })
+        {
+            Bands bands;
+            for (int b = 0; b < numBands; ++b)
+            {
+                bands.pipelines.push_back(std::make_unique<Pipeline>());
+                bands.pipelines.back()->setLinkGroups(LinkGroupMap::allLinked(kChannels));
+                bands.pipelines.back()->setOutputStagesEnabled(false);
+                bands.pipelines.back()->prepare(kSampleRate, block);
+                bands.pipelines.back()->setControlTargets(-24.0, 4.0, 10.0, 100.0);
+                bands.buffers.emplace_back(kChannels, block);
+            }
+
+            const double serial = measure(bands, numBlocks, [&]
+            {
+                for (int b = 0; b < numBands; ++b)
+                    runBand(&bands, b);
+            });
+            const double parallel = measure(bands, numBlocks, [&] { pool.run(&runBand, &bands, numBands); });
+
+            if (serial / parallel < kMargin)
+                crossover = -1;
+            else if (crossover < 0)
+                crossover = block;
+            std::printf("%5d  %5d  %10.2f  %8.2f  %7.2fx\n", numBands, block, serial, parallel, serial / parallel);
+        }
+        if (pool.getNumWorkers() == 0)
+            std::printf("  %d bands: no workers (serial both ways)\n\n", numBands);
+        else if (crossover > 0)
+            std::printf("  %d bands: pool wins from %d samples\n\n", numBands, crossover);
+        else
+            std::printf("  %d bands: pool never wins here\n\n", numBands);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Denormal benchmark: a 1 kHz sine fades from 0 dBFS to -300 dBFS over 8 s, then 8 s of silence follow
+// (48 kHz, stereo, 256-sample blocks, release 1 s). Prints the median ns/sample of each 1 s bin (seconds 1-8
+// are the fade, 9-16 the silence) with the DenormalGuard held around every process() call (as processBlock
+// does) and without it (thread default: no FTZ / DAZ), for every tier and precision and the 4-band multiband.
+// With the recursive state flushed at -300 dBFS (DenormalGuard::flush) both rows should stay flat through the
+// silence; "worst / fade" is the slowest silence bin over the median fade bin. "idle" counts blocks that took
+// the idle fast path, which skips the stages under test.
+//
+//   bench_denormal
+
+#include "CompressorPipeline.h"
+#include "MultibandCompressor.h"
+#include "Util/DenormalGuard.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr int kBlock = 256;
+    constexpr int kChannels = 2;
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kFadeSeconds = 8;
+    constexpr int kSilenceSeconds = 8;
+    constexpr int kNumBins = kFadeSeconds + kSilenceSeconds;
+    constexpr double kFloorDb = -300.0;
+
+    template <typename Processor>
+    constexpr bool isMultiband = false;
+    template <typename T, QualityTier Tier>
+    constexpr bool isMultiband<MultibandCompressor<T, Tier>> = true;
+
+    double median (std::vector<double> v)
+    {
+        std::sort(v.begin(), v.end());
+        return v.empty() ? 0.0 : v[v.size() / 2];
+    }
+
+    template <typename Processor, typename T>
+    void run (const char* name, bool guarded)
+    {
+        Processor processor;
+        processor.setLinkGroups(LinkGroupMap::allLinked(kChannels));
+        if constexpr (isMultiband<Processor>)
+        {
+            processor.setNumBands(MultibandCompressor<T>::kMaxBands);
+            processor.prepare(kSampleRate, kBlock, kChannels);
+        }
+        else
+        {
+            processor.prepare(kSampleRate, kBlock);
+        }
+        processor.setControlTargets(-24.0, 4.0, 10.0, 1000.0);
+        processor.reset();
+
+        const int samplesPerBin = (int) kSampleRate;
+        const int totalSamples = kNumBins * samplesPerBin;
+        std::vector<std::vector<double>> bins ((size_t) kNumBins);
+        juce::AudioBuffer<T> buffer (kChannels, kBlock);
+        int idleBlocks = 0;
+
+        for (int start = 0; start + kBlock <= totalSamples; start += kBlock)
+        {
+            for (int i = 0; i < kBlock; ++i)
+            {
+                const int n = start + i;
+                const double t = (double) n / kSampleRate;
+                const double gain = (t < kFadeSeconds ? std::pow(10.0, kFloorDb * t / (20.0 * kFadeSeconds)) : 0.0);
+                const double x = gain * std::sin(2.0 * juce::MathConstants<double>::pi * 1000.0 * t);
+                buffer.getWritePointer(0)[i] = (T) x;
+                buffer.getWritePointer(1)[i] = (T) (0.5 * x);
+            }
+
+            const auto t0 = std::chrono::steady_clock::now();
+            if (guarded)
+            {
+                const DenormalGuard denormalGuard;
+                processor.process(buffer);
+            }
+            else
+            {
+                processor.process(buffer);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+
+            idleBlocks += (processor.isIdle() ? 1 : 0);
+            bins[(size_t) (start / samplesPerBin)].push_back(std::chrono::duration<double, std::nano> (t1 - t0).count()
+                                                             / kBlock);
+        }
+
+        std::vector<double> fade, binMedians;
+        for (int b = 0; b < kNumBins; ++b)
+        {
+            binMedians.push_back(median(bins[(size_t) b]));
+            if (b < kFadeSeconds)
+                fade.push_back(binMedians.back());
+        }
+        const double worstSilence = *std::max_element(binMedians.begin() + kFadeSeconds, binMedians.end());
+
+        std::printf("%-22s %-5s", name, guarded ? "on" : "off");
+        for (double ns : binMedians)
+            std::printf(" %6.0f", ns);
+        std::printf("  %6.2fx %5d\n", worstSilence / median(fade), idleBlocks);
+    }
+
+    template <typename Processor, typename T>
+    void runBoth (const char* name)
+    {
+        run<Processor, T> (name, true);
+        run<Processor, T> (name, false);
+    }
+}
+
+int main()
+{
+    std::printf("median ns/sample per 1 s bin (fade: 1-%d, silence: %d-%d)\n", kFadeSeconds, kFadeSeconds + 1, kNumBins);
+    std::printf("%-22s %-5s", "", "guard");
+    for (int b = 1; b <= kNumBins; ++b)
+        std::printf(" %6d", b);
+    std::printf("  worst/fade  idle\n");
+
+    runBoth<CompressorPipeline<float, QualityTier::eco>, float>("eco float");
+    runBoth<CompressorPipeline<double, QualityTier::eco>, double>("eco double");
+    runBoth<CompressorPipeline<float, QualityTier::standard>, float>("standard float");
+    runBoth<CompressorPipeline<double, QualityTier::standard>, double>("standard double");
+    runBoth<CompressorPipeline<float, QualityTier::mastering>, float>("mastering float");
+    runBoth<CompressorPipeline<double, QualityTier::mastering>, double>("mastering double");
+    runBoth<MultibandCompressor<float>, float>("multiband(4) float");
+    runBoth<MultibandCompressor<double>, double>("multiband(4) double");
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Idle fast path benchmark: a session of kInstances processors (48 kHz, stereo, 256-sample blocks), measured
+// with every instance fed noise (busy), every instance fed silence after it has gone idle (idle), and a typical
+// mostly silent session of kBusyInSession busy instances among kInstances (session). Prints ns per sample per
+// instance for each, the idle / busy ratio, and the session cost against the all-busy session, for every tier
+// and the 3-band multiband. Silent instances are measured once they have gone idle; "idle" counts the instances
+// that were still idle at the end of the silent run.
+//
+//   bench_idle [seconds per measurement]
+
+#include "CompressorPipeline.h"
+#include "MultibandCompressor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int kBlock = 256;
+    constexpr int kChannels = 2;
+    constexpr int kInstances = 16;
+    constexpr int kBusyInSession = 2;
+    constexpr double kSampleRate = 48000.0;
+    constexpr double kWarmUpSeconds = 1.0;
+    constexpr double kMaxSettleSeconds = 60.0;
+
+    template <typename Processor>
+    constexpr bool isMultiband = false;
+    template <typename T, QualityTier Tier>
+    constexpr bool isMultiband<MultibandCompressor<T, Tier>> = true;
+
+    template <typename Processor>
+    struct Session
+    {
+        std::vector<std::unique_ptr<Processor>> processors;
+        std::vector<juce::AudioBuffer<float>> buffers;
+        std::vector<float> noise; // one second, looped
+
+        Session()
+        {
+            for (int i = 0; i < kInstances; ++i)
+            {
+                auto processor = std::make_unique<Processor>();
+                processor->setLinkGroups(LinkGroupMap::allLinked(kChannels));
+                if constexpr (isMultiband<Processor>)
+                    processor->prepare(kSampleRate, kBlock, kChannels);
+                else
+                    processor->prepare(kSampleRate, kBlock);
+                processor->setControlTargets(-24.0, 4.0, 10.0, 100.0);
+                processor->reset();
+                processors.push_back(std::move(processor));
+                buffers.emplace_back(kChannels, kBlock);
+            }
+
+            std::mt19937 rng (1);
+            std::normal_distribution<float> dist (0.0f, 0.1f);
+            noise.resize((size_t) kSampleRate);
+            for (auto& x : noise)
+                x = dist(rng);
+        }
+
+        // Runs `seconds` of audio through every instance (the first numBusy get noise, the rest silence);
+        // returns ns per sample per instance
+        double run (int numBusy, double seconds)
+        {
+            const int numBlocks = (int) (seconds * kSampleRate) / kBlock;
+            double ns = 0.0;
+            for (int blk = 0; blk < numBlocks; ++blk)
+            {
+                const size_t offset = (size_t) (blk * kBlock) % (noise.size() - kBlock);
+                for (int i = 0; i < kInstances; ++i)
+                {
+                    auto& buffer = buffers[(size_t) i];
+                    for (int ch = 0; ch < kChannels; ++ch)
+                    {
+                        if (i < numBusy)
+                            std::copy_n(noise.begin() + (long) offset, kBlock, buffer.getWritePointer(ch));
+                        else
+                            std::fill_n(buffer.getWritePointer(ch), kBlock, 0.0f);
+                    }
+                }
+
+                const auto t0 = std::chrono::steady_clock::now();
+                for (int i = 0; i < kInstances; ++i)
+                    processors[(size_t) i]->process(buffers[(size_t) i]);
+                const auto t1 = std::chrono::steady_clock::now();
+                ns += std::chrono::duration<double, std::nano> (t1 - t0).count();
+            }
+            return ns / ((double) numBlocks * kBlock * kInstances);
+        }
+
+        // Runs silence into the non-busy instances until they have all gone idle (the envelopes decay to
+        // kIdleFloor first, which takes seconds at long release)
+        void settle (int numBusy)
+        {
+            for (double t = 0.0; t < kMaxSettleSeconds && countIdle() < kInstances - numBusy; t += 0.1)
+                run(numBusy, 0.1);
+        }
+
+        int countIdle() const
+        {
+            int n = 0;
+            for (const auto& processor : processors)
+                n += (processor->isIdle() ? 1 : 0);
+            return n;
+        }
+    };
+
+    template <typename Processor>
+    void bench (const char* name, double seconds)
+    {
+        Session<Processor> session;
+
+        session.run(kInstances, kWarmUpSeconds);
+        const double busy = session.run(kInstances, seconds);
+
+        session.settle(0);
+        const double idle = session.run(0, seconds);
+        const int numIdle = session.countIdle();
+
+        session.run(kInstances, kWarmUpSeconds);
+        session.settle(kBusyInSession);
+        const double mixed = session.run(kBusyInSession, seconds);
+
+        std::printf("%-24s %10.1f %10.1f %9.3f %12.1f %9.3f %5d\n", name, busy, idle, idle / busy, mixed,
+                    mixed / busy, numIdle);
+    }
+}
+
+int main (int argc, char** argv)
+{
+    const double seconds = (argc > 1 ? std::max(0.1, std::atof(argv[1])) : 4.0);
+
+    std::printf("%d instances, ns/sample per instance; session: %d busy + %d silent\n", kInstances,
+                kBusyInSession, kInstances - kBusyInSession);
+    std::printf("%-24s %10s %10s %9s %12s %9s %5s\n", "", "busy", "idle", "idle/busy", "session", "vs busy",
+                "idle");
+
+    bench<CompressorPipeline<float, QualityTier::eco>> ("eco", seconds);
+    bench<CompressorPipeline<float, QualityTier::standard>> ("standard", seconds);
+    bench<CompressorPipeline<float, QualityTier::mastering>> ("mastering", seconds);
+    bench<MultibandCompressor<float, QualityTier::standard>> ("multiband(3) standard", seconds);
+    bench<MultibandCompressor<float, QualityTier::mastering>> ("multiband(3) mastering", seconds);
+    return 0;
+}
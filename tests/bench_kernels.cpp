@@ -0,0 +1,193 @@
+// DspKernels benchmark: ns per call for every kernel, in both modes, at every ISA level this CPU supports,
+// then end-to-end us per block (512 samples, 48 kHz) for the single-band pipeline (Eco / Standard / Mastering,
+// stereo), the 4-band MultibandCompressor (stereo) and the Standard pipeline on 5.1 (default immersive link
+// groups). Best of 7 runs. Pairs with tests/test_kernel_equivalence (which checks what the fast mode costs in
+// accuracy).
+//
+//   bench_kernels [calls per measurement]
+
+#include "CompressorPipeline.h"
+#include "MultibandCompressor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+    using DspKernels::Isa;
+    using DspKernels::Mode;
+
+    constexpr int kTile = ChannelGroups::kTileSize;
+    constexpr int kStride = ChannelGroups::kMaxChannels;
+    constexpr int kBlock = 512;
+    constexpr double kSampleRate = 48000.0;
+
+    int numCalls = 20000;
+
+    template <typename Fn>
+    double nsPerCall (Fn&& fn)
+    {
+        double best = 1.0e30;
+        for (int rep = 0; rep < 7; ++rep)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int k = 0; k < numCalls; ++k)
+                fn();
+            const auto t1 = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano> (t1 - t0).count() / numCalls);
+        }
+        return best;
+    }
+
+    template <typename T>
+    void benchKernels()
+    {
+        std::mt19937 rng (3);
+        std::normal_distribution<double> normal (0.0, 1.0);
+
+        alignas(64) static T y[kTile * kStride], low[kTile * kStride];
+        for (int i = 0; i < kTile * kStride; ++i)
+        {
+            y[i] = (T) normal(rng);
+            low[i] = (T) normal(rng);
+        }
+        static double grDb[kTile];
+        static T gains[kTile], gainsS[kTile], l[kTile], r[kTile], x[kBlock];
+        for (int i = 0; i < kTile; ++i)
+        {
+            grDb[i] = 30.0 * std::abs(normal(rng));
+            gains[i] = gainsS[i] = (T) 0.5;
+            l[i] = (T) normal(rng);
+            r[i] = (T) normal(rng);
+        }
+        static ControlLanes in, out;
+        static double mod[kTile];
+        for (int i = 0; i < kTile; ++i)
+        {
+            mod[i] = 1.0;
+            for (int k = 0; k < ChannelGroups::kMaxLanes; ++k)
+                in[k][i] = std::abs(normal(rng));
+        }
+        DspKernels::EnvelopeCoeffs coeffs;
+        coeffs.gA = 0.3; coeffs.gF = 0.01; coeffs.gS = 0.001; coeffs.wFast = 0.6; coeffs.wSlow = 0.4;
+        coeffs.modScale = mod;
+
+        std::printf("%s, ns per call   stats 2ch  stats 12ch  env 2 lanes  gain fine  gain coarse  M/S 64  clip 512  dc 512\n",
+                    sizeof(T) == 4 ? "float " : "double");
+        for (Mode mode : { Mode::deterministic, Mode::fast })
+            for (Isa isa : { Isa::baseline, Isa::avx2, Isa::avx512 })
+            {
+                if (!DspKernels::isSupported(isa))
+                    continue;
+
+                const auto& t = DspKernels::getTable<T>(mode, isa);
+                T peak[kStride], sum[kStride], lowSum[kStride], x1 = 0, y1 = 0;
+                double fast[kStride] {}, slow[kStride] {}, env[kStride] {};
+                std::printf("%-5s %-8s %14.1f %11.1f %12.1f %10.1f %12.1f %7.1f %9.1f %7.1f\n",
+                            mode == Mode::fast ? "fast" : "det", DspKernels::getIsaName(isa),
+                            nsPerCall([&] { t.tileStats(y, low, kTile, 2, peak, sum, lowSum); }),
+                            nsPerCall([&] { t.tileStats(y, low, kTile, 12, peak, sum, lowSum); }),
+                            nsPerCall([&] { t.envelope(in, out, 2, kTile, coeffs, fast, slow, env); }),
+                            nsPerCall([&] { t.gainLaneFine(grDb, gains, kTile, 24.0); }),
+                            nsPerCall([&] { t.gainLaneCoarse(grDb, gains, kTile, 24.0); }),
+                            nsPerCall([&] { t.applyGainMidSide(l, r, gains, gainsS, kTile); }),
+                            nsPerCall([&]
+                            {
+                                for (int i = 0; i < kBlock; ++i)
+                                    x[i] = (T) (0.95 * ((i & 7) - 3.5) / 3.5);
+                                t.softClip(x, kBlock);
+                            }),
+                            nsPerCall([&]
+                            {
+                                for (int i = 0; i < kBlock; ++i)
+                                    x[i] = (T) (0.5 * ((i & 15) - 7.5) / 7.5);
+                                t.dcBlockLimit(x, kBlock, (T) 0.999, x1, y1);
+                            }));
+            }
+        std::printf("\n");
+    }
+
+    // us per block; stages cache the table at prepare(), so the level is selected first
+    template <typename Processor, typename T>
+    double usPerBlock (Mode mode, Isa isa, const juce::AudioChannelSet& layout = juce::AudioChannelSet::stereo())
+    {
+        DspKernels::select(mode, isa);
+
+        const int numCh = layout.size();
+        Processor processor;
+        processor.setLinkGroups(LinkGroupMap::fromChannelSet(layout));
+        processor.setControlTargets(-24.0, 4.0, 1.5, 100.0);
+        if constexpr (std::is_same_v<Processor, MultibandCompressor<T>>)
+        {
+            processor.setNumBands(MultibandCompressor<T>::kMaxBands);
+            processor.prepare(kSampleRate, kBlock, numCh);
+        }
+        else
+        {
+            processor.prepare(kSampleRate, kBlock);
+        }
+        processor.reset();
+
+        juce::AudioBuffer<T> buffer (numCh, kBlock);
+        std::mt19937 rng (1);
+        std::normal_distribution<double> noise (0.0, 0.5);
+        const int numBlocks = std::max(1, numCalls / 100);
+        double best = 1.0e30;
+        for (int rep = 0; rep < 7; ++rep)
+        {
+            double total = 0.0;
+            for (int blk = 0; blk < numBlocks; ++blk)
+            {
+                for (int ch = 0; ch < numCh; ++ch)
+                    for (int i = 0; i < kBlock; ++i)
+                        buffer.getWritePointer(ch)[i] = (T) (1.6 * noise(rng));
+                const auto t0 = std::chrono::steady_clock::now();
+                processor.process(buffer);
+                const auto t1 = std::chrono::steady_clock::now();
+                total += std::chrono::duration<double, std::micro> (t1 - t0).count();
+            }
+            best = std::min(best, total / numBlocks);
+        }
+        return best;
+    }
+
+    template <typename T>
+    void benchEndToEnd()
+    {
+        std::printf("%s, us per block        eco   pipeline  mastering  multiband 4  pipeline 5.1\n",
+                    sizeof(T) == 4 ? "float " : "double");
+        for (Mode mode : { Mode::deterministic, Mode::fast })
+            for (Isa isa : { Isa::baseline, Isa::avx2, Isa::avx512 })
+            {
+                if (!DspKernels::isSupported(isa))
+                    continue;
+
+                std::printf("%-5s %-8s %15.1f %10.1f %10.1f %12.1f %13.1f\n", mode == Mode::fast ? "fast" : "det",
+                            DspKernels::getIsaName(isa),
+                            usPerBlock<CompressorPipeline<T, QualityTier::eco>, T> (mode, isa),
+                            usPerBlock<CompressorPipeline<T>, T> (mode, isa),
+                            usPerBlock<CompressorPipeline<T, QualityTier::mastering>, T> (mode, isa),
+                            usPerBlock<MultibandCompressor<T>, T> (mode, isa),
+                            usPerBlock<CompressorPipeline<T>, T> (mode, isa, juce::AudioChannelSet::create5point1()));
+            }
+        std::printf("\n");
+    }
+}
+
+int main (int argc, char** argv)
+{
+    if (argc > 1)
+        numCalls = std::max(100, std::atoi(argv[1]));
+
+    std::printf("detected: %s, build default mode: %s\n\n", DspKernels::getIsaName(DspKernels::getDetectedIsa()),
+                DspKernels::kDefaultMode == Mode::fast ? "fast" : "deterministic");
+    benchKernels<float>();
+    benchKernels<double>();
+    benchEndToEnd<float>();
+    benchEndToEnd<double>();
+    return 0;
+}
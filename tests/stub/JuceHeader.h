@@ -0,0 +1,248 @@
+// Minimal JUCE stand-in for the Core tests and benchmarks (tests/ only; the plugin builds against real JUCE).
+// Covers exactly what Source/Core and Source/Util use: AudioBuffer, AudioChannelSet, dsp::AudioBlock,
+// dsp::Oversampling (zero-order hold, no latency), Thread (std::thread, realtime start always granted),
+// SystemStats CPU queries and the jmin / jmax / jlimit helpers. Behaviour matches JUCE where the Core code
+// depends on it (views that refer to external channel data, chunked sub-buffers); nothing else is modelled.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef jassert
+ #define jassert(expression) ((void) 0)
+#endif
+
+namespace juce
+{
+template <typename T> constexpr T jlimit (T lo, T hi, T v) { return v < lo ? lo : (hi < v ? hi : v); }
+template <typename T> constexpr T jmin (T a, T b)         { return b < a ? b : a; }
+template <typename T> constexpr T jmin (T a, T b, T c)    { return jmin (jmin (a, b), c); }
+template <typename T> constexpr T jmax (T a, T b)         { return a < b ? b : a; }
+template <typename T> constexpr T jmax (T a, T b, T c)    { return jmax (jmax (a, b), c); }
+
+template <typename T>
+struct MathConstants
+{
+    static constexpr T pi    = (T) 3.141592653589793238L;
+    static constexpr T twoPi = (T) 6.283185307179586477L;
+};
+
+//==============================================================================
+template <typename T>
+class AudioBuffer
+{
+public:
+    AudioBuffer() = default;
+    AudioBuffer (int numChannels, int numSamples) { setSize (numChannels, numSamples); }
+    AudioBuffer (T* const* data, int numChannels, int numSamples)                  { setDataToReferTo (data, numChannels, 0, numSamples); }
+    AudioBuffer (T* const* data, int numChannels, int startSample, int numSamples) { setDataToReferTo (data, numChannels, startSample, numSamples); }
+
+    void setSize (int numChannels, int numSamples, bool = false, bool = false, bool = false)
+    {
+        owned.assign ((size_t) numChannels, std::vector<T> ((size_t) numSamples));
+        channels.clear();
+        for (auto& line : owned)
+            channels.push_back (line.data());
+        size = numSamples;
+    }
+
+    void setDataToReferTo (T* const* data, int numChannels, int numSamples) { setDataToReferTo (data, numChannels, 0, numSamples); }
+    void setDataToReferTo (T* const* data, int numChannels, int startSample, int numSamples)
+    {
+        owned.clear();
+        channels.clear();
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels.push_back (data[ch] + startSample);
+        size = numSamples;
+    }
+
+    void makeCopyOf (const AudioBuffer& other, bool = false)
+    {
+        setSize (other.getNumChannels(), other.getNumSamples());
+        for (int ch = 0; ch < other.getNumChannels(); ++ch)
+            std::copy (other.channels[(size_t) ch], other.channels[(size_t) ch] + size, channels[(size_t) ch]);
+    }
+
+    int getNumChannels() const noexcept { return (int) channels.size(); }
+    int getNumSamples() const noexcept  { return size; }
+
+    const T* getReadPointer (int ch) const noexcept             { return channels[(size_t) ch]; }
+    const T* getReadPointer (int ch, int offset) const noexcept { return channels[(size_t) ch] + offset; }
+    T* getWritePointer (int ch) noexcept                        { return channels[(size_t) ch]; }
+    T* getWritePointer (int ch, int offset) noexcept            { return channels[(size_t) ch] + offset; }
+    T* const* getArrayOfWritePointers() noexcept                { return channels.data(); }
+    const T* const* getArrayOfReadPointers() const noexcept     { return channels.data(); }
+
+    void clear() noexcept
+    {
+        for (auto* line : channels)
+            std::fill (line, line + size, T());
+    }
+
+    void copyFrom (int destCh, int destStart, const AudioBuffer& source, int sourceCh, int sourceStart, int num)
+    {
+        std::copy (source.channels[(size_t) sourceCh] + sourceStart, source.channels[(size_t) sourceCh] + sourceStart + num,
+                   channels[(size_t) destCh] + destStart);
+    }
+
+private:
+    std::vector<std::vector<T>> owned;
+    std::vector<T*> channels;
+    int size = 0;
+};
+
+//==============================================================================
+struct AudioChannelSet
+{
+    enum ChannelType
+    {
+        unknown, left, right, centre, LFE, leftSurround, rightSurround, leftCentre, rightCentre, centreSurround,
+        surround = centreSurround, leftSurroundSide, rightSurroundSide, topMiddle, topFrontLeft, topFrontCentre,
+        topFrontRight, topRearLeft, topRearCentre, topRearRight, LFE2, leftSurroundRear, rightSurroundRear
+    };
+
+    std::vector<ChannelType> types;
+
+    int size() const                          { return (int) types.size(); }
+    ChannelType getTypeOfChannel (int i) const { return types[(size_t) i]; }
+    bool isDisabled() const                   { return types.empty(); }
+    bool operator== (const AudioChannelSet& other) const { return types == other.types; }
+    bool operator!= (const AudioChannelSet& other) const { return types != other.types; }
+
+    static AudioChannelSet mono()          { return { { centre } }; }
+    static AudioChannelSet stereo()        { return { { left, right } }; }
+    static AudioChannelSet create5point1() { return { { left, right, centre, LFE, leftSurround, rightSurround } }; }
+    static AudioChannelSet create7point1()
+    {
+        return { { left, right, centre, LFE, leftSurroundSide, rightSurroundSide, leftSurroundRear, rightSurroundRear } };
+    }
+    static AudioChannelSet create7point1point4()
+    {
+        return { { left, right, centre, LFE, leftSurroundSide, rightSurroundSide, leftSurroundRear, rightSurroundRear,
+                   topFrontLeft, topFrontRight, topRearLeft, topRearRight } };
+    }
+};
+
+//==============================================================================
+namespace dsp
+{
+template <typename T>
+struct AudioBlock
+{
+    AudioBlock() = default;
+    AudioBlock (AudioBuffer<T>& buffer)
+        : numSamples ((size_t) buffer.getNumSamples())
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            channels.push_back (buffer.getWritePointer (ch));
+    }
+    AudioBlock (T* const* data, size_t numChannels, size_t num)
+        : channels (data, data + numChannels), numSamples (num) {}
+
+    size_t getNumChannels() const         { return channels.size(); }
+    size_t getNumSamples() const          { return numSamples; }
+    T* getChannelPointer (size_t ch) const { return channels[ch]; }
+
+    AudioBlock getSubBlock (size_t start, size_t length) const
+    {
+        AudioBlock sub;
+        for (auto* line : channels)
+            sub.channels.push_back (line + start);
+        sub.numSamples = length;
+        return sub;
+    }
+
+    std::vector<T*> channels;
+    size_t numSamples = 0;
+};
+
+// Zero-order hold up / decimation down: shape-compatible with JUCE's, not its filters
+template <typename T>
+struct Oversampling
+{
+    enum FilterType { filterHalfBandPolyphaseIIR, filterHalfBandFIREquiripple };
+
+    Oversampling (size_t numChannels, size_t factorLog2, FilterType, bool = true, bool = false)
+        : numCh (numChannels), factor ((size_t) 1 << factorLog2) {}
+
+    void initProcessing (size_t maxBlock) { lines.assign (numCh, std::vector<T> (maxBlock * factor)); }
+    void reset() {}
+    float getLatencyInSamples() const { return 0.0f; }
+
+    AudioBlock<T> processSamplesUp (const AudioBlock<T>& block)
+    {
+        AudioBlock<T> up;
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+        {
+            for (size_t i = 0; i < block.numSamples * factor; ++i)
+                lines[ch][i] = block.channels[ch][i / factor];
+            up.channels.push_back (lines[ch].data());
+        }
+        up.numSamples = block.numSamples * factor;
+        return up;
+    }
+
+    void processSamplesDown (AudioBlock<T>& block)
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            for (size_t i = 0; i < block.numSamples; ++i)
+                block.channels[ch][i] = lines[ch][i * factor];
+    }
+
+    size_t numCh, factor;
+    std::vector<std::vector<T>> lines;
+};
+} // namespace dsp
+
+//==============================================================================
+struct SystemStats
+{
+    static bool hasSSE2()    { return true; }
+    static bool hasAVX2()    { return true; }
+    static bool hasFMA3()    { return true; }
+    static bool hasAVX512F() { return false; }
+    static bool hasNeon()    { return false; }
+};
+
+// std::thread underneath; startRealtimeThread() always succeeds (no priority change)
+class Thread
+{
+public:
+    struct RealtimeOptions
+    {
+        RealtimeOptions withApproximateAudioProcessingTime (int, double) const { return *this; }
+        RealtimeOptions withPriority (int) const                           { return *this; }
+    };
+
+    explicit Thread (const std::string&) {}
+    virtual ~Thread() { stopThread (-1); }
+
+    virtual void run() = 0;
+
+    bool startThread()                         { thread = std::thread ([this] { run(); }); return true; }
+    bool startRealtimeThread (const RealtimeOptions&) { return startThread(); }
+    void signalThreadShouldExit()              { exitFlag.store (true); }
+    bool threadShouldExit() const              { return exitFlag.load(); }
+
+    bool stopThread (int)
+    {
+        signalThreadShouldExit();
+        if (thread.joinable())
+            thread.join();
+        return true;
+    }
+
+private:
+    std::thread thread;
+    std::atomic<bool> exitFlag { false };
+};
+} // namespace juce
@@ -0,0 +1,95 @@
+// The envelopes are driven by DetectorCore's per-tile lanes, so gain reduction must not depend on the host
+// block size: program-like material (decaying noise hits over a noise floor) rendered with 64-, 512- and
+// 2048-sample blocks must apply the same gain, per sample, to within kToleranceDb at the 99th percentile.
+// Covers the per-sample (Standard), tile-rate (Eco) and multirate (Standard at 192 kHz) control paths.
+// Host blocks longer than the prepared size run in prepared-size chunks: a pipeline prepared for 64 samples and
+// fed 512- or 2048-sample blocks must render exactly what it renders from 64-sample blocks.
+
+#include "CompressorPipeline.h"
+#include "TestUtil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr double kToleranceDb = 0.1;
+
+    // Applied gain in dB per sample (channel 0), first second of the material
+    template <QualityTier Tier>
+    std::vector<double> renderGainDb (int block, double sampleRate, int preparedBlock)
+    {
+        CompressorPipeline<float, Tier> pipeline;
+        pipeline.setLinkGroups(LinkGroupMap::allLinked(2));
+        pipeline.setControlTargets(-30.0, 6.0, 2.0, 80.0);
+        pipeline.prepare(sampleRate, preparedBlock);
+        pipeline.reset();
+
+        const int total = (int) sampleRate;
+        std::vector<float> input ((size_t) total);
+        std::mt19937 rng (3);
+        std::normal_distribution<float> noise (0.0f, 1.0f);
+        for (int i = 0; i < total; ++i)
+        {
+            const double t = (double) i / sampleRate;
+            input[(size_t) i] = (float) ((0.05 + 0.6 * std::exp(-30.0 * std::fmod(t, 0.125))) * noise(rng));
+        }
+
+        juce::AudioBuffer<float> buffer (2, block);
+        std::vector<double> gainDb;
+        for (int start = 0; start + block <= total; start += block)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy(input.begin() + start, input.begin() + start + block, buffer.getWritePointer(ch));
+            pipeline.process(buffer);
+
+            for (int i = 0; i < block; ++i)
+            {
+                const float x = input[(size_t) (start + i)];
+                const double g = (std::abs(x) > 1.0e-3f ? buffer.getReadPointer(0)[i] / x : 1.0);
+                gainDb.push_back(20.0 * std::log10(std::abs(g) + 1.0e-9));
+            }
+        }
+        return gainDb;
+    }
+
+    double percentile99Difference (const std::vector<double>& a, const std::vector<double>& b)
+    {
+        std::vector<double> diff;
+        const size_t n = std::min(a.size(), b.size());
+        for (size_t i = 4096; i < n; ++i) // past the first blocks' settling
+            diff.push_back(std::abs(a[i] - b[i]));
+        std::sort(diff.begin(), diff.end());
+        return diff.empty() ? 0.0 : diff[diff.size() * 99 / 100];
+    }
+
+    template <QualityTier Tier>
+    void check (const char* name, double sampleRate)
+    {
+        const auto reference = renderGainDb<Tier> (64, sampleRate, 64);
+        for (int block : { 512, 2048 })
+        {
+            const double p99 = percentile99Difference(reference, renderGainDb<Tier> (block, sampleRate, block));
+            const std::string what = std::string (name) + ": 64 vs " + std::to_string(block) + " samples, p99 "
+                                   + std::to_string(p99) + " dB";
+            std::printf("%s\n", what.c_str());
+            TestUtil::expect(p99 < kToleranceDb, what.c_str());
+
+            const auto chunks = renderGainDb<Tier> (block, sampleRate, 64); // whole blocks only: a prefix of the reference
+            const bool chunked = std::equal(chunks.begin(), chunks.end(), reference.begin());
+            TestUtil::expect(chunked, (std::string (name) + ": " + std::to_string(block)
+                                       + "-sample blocks on a 64-sample prepare run as 64-sample chunks").c_str());
+        }
+    }
+}
+
+int main()
+{
+    check<QualityTier::standard> ("standard 48 kHz", 48000.0);
+    check<QualityTier::eco> ("eco 48 kHz", 48000.0);
+    check<QualityTier::standard> ("standard 192 kHz (multirate)", 192000.0);
+    return TestUtil::finish("test_block_size_independence");
+}
@@ -0,0 +1,144 @@
+// Idle fast path: once a pipeline (or the multiband wrapper) goes idle on input at or below kIdleFloor, its
+// output must be the input, untouched, delayed by exactly the reported latency; it must not gate the signal
+// to silence. Loud noise, then a -121 dBFS sine; Standard and Mastering tiers, single-band and multiband.
+// When loud input returns, processing must resume as if it had never stopped: the burst after the silence must
+// match, to within kResumeTolerance, an instance kept out of idle (the same sine just above kIdleFloor) that
+// processed the whole silence, and single-band pipelines must be within kSettledTolerance of it once the burst's
+// attack has settled (a control clock that stopped while idle, such as the release micro-modulation, shows there).
+// Multiband bands also track the low-end dominance of their (slightly different) quiet input, which the burst
+// does not wash out within kResumeBlocks, so they are held to kResumeTolerance only.
+
+#include "CompressorPipeline.h"
+#include "MultibandCompressor.h"
+#include "TestUtil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int kBlock = 512;
+    constexpr int kLoudBlocks = 20;
+    constexpr int kQuietBlocks = 1200;
+    constexpr int kResumeBlocks = 40;
+    constexpr int kSettleBlocks = 20;
+    constexpr double kSampleRate = 48000.0;
+    constexpr double kQuietAmplitude = 9.0e-7; // just below CompressorPipeline::kIdleFloor
+    constexpr double kKeepAliveAmplitude = 1.1e-6; // just above kIdleFloor
+    constexpr double kResumeTolerance = 2.0e-5;
+    constexpr double kSettledTolerance = 1.0e-6;
+
+    template <typename Processor>
+    constexpr bool isMultiband = false;
+    template <typename T, QualityTier Tier>
+    constexpr bool isMultiband<MultibandCompressor<T, Tier>> = true;
+
+    template <typename Processor>
+    std::unique_ptr<Processor> make()
+    {
+        auto processor = std::make_unique<Processor>();
+        processor->setLinkGroups(LinkGroupMap::allLinked(2));
+        if constexpr (isMultiband<Processor>)
+            processor->prepare(kSampleRate, kBlock, 2);
+        else
+            processor->prepare(kSampleRate, kBlock);
+        processor->setControlTargets(-30.0, 4.0, 5.0, 50.0);
+        processor->reset();
+        return processor;
+    }
+
+    // Channel 0 of the output, block by block (channel 1 carries -x); idleFrom = first sample of the first
+    // idle block (left alone if the processor never goes idle)
+    template <typename Processor>
+    std::vector<float> render (Processor& processor, const std::vector<float>& input, int& idleFrom)
+    {
+        std::vector<float> output;
+        juce::AudioBuffer<float> buffer (2, kBlock);
+        for (size_t start = 0; start + kBlock <= input.size(); start += kBlock)
+        {
+            for (int i = 0; i < kBlock; ++i)
+            {
+                buffer.getWritePointer(0)[i] = input[start + (size_t) i];
+                buffer.getWritePointer(1)[i] = -input[start + (size_t) i];
+            }
+            processor.process(buffer);
+            output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + kBlock);
+            if (idleFrom < 0 && processor.isIdle())
+                idleFrom = (int) start;
+        }
+        return output;
+    }
+
+    template <typename Processor>
+    void check (const char* name)
+    {
+        auto processor = make<Processor>();
+        const int latency = processor->getLatencySamples();
+
+        // Loud noise, a quiet sine, then a loud noise burst; keepAlive: the same with the sine above the idle floor
+        std::mt19937 rng (2);
+        std::normal_distribution<float> noise (0.0f, 0.1f);
+        std::vector<float> input, keepAlive;
+        for (int n = 0; n < (kLoudBlocks + kQuietBlocks + kResumeBlocks) * kBlock; ++n)
+        {
+            const int blk = n / kBlock;
+            const bool quiet = (blk >= kLoudBlocks && blk < kLoudBlocks + kQuietBlocks);
+            const double sine = std::sin(0.05 * (double) n);
+            input.push_back(quiet ? (float) (kQuietAmplitude * sine) : noise(rng));
+            keepAlive.push_back(quiet ? (float) (kKeepAliveAmplitude * sine) : input.back());
+        }
+
+        int idleFrom = -1;
+        const auto output = render(*processor, input, idleFrom);
+
+        const std::string prefix = std::string (name) + ": ";
+        std::printf("%s latency %d, idle from sample %d\n", name, latency, idleFrom);
+        TestUtil::expect(idleFrom >= 0, (prefix + "goes idle on quiet input").c_str());
+        if (idleFrom < 0)
+            return;
+
+        // Delay lines swapped in at idle entry start from the same (quiet) history or from zero: check past them
+        const size_t resumeFrom = (size_t) ((kLoudBlocks + kQuietBlocks) * kBlock);
+        bool delayedInput = true, silent = true;
+        for (size_t i = (size_t) (idleFrom + latency); i < resumeFrom; ++i)
+        {
+            delayedInput = delayedInput && output[i] == input[i - (size_t) latency];
+            silent = silent && output[i] == 0.0f;
+        }
+        TestUtil::expect(!silent, (prefix + "idle output is not gated to silence").c_str());
+        TestUtil::expect(delayedInput, (prefix + "idle output is the input delayed by the latency").c_str());
+        TestUtil::expect(!processor->isIdle(), (prefix + "loud input leaves idle").c_str());
+
+        // Resume: against an instance that processed the whole silence
+        auto reference = make<Processor>();
+        int referenceIdleFrom = -1;
+        const auto expected = render(*reference, keepAlive, referenceIdleFrom);
+        TestUtil::expect(referenceIdleFrom < 0, (prefix + "the kept-alive reference never goes idle").c_str());
+
+        const size_t settledFrom = resumeFrom + (size_t) (kSettleBlocks * kBlock);
+        double e = 0.0, settled = 0.0;
+        for (size_t i = resumeFrom; i < output.size(); ++i)
+        {
+            const double d = std::abs((double) output[i] - (double) expected[i]);
+            e = std::max(e, d);
+            settled = (i >= settledFrom ? std::max(settled, d) : settled);
+        }
+        std::printf("%s resumed vs never idle: max abs %.2g, settled %.2g\n", name, e, settled);
+        TestUtil::expect(e <= kResumeTolerance, (prefix + "processing resumes from the settled state").c_str());
+        if constexpr (!isMultiband<Processor>)
+            TestUtil::expect(settled <= kSettledTolerance, (prefix + "control clocks kept time while idle").c_str());
+    }
+}
+
+int main()
+{
+    check<CompressorPipeline<float, QualityTier::standard>>("pipeline standard");
+    check<CompressorPipeline<float, QualityTier::mastering>>("pipeline mastering");
+    check<MultibandCompressor<float, QualityTier::standard>>("multiband standard");
+    check<MultibandCompressor<float, QualityTier::mastering>>("multiband mastering");
+    return TestUtil::finish("test_idle_passthrough");
+}
@@ -0,0 +1,228 @@
+// DspKernels dispatch: every ISA level this CPU supports is forced with DspKernels::forceIsa(), in both
+// modes, and each kernel of the active table is compared with the deterministic baseline table on the same
+// random inputs. Mode::deterministic must match bit for bit at every level; Mode::fast must stay within the
+// per-kernel tolerances documented in DspKernels.h. A level the CPU lacks must be refused, table unchanged.
+
+#include "DspKernels.h"
+#include "TestUtil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace
+{
+    using DspKernels::Isa;
+    using DspKernels::Mode;
+
+    constexpr int kTile = ChannelGroups::kTileSize;
+    constexpr int kStride = ChannelGroups::kMaxChannels;
+    constexpr int kClipLength = 512;
+    constexpr int kRounds = 200;
+
+    // Fast-mode tolerances against deterministic mode (DspKernels.h table); deterministic mode is exact
+    template <typename T>
+    struct Tolerance
+    {
+        double sumsUlp, gainUlp, midSideUlp, softClipAbs, dcBlockAbs;
+    };
+
+    template <typename T>
+    Tolerance<T> toleranceFor (Mode mode)
+    {
+        if (mode == Mode::deterministic)
+            return { 0.0, 0.0, 0.0, 0.0, 0.0 };
+        if constexpr (std::is_same_v<T, float>)
+            return { 5.0, 2.0, 2.0, 1.2e-7, 2.7e-6 };
+        else
+            return { 5.0, 2.0, 2.0, 1.3e-9, 3.3e-9 };
+    }
+
+    template <typename T>
+    double ulps (T value, T reference, double scale)
+    {
+        const double d = std::abs((double) value - (double) reference);
+        return d == 0.0 ? 0.0 : d / (std::max(scale, (double) std::numeric_limits<T>::min())
+                                     * (double) std::numeric_limits<T>::epsilon());
+    }
+
+    template <typename T>
+    bool sameBits (const T* a, const T* b, int n) { return std::memcmp(a, b, sizeof(T) * (size_t) n) == 0; }
+
+    // Worst difference per kernel over kRounds random inputs
+    struct Errors
+    {
+        double sums = 0.0, gain = 0.0, midSide = 0.0, softClip = 0.0, dcBlock = 0.0;
+        bool peaksDiffer = false, envelopeDiffers = false, applyGainDiffers = false, nonFiniteDiffers = false;
+        bool bitsDiffer = false;
+    };
+
+    template <typename T>
+    Errors compare (const DspKernels::Table<T>& ref, const DspKernels::Table<T>& dut)
+    {
+        Errors e;
+        std::mt19937 rng (5);
+        std::normal_distribution<double> normal (0.0, 1.0);
+
+        for (int round = 0; round < kRounds; ++round)
+        {
+            // tileStats: 1..12 channels, full and partial tiles
+            const int numCh = 1 + round % 12;
+            const int n = (round % 3 == 0 ? kTile - 1 : kTile);
+            alignas(64) T y[kTile * kStride] {}, low[kTile * kStride] {};
+            for (int i = 0; i < n; ++i)
+                for (int ch = 0; ch < numCh; ++ch)
+                {
+                    y[i * kStride + ch] = (T) normal(rng);
+                    low[i * kStride + ch] = (T) normal(rng);
+                }
+            T p1[kStride] {}, s1[kStride] {}, l1[kStride] {}, p2[kStride] {}, s2[kStride] {}, l2[kStride] {};
+            ref.tileStats(y, low, n, numCh, p1, s1, l1);
+            dut.tileStats(y, low, n, numCh, p2, s2, l2);
+            e.peaksDiffer = e.peaksDiffer || !sameBits(p1, p2, numCh);
+            e.bitsDiffer = e.bitsDiffer || !sameBits(s1, s2, numCh) || !sameBits(l1, l2, numCh);
+            for (int ch = 0; ch < numCh; ++ch)
+                e.sums = std::max({ e.sums, ulps(s2[ch], s1[ch], (double) s1[ch]), ulps(l2[ch], l1[ch], (double) l1[ch]) });
+
+            // envelope: 1..12 lanes
+            ControlLanes in, out1, out2;
+            double mod[kTile];
+            for (int i = 0; i < kTile; ++i)
+                mod[i] = 1.0 + 0.01 * normal(rng);
+            for (int k = 0; k < numCh; ++k)
+                for (int i = 0; i < kTile; ++i)
+                    in[k][i] = std::abs(normal(rng));
+            DspKernels::EnvelopeCoeffs coeffs;
+            coeffs.gA = 0.3; coeffs.gF = 0.01; coeffs.gS = 0.001; coeffs.wFast = 0.6; coeffs.wSlow = 0.4;
+            coeffs.modScale = mod;
+            double f1[kStride] {}, z1[kStride] {}, e1[kStride] {}, f2[kStride] {}, z2[kStride] {}, e2[kStride] {};
+            ref.envelope(in, out1, numCh, kTile, coeffs, f1, z1, e1);
+            dut.envelope(in, out2, numCh, kTile, coeffs, f2, z2, e2);
+            for (int k = 0; k < numCh; ++k)
+                e.envelopeDiffers = e.envelopeDiffers || !sameBits(out1[k], out2[k], kTile);
+
+            // gainLane (both accuracy tiers) and applyGain
+            double grDb[kTile];
+            for (int i = 0; i < kTile; ++i)
+                grDb[i] = 30.0 * std::abs(normal(rng));
+            T g1[kTile], g2[kTile], c1[kTile], c2[kTile];
+            ref.gainLaneFine(grDb, g1, kTile, 24.0);
+            dut.gainLaneFine(grDb, g2, kTile, 24.0);
+            ref.gainLaneCoarse(grDb, c1, kTile, 24.0);
+            dut.gainLaneCoarse(grDb, c2, kTile, 24.0);
+            e.bitsDiffer = e.bitsDiffer || !sameBits(g1, g2, kTile) || !sameBits(c1, c2, kTile);
+            for (int i = 0; i < kTile; ++i)
+                e.gain = std::max({ e.gain, ulps(g2[i], g1[i], (double) g1[i]), ulps(c2[i], c1[i], (double) c1[i]) });
+
+            T a1[kTile], a2[kTile];
+            for (int i = 0; i < kTile; ++i)
+                a1[i] = a2[i] = (T) normal(rng);
+            ref.applyGain(a1, g1, kTile);
+            dut.applyGain(a2, g1, kTile);
+            e.applyGainDiffers = e.applyGainDiffers || !sameBits(a1, a2, kTile);
+
+            // applyGainMidSide (same gains into both tables; error relative to the input scale)
+            T lA[kTile], rA[kTile], lB[kTile], rB[kTile];
+            for (int i = 0; i < kTile; ++i)
+            {
+                lA[i] = lB[i] = (T) normal(rng);
+                rA[i] = rB[i] = (T) normal(rng);
+            }
+            T inScale[kTile];
+            for (int i = 0; i < kTile; ++i)
+                inScale[i] = std::max(std::abs(lA[i]), std::abs(rA[i]));
+            ref.applyGainMidSide(lA, rA, g1, c1, kTile);
+            dut.applyGainMidSide(lB, rB, g1, c1, kTile);
+            e.bitsDiffer = e.bitsDiffer || !sameBits(lA, lB, kTile) || !sameBits(rA, rB, kTile);
+            for (int i = 0; i < kTile; ++i)
+                e.midSide = std::max({ e.midSide, ulps(lB[i], lA[i], (double) inScale[i]), ulps(rB[i], rA[i], (double) inScale[i]) });
+
+            // softClip: signal well into the curve, plus non-finite samples the clip must pass through
+            T x1[kClipLength], x2[kClipLength];
+            for (int i = 0; i < kClipLength; ++i)
+                x1[i] = x2[i] = (T) (1.5 * normal(rng));
+            if (round == 0)
+            {
+                x1[3] = x2[3] = std::numeric_limits<T>::infinity();
+                x1[7] = x2[7] = std::numeric_limits<T>::quiet_NaN();
+            }
+            ref.softClip(x1, kClipLength);
+            dut.softClip(x2, kClipLength);
+            for (int i = 0; i < kClipLength; ++i)
+            {
+                if (!std::isfinite(x1[i]))
+                    e.nonFiniteDiffers = e.nonFiniteDiffers || !sameBits(&x1[i], &x2[i], 1);
+                else
+                    e.softClip = std::max(e.softClip, std::abs((double) x1[i] - (double) x2[i]));
+            }
+            e.bitsDiffer = e.bitsDiffer || !sameBits(x1, x2, kClipLength);
+
+            // dcBlockLimit: one channel, state carried in and out
+            for (int i = 0; i < kClipLength; ++i)
+                x1[i] = x2[i] = (T) (0.2 * (1 + round % 5) * normal(rng));
+            T xs1 = 0, ys1 = 0, xs2 = 0, ys2 = 0;
+            ref.dcBlockLimit(x1, kClipLength, (T) 0.999, xs1, ys1);
+            dut.dcBlockLimit(x2, kClipLength, (T) 0.999, xs2, ys2);
+            e.bitsDiffer = e.bitsDiffer || !sameBits(x1, x2, kClipLength) || xs1 != xs2 || ys1 != ys2;
+            e.dcBlock = std::max({ e.dcBlock, std::abs((double) xs1 - (double) xs2), std::abs((double) ys1 - (double) ys2) });
+            for (int i = 0; i < kClipLength; ++i)
+                e.dcBlock = std::max(e.dcBlock, std::abs((double) x1[i] - (double) x2[i]));
+        }
+        return e;
+    }
+
+    template <typename T>
+    void checkLevel (Mode mode, Isa isa)
+    {
+        const std::string level = std::string (mode == Mode::fast ? "fast " : "deterministic ")
+                                + DspKernels::getIsaName(isa) + (std::is_same_v<T, float> ? " float" : " double");
+
+        const auto& active = DspKernels::getActive<T>();
+        TestUtil::expect(active.mode == mode && active.isa == isa, (level + ": forced table is active").c_str());
+
+        const Errors e = compare(DspKernels::getTable<T>(Mode::deterministic, Isa::baseline), active);
+        const Tolerance<T> tol = toleranceFor<T>(mode);
+        std::printf("%-28s sums %.2f ulp  gain %.2f ulp  M/S %.2f ulp  softClip %.2g  dcBlock %.2g\n", level.c_str(),
+                    e.sums, e.gain, e.midSide, e.softClip, e.dcBlock);
+
+        const auto expect = [&level] (bool ok, const char* what) { TestUtil::expect(ok, (level + ": " + what).c_str()); };
+        expect(!e.peaksDiffer, "tileStats peaks exact");
+        expect(!e.envelopeDiffers, "envelope identical");
+        expect(!e.applyGainDiffers, "applyGain exact");
+        expect(!e.nonFiniteDiffers, "softClip passes non-finite samples through unchanged");
+        if (mode == Mode::deterministic)
+            expect(!e.bitsDiffer, "bit-identical to the baseline level");
+        expect(e.sums <= tol.sumsUlp, "tileStats sums within tolerance");
+        expect(e.gain <= tol.gainUlp, "gainLane within tolerance");
+        expect(e.midSide <= tol.midSideUlp, "applyGainMidSide within tolerance");
+        expect(e.softClip <= tol.softClipAbs, "softClip within tolerance");
+        expect(e.dcBlock <= tol.dcBlockAbs, "dcBlockLimit within tolerance");
+    }
+}
+
+int main()
+{
+    for (Mode mode : { Mode::deterministic, Mode::fast })
+    {
+        DspKernels::select(mode, Isa::baseline);
+        for (Isa isa : { Isa::baseline, Isa::avx2, Isa::avx512 })
+        {
+            if (!DspKernels::isSupported(isa))
+            {
+                const auto* before = &DspKernels::getActive<float>();
+                TestUtil::expect(!DspKernels::forceIsa(isa), "an unsupported level is refused");
+                TestUtil::expect(&DspKernels::getActive<float>() == before, "a refused level leaves the table alone");
+                std::printf("%s: not supported here, skipped\n", DspKernels::getIsaName(isa));
+                continue;
+            }
+
+            TestUtil::expect(DspKernels::forceIsa(isa), "a supported level is accepted");
+            checkLevel<float>(mode, isa);
+            checkLevel<double>(mode, isa);
+        }
+    }
+    return TestUtil::finish("test_isa_dispatch");
+}
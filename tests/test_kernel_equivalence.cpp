@@ -0,0 +1,125 @@
+// End-to-end kernel mode equivalence (the guarantees listed in DspKernels.h):
+// - Mode::deterministic renders are bit-identical at every ISA level this CPU supports and, for
+//   MultibandCompressor, at every band worker count (0 = serial .. BandWorkerPool::kMaxWorkers; workers are
+//   started even without spare cores).
+// - Mode::fast renders stay within the documented end-to-end tolerances of the deterministic render.
+// Material: 400 blocks of 512, stereo noise alternating between 1.6 and 0.02 RMS every 100 blocks.
+
+#include "CompressorPipeline.h"
+#include "MultibandCompressor.h"
+#include "TestUtil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using DspKernels::Isa;
+    using DspKernels::Mode;
+
+    constexpr int kBlock = 512;
+    constexpr int kNumBlocks = 400;
+    constexpr int kChannels = 2;
+    constexpr double kSampleRate = 48000.0;
+
+    template <typename Processor>
+    constexpr bool isMultiband = false;
+    template <typename T, QualityTier Tier>
+    constexpr bool isMultiband<MultibandCompressor<T, Tier>> = true;
+
+    // Stages cache the active table at prepare(), so the level is selected before the processor is built
+    template <typename Processor, typename T>
+    std::vector<T> render (Mode mode, Isa isa, int workers)
+    {
+        DspKernels::select(mode, isa);
+
+        Processor processor;
+        processor.setControlTargets(-24.0, 4.0, 1.5, 100.0);
+        if constexpr (isMultiband<Processor>)
+        {
+            processor.setNumBands(MultibandCompressor<T>::kMaxBands);
+            processor.setWorkerCount(workers);
+            processor.prepare(kSampleRate, kBlock, kChannels);
+            if (workers >= 0)
+                TestUtil::expect(processor.getNumWorkers() == workers, "the requested band workers are running");
+        }
+        else
+        {
+            processor.prepare(kSampleRate, kBlock);
+        }
+        processor.reset();
+
+        juce::AudioBuffer<T> buffer (kChannels, kBlock);
+        std::mt19937 rng (1);
+        std::normal_distribution<double> noise (0.0, 0.5);
+        std::vector<T> out;
+        out.reserve((size_t) (kNumBlocks * kBlock * kChannels));
+        for (int blk = 0; blk < kNumBlocks; ++blk)
+        {
+            const double amp = ((blk / 100) % 2 != 0 ? 0.02 : 1.6);
+            for (int ch = 0; ch < kChannels; ++ch)
+                for (int i = 0; i < kBlock; ++i)
+                    buffer.getWritePointer(ch)[i] = (T) (amp * noise(rng));
+
+            processor.process(buffer);
+            for (int ch = 0; ch < kChannels; ++ch)
+                out.insert(out.end(), buffer.getReadPointer(ch), buffer.getReadPointer(ch) + kBlock);
+        }
+        return out;
+    }
+
+    template <typename T>
+    double maxAbsDifference (const std::vector<T>& a, const std::vector<T>& b)
+    {
+        double e = 0.0;
+        for (size_t i = 0; i < a.size(); ++i)
+            e = std::max(e, std::abs((double) a[i] - (double) b[i]));
+        return e;
+    }
+
+    template <typename Processor, typename T>
+    void check (const char* name, double fastTolerance)
+    {
+        const auto reference = render<Processor, T> (Mode::deterministic, Isa::baseline, 0);
+        const std::vector<int> workerCounts = (isMultiband<Processor> ? std::vector<int> { 0, 1, 2, 3 }
+                                                                      : std::vector<int> { 0 });
+
+        for (Isa isa : { Isa::baseline, Isa::avx2, Isa::avx512 })
+        {
+            if (!DspKernels::isSupported(isa))
+                continue;
+
+            const std::string level = std::string (name) + " " + DspKernels::getIsaName(isa);
+            for (int workers : workerCounts)
+            {
+                const auto rendered = render<Processor, T> (Mode::deterministic, isa, workers);
+                const bool identical = rendered.size() == reference.size()
+                                    && std::memcmp(rendered.data(), reference.data(), sizeof(T) * reference.size()) == 0;
+                const std::string what = level + ", " + std::to_string(workers) + " workers: deterministic render is bit-identical";
+                TestUtil::expect(identical, what.c_str());
+            }
+
+            const double e = maxAbsDifference(render<Processor, T> (Mode::fast, isa, -1), reference);
+            std::printf("%-30s fast vs deterministic: max abs %.2g (%.1f dBFS, tolerance %.2g)\n", level.c_str(), e,
+                        20.0 * std::log10(e + 1.0e-30), fastTolerance);
+            TestUtil::expect(e <= fastTolerance, (level + ": fast render within tolerance").c_str());
+        }
+    }
+}
+
+int main()
+{
+    // Tolerances: DspKernels.h, end to end
+    check<CompressorPipeline<float>, float>("pipeline float", 5.0e-6);
+    check<CompressorPipeline<double>, double>("pipeline double", 3.5e-9);
+    check<CompressorPipeline<float, QualityTier::mastering>, float>("pipeline float mastering", 5.0e-6);
+    check<MultibandCompressor<float>, float>("multiband float", 3.0e-5);
+    check<MultibandCompressor<double>, double>("multiband double", 3.5e-9);
+
+    DspKernels::select(DspKernels::kDefaultMode, DspKernels::getDetectedIsa());
+    return TestUtil::finish("test_kernel_equivalence");
+}
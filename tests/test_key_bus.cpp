@@ -0,0 +1,270 @@
+// KeyBus: registry rules, timestamp-aligned reads, and one publisher against several subscriber threads.
+// The publisher writes a ramp (frame index on channel 0, index + 0.5 on channel 1) as fast as it can, in
+// blocks larger than any reader's, so it laps the ring while readers copy. Every read that returns true
+// must be one contiguous, untorn stretch of the ramp; reads at a timestamp must return that timestamp's frames.
+// Free-running threads only interleave where the scheduler lets them (rarely on one core), so the case the
+// overwrite check exists for is also forced: a reader copying the oldest frames while the producer is halfway
+// through a block that overwrites them. Also worth running under -fsanitize=thread.
+
+#include "KeyBus.h"
+#include "TestUtil.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::int64_t kMaxFrames = 1 << 24; // ramp values (frame indices) stay exact in float
+
+    float rampValue (std::int64_t frame) { return (float) frame; }
+
+    void fillRamp (juce::AudioBuffer<float>& block, std::int64_t firstFrame)
+    {
+        for (int i = 0; i < block.getNumSamples(); ++i)
+        {
+            block.getWritePointer(0)[i] = rampValue(firstFrame + i);
+            block.getWritePointer(1)[i] = rampValue(firstFrame + i) + 0.5f;
+        }
+    }
+
+    // The frame index the block starts at, or -1 if it is not one contiguous stretch of the ramp
+    std::int64_t rampStart (const juce::AudioBuffer<float>& block)
+    {
+        const auto first = (std::int64_t) block.getReadPointer(0)[0];
+        for (int i = 0; i < block.getNumSamples(); ++i)
+        {
+            const float expected = rampValue(first + i);
+            if (block.getReadPointer(0)[i] != expected || block.getReadPointer(1)[i] != expected + 0.5f)
+                return -1;
+        }
+        return first;
+    }
+
+    // Forced interleaving: sample types whose conversions (inside KeyBus' ring copies) hand over between threads.
+    // 0 = idle, 1 = reader has started copying, 2 = producer is mid-block, 3 = reader has returned.
+    std::atomic<int> handshakeStage { 0 };
+    constexpr int kProducerPauseAt = 2000; // channel 0 frames written before the producer pauses
+
+    void waitForStage (int stage)
+    {
+        while (handshakeStage.load() < stage)
+            std::this_thread::yield();
+    }
+
+    struct ProducerSample
+    {
+        float value = 0.0f;
+
+        operator float() const
+        {
+            static int conversions = 0; // producer thread only
+            if (++conversions == kProducerPauseAt)
+            {
+                handshakeStage.store(2);
+                waitForStage(3);
+            }
+            return value;
+        }
+    };
+
+    struct ReaderSample
+    {
+        ReaderSample() = default;
+        explicit ReaderSample (float v) : value (v)
+        {
+            static int conversions = 0; // reader thread only
+            if (conversions++ == 0)
+            {
+                handshakeStage.store(1);
+                waitForStage(2);
+            }
+        }
+
+        float value = 0.0f;
+    };
+
+    void testRegistry()
+    {
+        auto& registry = KeyBusRegistry::getInstance();
+        using Role = KeyBusRegistry::Role;
+
+        TestUtil::expect(registry.acquire("", Role::publisher) == nullptr, "empty bus name is refused");
+
+        KeyBus* pub = registry.acquire("registry", Role::publisher);
+        KeyBus* sub = registry.acquire("registry", Role::subscriber);
+        TestUtil::expect(pub != nullptr && pub == sub, "publisher and subscriber share the bus");
+        TestUtil::expect(registry.acquire("registry", Role::publisher) == nullptr, "second publisher is refused");
+
+        // Names past kMaxNameLength - 1 bytes are truncated: the same long name must still find its bus
+        const char* longName = "a bus name well past the thirty-one byte limit";
+        KeyBus* longPub = registry.acquire(longName, Role::publisher);
+        KeyBus* longSub = registry.acquire(longName, Role::subscriber);
+        TestUtil::expect(longPub != nullptr && longPub == longSub, "a long name finds its own bus");
+        TestUtil::expect(registry.acquire(longName, Role::publisher) == nullptr, "second publisher on a long name is refused");
+        registry.release(longPub, Role::publisher);
+        registry.release(longSub, Role::subscriber);
+
+        registry.release(pub, Role::publisher);
+        KeyBus* again = registry.acquire("registry", Role::publisher);
+        TestUtil::expect(again == sub, "publisher slot is free again after release");
+        registry.release(again, Role::publisher);
+        registry.release(sub, Role::subscriber);
+    }
+
+    void testTimestampRead()
+    {
+        auto& registry = KeyBusRegistry::getInstance();
+        KeyBus* bus = registry.acquire("aligned", KeyBusRegistry::Role::publisher);
+
+        // Timeline starts at 1000 (frame index = timestamp)
+        juce::AudioBuffer<float> block (2, 256);
+        for (std::int64_t t = 1000; t < 1000 + 8 * 256; t += 256)
+        {
+            fillRamp(block, t);
+            bus->publish(block, t);
+        }
+
+        juce::AudioBuffer<float> key (2, 100);
+        TestUtil::expect(bus->read(1300, key, 0) && rampStart(key) == 1300, "read at a timestamp returns its frames");
+        TestUtil::expect(bus->read(-1, key, 0) && rampStart(key) == 1000 + 8 * 256 - 100, "untimed read returns the newest frames");
+        TestUtil::expect(bus->read(1000 + 8 * 256, key, 100) && rampStart(key) == 1000 + 8 * 256 - 100,
+                         "a read ahead of the producer within the lag gets the newest frames");
+        TestUtil::expect(!bus->read(1000 + 8 * 256, key, 99), "a read ahead of the producer beyond the lag fails");
+        TestUtil::expect(!bus->read(900, key, 0), "a read before the segment fails");
+
+        // Transport jump: the old segment is gone
+        fillRamp(block, 50000);
+        bus->publish(block, 50000);
+        TestUtil::expect(!bus->read(1300, key, 0), "a read in a previous segment fails");
+        TestUtil::expect(bus->read(50000, key, 0) && rampStart(key) == 50000, "a read in the new segment succeeds");
+
+        registry.release(bus, KeyBusRegistry::Role::publisher);
+    }
+
+    void testInFlightOverwrite()
+    {
+        constexpr int kPublishBlock = 4096; // more than the reader's block: the old check missed this
+        constexpr int kReadBlock = 64;
+
+        auto& registry = KeyBusRegistry::getInstance();
+        KeyBus* bus = registry.acquire("in flight", KeyBusRegistry::Role::publisher);
+
+        // Fill the ring exactly
+        juce::AudioBuffer<float> block (2, kPublishBlock);
+        std::int64_t writePos = 0;
+        for (; writePos < KeyBus::kCapacity; writePos += kPublishBlock)
+        {
+            fillRamp(block, writePos);
+            bus->publish(block, writePos);
+        }
+
+        // The next block overwrites the oldest frames first
+        juce::AudioBuffer<ProducerSample> next (2, kPublishBlock);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < kPublishBlock; ++i)
+                next.getWritePointer(ch)[i].value = -1.0f;
+
+        std::thread producer ([&]
+        {
+            waitForStage(1);
+            bus->publish(next, writePos);
+        });
+
+        const std::int64_t oldest = writePos - KeyBus::kCapacity + kReadBlock;
+        juce::AudioBuffer<ReaderSample> key (2, kReadBlock);
+        const bool ok = bus->read(oldest, key, 0);
+        handshakeStage.store(3);
+        producer.join();
+
+        bool overwritten = false;
+        for (int i = 0; i < kReadBlock; ++i)
+            overwritten = overwritten || key.getReadPointer(0)[i].value != rampValue(oldest + i);
+        TestUtil::expect(overwritten, "the forced interleaving overwrote the frames being read");
+        TestUtil::expect(!ok, "a read overlapping a larger block in flight fails");
+
+        registry.release(bus, KeyBusRegistry::Role::publisher);
+    }
+
+    void testConcurrentReaders()
+    {
+        constexpr int kPublishBlock = 4096;
+        constexpr std::int64_t kTotalFrames = kMaxFrames - kPublishBlock;
+        constexpr int kReaderBlocks[] = { 64, 256, 1024 };
+
+        auto& registry = KeyBusRegistry::getInstance();
+        KeyBus* pub = registry.acquire("stress", KeyBusRegistry::Role::publisher);
+
+        std::atomic<bool> done { false };
+        std::atomic<int> ready { 0 }, torn { 0 }, misaligned { 0 }, good { 0 };
+
+        std::vector<std::thread> readers;
+        for (int blockSize : kReaderBlocks)
+        {
+            readers.emplace_back([&, blockSize]
+            {
+                KeyBus* sub = registry.acquire("stress", KeyBusRegistry::Role::subscriber);
+                juce::AudioBuffer<float> key (2, blockSize);
+                ready.fetch_add(1);
+                std::int64_t newest = -1; // start of this reader's last untimed read
+                for (int round = 0; !done.load(std::memory_order_acquire); ++round)
+                {
+                    // Cycle: the newest frames, the block following them, the oldest frames the ring still holds
+                    // (the ones the producer overwrites next)
+                    const int mode = round % 3;
+                    std::int64_t t = -1;
+                    if (mode == 1 && newest >= 0)
+                        t = newest + blockSize;
+                    else if (mode == 2 && newest >= 0)
+                        t = newest - KeyBus::kCapacity + 2 * blockSize;
+                    if (mode != 0 && t < 0)
+                        continue;
+
+                    if (!sub->read(t, key, 0))
+                        continue;
+
+                    const std::int64_t start = rampStart(key);
+                    if (start < 0)
+                        torn.fetch_add(1);
+                    else if (t >= 0 && rampValue(t) != (float) start)
+                        misaligned.fetch_add(1);
+                    else
+                        good.fetch_add(1);
+
+                    if (mode == 0 && start >= 0)
+                        newest = start;
+                }
+                registry.release(sub, KeyBusRegistry::Role::subscriber);
+            });
+        }
+
+        while (ready.load() < (int) readers.size())
+            std::this_thread::yield();
+
+        juce::AudioBuffer<float> block (2, kPublishBlock);
+        for (std::int64_t t = 0; t < kTotalFrames; t += kPublishBlock)
+        {
+            fillRamp(block, t);
+            pub->publish(block, t);
+        }
+        done.store(true, std::memory_order_release);
+        for (auto& reader : readers)
+            reader.join();
+        registry.release(pub, KeyBusRegistry::Role::publisher);
+
+        std::printf("concurrent reads: %d good, %d torn, %d misaligned\n", good.load(), torn.load(), misaligned.load());
+        TestUtil::expect(torn.load() == 0, "no successful read returns torn or overwritten frames");
+        TestUtil::expect(misaligned.load() == 0, "timed reads return the frames at their timestamp");
+        TestUtil::expect(good.load() > 0, "readers got frames while the producer was running");
+    }
+}
+
+int main()
+{
+    testRegistry();
+    testTimestampRead();
+    testInFlightOverwrite();
+    testConcurrentReaders();
+    return TestUtil::finish("test_key_bus");
+}